@@ -0,0 +1,431 @@
+// Microbenchmarks for src/algebra.hpp, src/geometry.hpp, src/bvh.hpp and the
+// render queue sort (src/RenderQueue.hpp)
+//
+// Usage: bench_algebra [--json <path>] [--filter <substring>] [--samples <n>]
+//
+// Inputs are drawn from small pools of random values (fits in L1) and indexed
+// by the iteration counter, so the compiler cannot constant-fold them and the
+// numbers reflect compute cost rather than memory bandwidth. Batch kernels
+// use larger arrays and report time per element.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "algebra.hpp"
+#include "algebra_batch.hpp"
+#include "geometry.hpp"
+#include "bvh.hpp"
+#include "JobSystem.hpp"
+#include "RenderQueue.hpp"
+#include "bench_harness.hpp"
+
+namespace {
+
+constexpr std::size_t POOL = 256; // power of two
+constexpr std::size_t POOL_MASK = POOL - 1;
+
+struct Inputs {
+    std::vector<alg::Mat4> mats;
+    std::vector<alg::Vec3> vecs;
+    std::vector<alg::Quat> quats;
+    std::vector<float> scalars;
+
+    Inputs() : mats(POOL), vecs(POOL), quats(POOL), scalars(POOL) {
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+        for (std::size_t i = 0; i < POOL; ++i) {
+            const alg::Vec3 t(dist(rng) * 10.0f, dist(rng) * 10.0f, dist(rng) * 10.0f);
+            const alg::Vec3 angles(dist(rng) * alg::PI, dist(rng) * alg::PI, dist(rng) * alg::PI);
+            const alg::Vec3 s(1.0f + dist(rng) * 0.5f, 1.0f + dist(rng) * 0.5f, 1.0f + dist(rng) * 0.5f);
+            quats[i] = alg::Quat::from_euler(angles);
+            mats[i] = alg::Mat4::from_trs(t, quats[i], s);
+            vecs[i] = alg::Vec3(dist(rng), dist(rng), dist(rng)) * 5.0f;
+            scalars[i] = (dist(rng) + 1.0f) * 0.5f; // [0, 1]
+        }
+    }
+};
+
+bool matches(const std::string& name, const std::string& filter) {
+    return filter.empty() || name.find(filter) != std::string::npos;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string json_path;
+    std::string filter;
+    bench::Config cfg;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (std::strcmp(argv[i], "--samples") == 0 && i + 1 < argc) {
+            cfg.samples = std::max(1, std::atoi(argv[++i]));
+        } else {
+            std::fprintf(stderr, "usage: %s [--json <path>] [--filter <substring>] [--samples <n>]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    const Inputs in;
+    bench::Report report(alg::simd::backend_name());
+    std::printf("alg backend: %s\n", alg::simd::backend_name());
+
+    auto add = [&](const std::string& name, const bench::Config& c, auto&& body) {
+        if (matches(name, filter)) {
+            report.add(bench::run(name, c, body));
+        }
+    };
+
+    // --- Mat4 ---
+    add("mat4_mul_scalar", cfg, [&](std::uint64_t i) {
+        bench::do_not_optimize(alg::scalar::mul(in.mats[i & POOL_MASK], in.mats[(i + 1) & POOL_MASK]));
+    });
+    add("mat4_mul", cfg, [&](std::uint64_t i) {
+        bench::do_not_optimize(in.mats[i & POOL_MASK] * in.mats[(i + 1) & POOL_MASK]);
+    });
+    add("mat4_mul_vec3_scalar", cfg, [&](std::uint64_t i) {
+        bench::do_not_optimize(alg::scalar::transform_point(in.mats[i & POOL_MASK], in.vecs[i & POOL_MASK]));
+    });
+    add("mat4_mul_vec3", cfg, [&](std::uint64_t i) {
+        bench::do_not_optimize(in.mats[i & POOL_MASK] * in.vecs[i & POOL_MASK]);
+    });
+    add("mat4_inverse", cfg, [&](std::uint64_t i) {
+        bench::do_not_optimize(in.mats[i & POOL_MASK].inverse());
+    });
+    add("mat4_affine_inverse", cfg, [&](std::uint64_t i) {
+        bench::do_not_optimize(in.mats[i & POOL_MASK].affine_inverse());
+    });
+    add("mat4_normal_matrix", cfg, [&](std::uint64_t i) {
+        bench::do_not_optimize(in.mats[i & POOL_MASK].normal_matrix());
+    });
+
+    // --- Entity transform composition ---
+    add("trs_matrix_product", cfg, [&](std::uint64_t i) {
+        const alg::Vec3& v = in.vecs[i & POOL_MASK];
+        bench::do_not_optimize(alg::Mat4::create_translation(v) *
+                               alg::Mat4::create_rotation_xyz(v) *
+                               alg::Mat4::create_scale(in.vecs[(i + 1) & POOL_MASK]));
+    });
+    add("trs_from_trs", cfg, [&](std::uint64_t i) {
+        bench::do_not_optimize(alg::Mat4::from_trs(in.vecs[i & POOL_MASK], in.quats[i & POOL_MASK],
+                                                   in.vecs[(i + 1) & POOL_MASK]));
+    });
+
+    // --- Vec3 ---
+    add("vec3_normalize", cfg, [&](std::uint64_t i) {
+        bench::do_not_optimize(in.vecs[i & POOL_MASK].normalized());
+    });
+    add("vec3_cross", cfg, [&](std::uint64_t i) {
+        bench::do_not_optimize(alg::cross(in.vecs[i & POOL_MASK], in.vecs[(i + 1) & POOL_MASK]));
+    });
+    add("vec3_dot", cfg, [&](std::uint64_t i) {
+        bench::do_not_optimize(alg::dot(in.vecs[i & POOL_MASK], in.vecs[(i + 1) & POOL_MASK]));
+    });
+
+    // --- Fast math ---
+    add("std_sincos", cfg, [&](std::uint64_t i) {
+        const float x = in.vecs[i & POOL_MASK].x;
+        bench::do_not_optimize(std::sin(x));
+        bench::do_not_optimize(std::cos(x));
+    });
+    add("fast_sincos", cfg, [&](std::uint64_t i) {
+        float s, c;
+        alg::fast::sincos(in.vecs[i & POOL_MASK].x, s, c);
+        bench::do_not_optimize(s);
+        bench::do_not_optimize(c);
+    });
+    add("std_rsqrt", cfg, [&](std::uint64_t i) {
+        bench::do_not_optimize(1.0f / std::sqrt(in.scalars[i & POOL_MASK] + 0.1f));
+    });
+    add("fast_rsqrt", cfg, [&](std::uint64_t i) {
+        bench::do_not_optimize(alg::fast::rsqrt(in.scalars[i & POOL_MASK] + 0.1f));
+    });
+    add("std_atan2", cfg, [&](std::uint64_t i) {
+        bench::do_not_optimize(std::atan2(in.vecs[i & POOL_MASK].y, in.vecs[i & POOL_MASK].x));
+    });
+    add("fast_atan2", cfg, [&](std::uint64_t i) {
+        bench::do_not_optimize(alg::fast::atan2(in.vecs[i & POOL_MASK].y, in.vecs[i & POOL_MASK].x));
+    });
+
+    // --- Quat ---
+    add("quat_slerp", cfg, [&](std::uint64_t i) {
+        bench::do_not_optimize(alg::slerp(in.quats[i & POOL_MASK], in.quats[(i + 1) & POOL_MASK],
+                                          in.scalars[i & POOL_MASK]));
+    });
+
+    // --- Camera ---
+    add("mat4_lookAt", cfg, [&](std::uint64_t i) {
+        bench::do_not_optimize(alg::Mat4::lookAt(in.vecs[i & POOL_MASK], in.vecs[(i + 1) & POOL_MASK],
+                                                 alg::Vec3(0.0f, 1.0f, 0.0f)));
+    });
+    add("mat4_create_perspective", cfg, [&](std::uint64_t i) {
+        bench::do_not_optimize(alg::Mat4::create_perspective(0.5f + in.scalars[i & POOL_MASK],
+                                                             16.0f / 9.0f, 0.1f, 100.0f));
+    });
+
+    // --- Batch kernels (time per element) ---
+    {
+        constexpr std::size_t N = 4096;
+        std::vector<alg::Vec3> points(N), out(N);
+        std::vector<alg::Mat4> models(N), mvp(N);
+        for (std::size_t i = 0; i < N; ++i) {
+            points[i] = in.vecs[i & POOL_MASK];
+            models[i] = in.mats[i & POOL_MASK];
+        }
+        bench::Config batch_cfg = cfg;
+        batch_cfg.iterations = 1;
+
+        auto add_batch = [&](const std::string& name, auto&& body) {
+            if (!matches(name, filter)) {
+                return;
+            }
+            bench::Result r = bench::run(name, batch_cfg, body);
+            r.iterations = N;
+            r.min_ns /= N;
+            r.median_ns /= N;
+            r.p99_ns /= N;
+            report.add(r);
+        };
+
+        add_batch("batch_transform_points", [&](std::uint64_t) {
+            alg::batch::transform_points(in.mats[0], points, out);
+            bench::clobber_memory();
+        });
+        add_batch("loop_transform_points", [&](std::uint64_t) {
+            for (std::size_t i = 0; i < N; ++i) {
+                out[i] = in.mats[0] * points[i];
+            }
+            bench::clobber_memory();
+        });
+        add_batch("batch_mat4_mul", [&](std::uint64_t) {
+            alg::batch::mul(in.mats[0], models, mvp);
+            bench::clobber_memory();
+        });
+        add_batch("batch_normalize", [&](std::uint64_t) {
+            out = points; // in-place kernel: restore the input (copy included in the timing)
+            alg::batch::normalize(out);
+            bench::clobber_memory();
+        });
+
+        std::vector<float> angles(N), sines(N), cosines(N);
+        for (std::size_t i = 0; i < N; ++i) {
+            angles[i] = in.vecs[i & POOL_MASK].x;
+        }
+        add_batch("batch_fast_sincos", [&](std::uint64_t) {
+            alg::fast::sincos(angles, sines, cosines);
+            bench::clobber_memory();
+        });
+        add_batch("loop_std_sincos", [&](std::uint64_t) {
+            for (std::size_t i = 0; i < N; ++i) {
+                sines[i] = std::sin(angles[i]);
+                cosines[i] = std::cos(angles[i]);
+            }
+            bench::clobber_memory();
+        });
+
+        // Scene-sized box set around the origin, camera looking at it
+        std::vector<alg::AABB> boxes(N);
+        std::vector<std::uint8_t> visible(N);
+        std::vector<float> hits(N);
+        for (std::size_t i = 0; i < N; ++i) {
+            boxes[i] = alg::AABB::from_center_extents(points[i] * 10.0f, alg::Vec3(0.5f, 0.5f, 0.5f));
+        }
+        const alg::Frustum frustum = alg::Frustum::from_matrix(
+            alg::Mat4::create_perspective(alg::degrees_to_radians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f) *
+            alg::Mat4::lookAt(alg::Vec3(0.0f, 0.0f, 30.0f), alg::Vec3(0.0f, 0.0f, 0.0f), alg::Vec3(0.0f, 1.0f, 0.0f)));
+        const alg::Ray ray(alg::Vec3(0.0f, 0.0f, 60.0f), alg::Vec3(0.05f, 0.02f, -1.0f).normalized());
+
+        add_batch("batch_cull_aabbs", [&](std::uint64_t) {
+            bench::do_not_optimize(alg::batch::cull_aabbs(frustum, boxes, visible));
+            bench::clobber_memory();
+        });
+        add_batch("loop_cull_aabbs", [&](std::uint64_t) {
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < N; ++i) {
+                visible[i] = alg::intersects(frustum, boxes[i]) ? 1 : 0;
+                count += visible[i];
+            }
+            bench::do_not_optimize(count);
+            bench::clobber_memory();
+        });
+        add_batch("batch_raycast_aabbs", [&](std::uint64_t) {
+            bench::do_not_optimize(alg::batch::raycast_aabbs(ray, boxes, hits));
+            bench::clobber_memory();
+        });
+    }
+
+    // --- BVH (time per build/refit/query over the whole scene) ---
+    {
+        constexpr std::size_t N = 16384;
+        std::mt19937 rng(99);
+        std::uniform_real_distribution<float> pos(-200.0f, 200.0f);
+        std::uniform_real_distribution<float> size(0.25f, 2.0f);
+        std::vector<alg::AABB> boxes(N);
+        for (alg::AABB& box : boxes) {
+            box = alg::AABB::from_center_extents(alg::Vec3(pos(rng), pos(rng) * 0.1f, pos(rng)),
+                                                 alg::Vec3(size(rng), size(rng), size(rng)));
+        }
+        std::vector<std::uint8_t> visible(N);
+        std::vector<float> hits(N);
+        std::vector<std::uint32_t> found;
+        const alg::Frustum frustum = alg::Frustum::from_matrix(
+            alg::Mat4::create_perspective(alg::degrees_to_radians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f) *
+            alg::Mat4::lookAt(alg::Vec3(0.0f, 5.0f, 0.0f), alg::Vec3(0.0f, 0.0f, -50.0f), alg::Vec3(0.0f, 1.0f, 0.0f)));
+
+        alg::Bvh bvh;
+        bvh.build(boxes);
+
+        bench::Config build_cfg = cfg;
+        build_cfg.iterations = 1;
+        bench::Config query_cfg = cfg;
+        query_cfg.iterations = 100;
+
+        add("bvh_build_16k", build_cfg, [&](std::uint64_t) {
+            bvh.build(boxes);
+            bench::clobber_memory();
+        });
+        // 10% of the objects move a little each frame
+        add("bvh_refit_16k_10pct", query_cfg, [&](std::uint64_t i) {
+            const float offset = (i & 1) ? 0.01f : -0.01f;
+            for (std::size_t k = i % 10; k < N; k += 10) {
+                boxes[k].min.x += offset;
+                boxes[k].max.x += offset;
+                bvh.update(static_cast<std::uint32_t>(k), boxes[k]);
+            }
+            bvh.refit();
+            bench::clobber_memory();
+        });
+        add("bvh_query_frustum_16k", query_cfg, [&](std::uint64_t) {
+            std::size_t count = 0;
+            bvh.query_frustum(frustum, [&](std::uint32_t) { ++count; });
+            bench::do_not_optimize(count);
+        });
+        add("flat_cull_aabbs_16k", query_cfg, [&](std::uint64_t) {
+            bench::do_not_optimize(alg::batch::cull_aabbs(frustum, boxes, visible));
+            bench::clobber_memory();
+        });
+        add("bvh_raycast_16k", cfg, [&](std::uint64_t i) {
+            const alg::Vec3& d = in.vecs[i & POOL_MASK];
+            const alg::Ray ray(alg::Vec3(0.0f, 5.0f, 0.0f), alg::Vec3(d.x, d.y * 0.1f - 0.05f, d.z).normalized());
+            bench::do_not_optimize(bvh.raycast(ray).t);
+        });
+        add("flat_raycast_aabbs_16k", query_cfg, [&](std::uint64_t i) {
+            const alg::Vec3& d = in.vecs[i & POOL_MASK];
+            const alg::Ray ray(alg::Vec3(0.0f, 5.0f, 0.0f), alg::Vec3(d.x, d.y * 0.1f - 0.05f, d.z).normalized());
+            bench::do_not_optimize(alg::batch::raycast_aabbs(ray, boxes, hits));
+            bench::clobber_memory();
+        });
+        add("bvh_query_sphere_16k", cfg, [&](std::uint64_t i) {
+            std::size_t count = 0;
+            bvh.query_sphere(alg::Sphere(in.vecs[i & POOL_MASK] * 30.0f, 10.0f), [&](std::uint32_t) { ++count; });
+            bench::do_not_optimize(count);
+        });
+        add("bvh_nearest8_16k", cfg, [&](std::uint64_t i) {
+            bvh.nearest(in.vecs[i & POOL_MASK] * 30.0f, 8, found);
+            bench::do_not_optimize(found.data());
+        });
+    }
+
+    // --- Triangle BVH (viewport picking against a dense 1M-triangle grid) ---
+    {
+        constexpr std::uint32_t GRID = 708; // 707^2 * 2 ~= 1M triangles
+        std::vector<alg::Vec3> positions;
+        positions.reserve(GRID * GRID);
+        for (std::uint32_t z = 0; z < GRID; ++z) {
+            for (std::uint32_t x = 0; x < GRID; ++x) {
+                const float fx = static_cast<float>(x) * 0.1f;
+                const float fz = static_cast<float>(z) * 0.1f;
+                positions.emplace_back(fx, std::sin(fx * 0.7f) * std::cos(fz * 0.5f), fz);
+            }
+        }
+        std::vector<unsigned int> indices;
+        indices.reserve((GRID - 1) * (GRID - 1) * 6);
+        for (std::uint32_t z = 0; z + 1 < GRID; ++z) {
+            for (std::uint32_t x = 0; x + 1 < GRID; ++x) {
+                const unsigned int i0 = z * GRID + x;
+                const unsigned int i1 = i0 + 1;
+                const unsigned int i2 = i0 + GRID;
+                const unsigned int i3 = i2 + 1;
+                indices.insert(indices.end(), {i0, i2, i1, i1, i2, i3});
+            }
+        }
+
+        alg::TriangleBvh tris;
+        bench::Config build_cfg = cfg;
+        build_cfg.iterations = 1;
+        build_cfg.warmup_samples = 1;
+        build_cfg.samples = std::min(cfg.samples, 3);
+
+        add("tribvh_build_1m", build_cfg, [&](std::uint64_t) {
+            tris.build(positions, indices);
+            bench::clobber_memory();
+        });
+        const float extent = static_cast<float>(GRID - 1) * 0.1f;
+        add("tribvh_raycast_1m", cfg, [&](std::uint64_t i) {
+            const alg::Vec3& d = in.vecs[i & POOL_MASK];
+            const alg::Vec3 target((d.x * 0.5f + 0.5f) * extent, 0.0f, (d.z * 0.5f + 0.5f) * extent);
+            const alg::Vec3 origin(extent * 0.5f, 20.0f, -10.0f);
+            bench::do_not_optimize(tris.raycast(alg::Ray(origin, (target - origin).normalized())).t);
+        });
+    }
+
+    // --- Render queue sort (time per sort of the whole queue, copy included) ---
+    {
+        constexpr std::size_t N = 65536;
+        std::mt19937 rng(7);
+        std::uniform_int_distribution<std::uint32_t> shader(1, 4);
+        std::uniform_int_distribution<std::uint32_t> texture(1, 16);
+        std::uniform_int_distribution<std::uint32_t> mesh(1, 64);
+        std::uniform_real_distribution<float> depth(0.1f, 100.0f);
+        std::vector<RenderPacket> input(N);
+        for (std::size_t i = 0; i < N; ++i) {
+            const bool transparent = (i % 10) == 0;
+            input[i].key = transparent
+                ? RenderQueue::transparentKey(shader(rng), texture(rng), mesh(rng), depth(rng))
+                : RenderQueue::opaqueKey(shader(rng), texture(rng), mesh(rng), depth(rng));
+            input[i].draw = static_cast<std::uint32_t>(i);
+            input[i].padding = 0;
+        }
+        std::vector<RenderPacket> packets;
+        std::vector<RenderPacket> scratch;
+        std::vector<std::uint32_t> histograms;
+        JobSystem jobs;
+
+        bench::Config sort_cfg = cfg;
+        sort_cfg.iterations = 10;
+
+        add("renderqueue_std_sort_64k", sort_cfg, [&](std::uint64_t) {
+            packets = input;
+            std::sort(packets.begin(), packets.end(),
+                      [](const RenderPacket& a, const RenderPacket& b) { return a.key < b.key; });
+            bench::clobber_memory();
+        });
+        add("renderqueue_radix_64k", sort_cfg, [&](std::uint64_t) {
+            packets = input;
+            radixSortPackets(packets, scratch, histograms);
+            bench::clobber_memory();
+        });
+        add("renderqueue_radix_64k_jobs", sort_cfg, [&](std::uint64_t) {
+            packets = input;
+            radixSortPackets(packets, scratch, histograms, &jobs);
+            bench::clobber_memory();
+        });
+    }
+
+    if (!json_path.empty()) {
+        if (!report.write_json(json_path)) {
+            std::fprintf(stderr, "failed to write %s\n", json_path.c_str());
+            return 1;
+        }
+        std::printf("results written to %s\n", json_path.c_str());
+    }
+    return 0;
+}
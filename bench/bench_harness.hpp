@@ -0,0 +1,182 @@
+#ifndef BENCH_HARNESS_HPP
+#define BENCH_HARNESS_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+/**
+ * @namespace bench
+ * @brief Minimal microbenchmark harness (no third-party dependencies)
+ *
+ * Each benchmark body runs `iterations` times per sample. The harness first
+ * runs untimed warmup samples (caches, branch predictors, CPU clocks), then
+ * records `samples` timed samples and reports ns/op statistics across them.
+ * Median is the headline number; p99 shows how noisy the run was.
+ *
+ * Results are collected in a Report and can be written as JSON so runs on
+ * different commits or build flags can be diffed by a script.
+ */
+namespace bench {
+
+/**
+ * @brief Keep a value alive as far as the optimizer is concerned
+ *
+ * Without this the compiler is free to delete a benchmark body whose
+ * result is never used. The asm statement claims to read the value and
+ * clobber memory, which costs nothing at runtime.
+ */
+template <class T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+    _ReadWriteBarrier();
+#endif
+}
+
+/**
+ * @brief Force pending stores to be treated as observable
+ *
+ * Use after writing into an output buffer the optimizer can see through.
+ */
+inline void clobber_memory() {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : : "memory");
+#else
+    _ReadWriteBarrier();
+#endif
+}
+
+struct Config {
+    int warmup_samples = 5;
+    int samples = 51;
+    std::uint64_t iterations = 10000; // per sample
+};
+
+struct Result {
+    std::string name;
+    std::uint64_t iterations = 0;
+    int samples = 0;
+    double min_ns = 0.0;    // per op
+    double median_ns = 0.0; // per op
+    double p99_ns = 0.0;    // per op
+};
+
+/**
+ * @brief Nearest-rank percentile of an already sorted sample set
+ */
+inline double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    const double rank = p * static_cast<double>(sorted.size() - 1);
+    return sorted[static_cast<std::size_t>(rank + 0.5)];
+}
+
+/**
+ * @brief Time a benchmark body
+ * @param name Identifier used in reports
+ * @param cfg Warmup, sample and iteration counts
+ * @param body Callable invoked with the iteration index; must feed its
+ *             result through do_not_optimize
+ */
+template <class Body>
+Result run(const std::string& name, const Config& cfg, Body&& body) {
+    using clock = std::chrono::steady_clock;
+
+    for (int s = 0; s < cfg.warmup_samples; ++s) {
+        for (std::uint64_t i = 0; i < cfg.iterations; ++i) {
+            body(i);
+        }
+    }
+
+    std::vector<double> per_op;
+    per_op.reserve(cfg.samples);
+    for (int s = 0; s < cfg.samples; ++s) {
+        const auto start = clock::now();
+        for (std::uint64_t i = 0; i < cfg.iterations; ++i) {
+            body(i);
+        }
+        const auto stop = clock::now();
+        const double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+        per_op.push_back(ns / static_cast<double>(cfg.iterations));
+    }
+    std::sort(per_op.begin(), per_op.end());
+
+    Result r;
+    r.name = name;
+    r.iterations = cfg.iterations;
+    r.samples = cfg.samples;
+    r.min_ns = per_op.front();
+    r.median_ns = percentile(per_op, 0.5);
+    r.p99_ns = percentile(per_op, 0.99);
+    return r;
+}
+
+/**
+ * @brief Collection of results plus run metadata
+ */
+class Report {
+public:
+    explicit Report(std::string backend) : backend(std::move(backend)) {}
+
+    void add(const Result& r) {
+        std::printf("%-32s median %9.3f ns  p99 %9.3f ns  min %9.3f ns\n",
+                    r.name.c_str(), r.median_ns, r.p99_ns, r.min_ns);
+        results.push_back(r);
+    }
+
+    /**
+     * @brief Write all results as JSON
+     * @return false if the file could not be opened
+     */
+    bool write_json(const std::string& path) const {
+        std::FILE* f = std::fopen(path.c_str(), "w");
+        if (!f) {
+            return false;
+        }
+        std::fprintf(f, "{\n  \"backend\": \"%s\",\n  \"compiler\": \"%s\",\n  \"unit\": \"ns/op\",\n  \"results\": [\n",
+                     backend.c_str(), compiler_id());
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const Result& r = results[i];
+            std::fprintf(f,
+                         "    {\"name\": \"%s\", \"median\": %.4f, \"p99\": %.4f, \"min\": %.4f, "
+                         "\"samples\": %d, \"iterations\": %llu}%s\n",
+                         r.name.c_str(), r.median_ns, r.p99_ns, r.min_ns, r.samples,
+                         static_cast<unsigned long long>(r.iterations), i + 1 < results.size() ? "," : "");
+        }
+        std::fprintf(f, "  ]\n}\n");
+        std::fclose(f);
+        return true;
+    }
+
+private:
+    static const char* compiler_id() {
+#if defined(__clang__)
+        return "clang " __clang_version__;
+#elif defined(__GNUC__)
+        return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+        return "msvc";
+#else
+        return "unknown";
+#endif
+    }
+
+    std::string backend;
+    std::vector<Result> results;
+};
+
+} // namespace bench
+
+#endif // BENCH_HARNESS_HPP
@@ -1,71 +1,120 @@
 #version 330 core
 #define MAX_LIGHTS 8
+#define NO_LIGHT 0xFFFFFFFFu
 
 in vec3 FragPos;
 in vec3 Normal;
 in vec2 TexCoords;
 
+// Cores do material, lidas do buffer de materiais em basic.vert
+flat in vec4 MaterialAmbient; // xyz = ambient, w = shininess
+flat in vec3 MaterialDiffuse;
+flat in vec3 MaterialSpecular;
+
+// Até 4 índices em clusterLights, da luz mais relevante para a menos;
+// as posições vazias (NO_LIGHT) ficam no fim
+flat in uvec4 SelectedLights;
+flat in int HasSelectedLights;
+
 out vec4 FragColor;
 
 // Estrutura do Material
 struct Material {
     sampler2D diffuse;
     sampler2D specular;
-    vec3 ambient;
-    vec3 diffuseColor;
-    vec3 specularColor;
-    float shininess;
 };
 uniform Material material;
 
-// Estrutura da Luz
+// Câmera do frame (CameraBlock no C++), igual em basic.vert
+layout (std140) uniform Camera {
+    mat4 projection;
+    mat4 view;
+    vec4 viewPos; // w sem uso
+};
+
+// Estrutura da Luz (LightBlockEntry no C++), empacotada em vec4 para o
+// layout std140 não ter buracos
 struct Light {
-    int type;           // 0 = point, 1 = directional, 2 = spot
-    bool enabled;
-    vec3 position;
-    vec3 direction;
-    vec3 color;
-    float intensity;
-    float range;
-    float innerAngle;   // cos(innerAngle)
-    float outerAngle;   // cos(outerAngle)
+    vec4 positionRange;  // xyz = posição, w = alcance
+    vec4 directionType;  // xyz = direção, w = tipo (0 = point, 1 = directional, 2 = spot)
+    vec4 colorIntensity; // xyz = cor, w = intensidade
+    vec4 cone;           // x = cos(innerAngle), y = cos(outerAngle), z = ligada
 };
 
-uniform Light lights[MAX_LIGHTS];
-uniform int activeLightCount;
-uniform vec3 viewPos;
+// Primeiras MAX_LIGHTS luzes da cena, para draws sem clusters nem luzes escolhidas
+layout (std140) uniform Lights {
+    Light lights[MAX_LIGHTS];
+    int activeLightCount;
+};
+
+// Forward clusterizado (LightClusters no C++): o frustum dividido em
+// clusters, cada um com a lista das luzes que o alcançam
+layout (std140) uniform Clusters {
+    uvec4 clusterGrid;  // xyz = clusters por eixo, w = 1 se ligado
+    vec4 clusterDepth;  // x = escala, y = bias da fatia log, z = near, w = far
+    vec4 clusterTile;   // xy = pixels por tile
+};
+uniform samplerBuffer clusterLights;   // 4 texels por luz (mesmo layout de Light), também sem clusters
+uniform usamplerBuffer clusterRanges;  // Por cluster: x = início, y = quantidade em clusterIndices
+uniform usamplerBuffer clusterIndices; // Índices em clusterLights
+
+Light fetchClusterLight(int index) {
+    Light light;
+    light.positionRange = texelFetch(clusterLights, index * 4);
+    light.directionType = texelFetch(clusterLights, index * 4 + 1);
+    light.colorIntensity = texelFetch(clusterLights, index * 4 + 2);
+    light.cone = texelFetch(clusterLights, index * 4 + 3);
+    return light;
+}
+
+// Faixa de clusterIndices do cluster deste fragmento
+uvec2 clusterRange(vec3 fragPos) {
+    float viewDepth = max(-(view * vec4(fragPos, 1.0)).z, clusterDepth.z);
+    uint slice = uint(max(floor(log(viewDepth) * clusterDepth.x + clusterDepth.y), 0.0));
+    uvec2 tile = uvec2(gl_FragCoord.xy / clusterTile.xy);
+    uvec3 cluster = min(uvec3(tile, slice), clusterGrid.xyz - uvec3(1u));
+    int index = int((cluster.z * clusterGrid.y + cluster.y) * clusterGrid.x + cluster.x);
+    return texelFetch(clusterRanges, index).xy;
+}
 
 // Função para cálculo da contribuição de luz
-vec3 calculateLightContribution(Light light, vec3 normal, vec3 fragPos, vec3 viewDir) {
-    if (!light.enabled) return vec3(0.0);
+vec3 calculateLightContribution(Light light, vec3 normal, vec3 fragPos, vec3 viewDir, float shininess) {
+    if (light.cone.z == 0.0) return vec3(0.0);
+
+    int type = int(light.directionType.w);
+    vec3 position = light.positionRange.xyz;
+    vec3 direction = light.directionType.xyz;
+    vec3 color = light.colorIntensity.rgb;
+    float intensity = light.colorIntensity.w;
+    float range = light.positionRange.w;
 
     vec3 lightDir;
     float attenuation = 1.0;
 
     // Cálculos específicos por tipo de luz
-    if (light.type == 1) { // Directional
-        lightDir = normalize(-light.direction);
+    if (type == 1) { // Directional
+        lightDir = normalize(-direction);
     } else { // Point or Spot
-        lightDir = normalize(light.position - fragPos);
-        float distance = length(light.position - fragPos);
+        lightDir = normalize(position - fragPos);
+        float distance = length(position - fragPos);
         attenuation = 1.0 / (1.0 + 0.1*distance + 0.01*(distance*distance));
-        attenuation *= smoothstep(light.range, light.range*0.9, distance);
+        attenuation *= smoothstep(range, range*0.9, distance);
     }
 
     // Diffuse
     float diff = max(dot(normal, lightDir), 0.0);
-    vec3 diffuse = light.color * diff * light.intensity;
+    vec3 diffuse = color * diff * intensity;
 
     // Specular (Blinn-Phong)
     vec3 halfwayDir = normalize(lightDir + viewDir);
-    float spec = pow(max(dot(normal, halfwayDir), 0.0), material.shininess);
-    vec3 specular = light.color * spec * light.intensity;
+    float spec = pow(max(dot(normal, halfwayDir), 0.0), shininess);
+    vec3 specular = color * spec * intensity;
 
     // Spot light factor
-    if (light.type == 2) { // Spot
-        float theta = dot(lightDir, normalize(-light.direction));
-        float epsilon = light.innerAngle - light.outerAngle;
-        float spotIntensity = clamp((theta - light.outerAngle) / epsilon, 0.0, 1.0);
+    if (type == 2) { // Spot
+        float theta = dot(lightDir, normalize(-direction));
+        float epsilon = light.cone.x - light.cone.y;
+        float spotIntensity = clamp((theta - light.cone.y) / epsilon, 0.0, 1.0);
         diffuse *= spotIntensity;
         specular *= spotIntensity;
     }
@@ -76,24 +125,44 @@ vec3 calculateLightContribution(Light light, vec3 normal, vec3 fragPos, vec3 vie
 void main() {
     // Normaliza a normal (pode ser distorcida por escala não-uniforme)
     vec3 norm = normalize(Normal);
-    vec3 viewDir = normalize(viewPos - FragPos);
+    vec3 viewDir = normalize(viewPos.xyz - FragPos);
+
+    vec3 ambientColor = MaterialAmbient.rgb;
+    float shininess = MaterialAmbient.w;
+    vec3 diffuseColor = MaterialDiffuse;
+    vec3 specularColor = MaterialSpecular;
 
     // Iluminação ambiente
-    vec3 result = material.ambient;
+    vec3 result = ambientColor;
 
     // Aplica textura difusa
     vec4 texColor = texture(material.diffuse, TexCoords);
-    vec3 effectiveDiffuse = material.diffuseColor * texColor.rgb;
-
-    // Calcula contribuição de todas as luzes
-    for (int i = 0; i < activeLightCount; i++) {
-        vec3 lightContrib = calculateLightContribution(lights[i], norm, FragPos, viewDir);
-        result += lightContrib * effectiveDiffuse;
-
-        // Aplica textura especular (usa o canal vermelho como máscara)
-        float specularStrength = texture(material.specular, TexCoords).r;
-        result += lightContrib * material.specularColor * specularStrength;
+    vec3 effectiveDiffuse = diffuseColor * texColor.rgb;
+
+    // Soma a contribuição das luzes: só as do cluster do fragmento, ou sem
+    // clusters as escolhidas para o draw (ou as MAX_LIGHTS primeiras)
+    vec3 lightContrib = vec3(0.0);
+    if (clusterGrid.w != 0u) {
+        uvec2 range = clusterRange(FragPos);
+        for (uint i = 0u; i < range.y; i++) {
+            int lightIndex = int(texelFetch(clusterIndices, int(range.x + i)).r);
+            lightContrib += calculateLightContribution(fetchClusterLight(lightIndex), norm, FragPos, viewDir, shininess);
+        }
+    } else if (HasSelectedLights != 0) {
+        for (int i = 0; i < 4; i++) {
+            if (SelectedLights[i] == NO_LIGHT) break;
+            lightContrib += calculateLightContribution(fetchClusterLight(int(SelectedLights[i])), norm, FragPos, viewDir, shininess);
+        }
+    } else {
+        for (int i = 0; i < activeLightCount; i++) {
+            lightContrib += calculateLightContribution(lights[i], norm, FragPos, viewDir, shininess);
+        }
     }
+    result += lightContrib * effectiveDiffuse;
+
+    // Aplica textura especular (usa o canal vermelho como máscara)
+    float specularStrength = texture(material.specular, TexCoords).r;
+    result += lightContrib * specularColor * specularStrength;
 
     // Saída final
     FragColor = vec4(result, texColor.a);
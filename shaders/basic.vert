@@ -3,18 +3,58 @@ layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoords;
 
+// Por instância (divisor 1), preenchidos pelo Renderer a partir de
+// InstanceData; só lidos quando instanced = true
+layout (location = 3) in mat4 aInstanceModel;     // Locations 3-6
+layout (location = 7) in mat4 aInstanceNormal;    // Locations 7-10
+layout (location = 11) in uint aInstanceMaterial; // Índice em materials
+layout (location = 12) in uvec4 aInstanceLights;  // Luzes escolhidas (LightSelection)
+
 out vec3 FragPos;
 out vec3 Normal;
 out vec2 TexCoords;
 
+// Cores do material, repassadas ao fragment shader
+flat out vec4 MaterialAmbient; // xyz = ambient, w = shininess
+flat out vec3 MaterialDiffuse;
+flat out vec3 MaterialSpecular;
+
+// Luzes do draw para basic.frag sem clusters; sem instancing não há
+// escolha e ele usa o bloco Lights
+flat out uvec4 SelectedLights;
+flat out int HasSelectedLights;
+
+// Câmera do frame (CameraBlock no C++), igual em basic.frag
+layout (std140) uniform Camera {
+    mat4 projection;
+    mat4 view;
+    vec4 viewPos; // w sem uso
+};
+
+uniform bool instanced;
+
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+uniform mat4 normalMatrix; // Inversa transposta da model, calculada na CPU por draw
+uniform int materialIndex; // Com instanced = false
+
+// Todos os materiais (MaterialData no C++): 3 texels por material
+uniform samplerBuffer materials;
 
 void main() {
-    FragPos = vec3(model * vec4(aPos, 1.0));
-    Normal = mat3(transpose(inverse(model))) * aNormal; // Normais em world space
+    mat4 modelMatrix = instanced ? aInstanceModel : model;
+    mat4 normalModelMatrix = instanced ? aInstanceNormal : normalMatrix;
+
+    FragPos = vec3(modelMatrix * vec4(aPos, 1.0));
+    Normal = mat3(normalModelMatrix) * aNormal; // Normais em world space
     TexCoords = aTexCoords;
 
+    int materialBase = 3 * (instanced ? int(aInstanceMaterial) : materialIndex);
+    MaterialAmbient = texelFetch(materials, materialBase);
+    MaterialDiffuse = texelFetch(materials, materialBase + 1).rgb;
+    MaterialSpecular = texelFetch(materials, materialBase + 2).rgb;
+
+    SelectedLights = aInstanceLights;
+    HasSelectedLights = instanced ? 1 : 0;
+
     gl_Position = projection * view * vec4(FragPos, 1.0);
-}
\ No newline at end of file
+}
@@ -12,6 +12,15 @@ alg::Mat4 Camera::getViewMatrix() {
     return alg::Mat4::lookAt(Position, Position + Front, Up);
 }
 
+alg::Ray Camera::screenRay(float ndcX, float ndcY, const alg::Mat4& projection) {
+    const alg::Mat4 inverseViewProjection = (projection * getViewMatrix()).inverse();
+    const alg::Vec4 nearPoint = inverseViewProjection * alg::Vec4(ndcX, ndcY, -1.0f, 1.0f);
+    const alg::Vec4 farPoint = inverseViewProjection * alg::Vec4(ndcX, ndcY, 1.0f, 1.0f);
+    const alg::Vec3 origin = nearPoint.xyz() / nearPoint.w;
+    const alg::Vec3 target = farPoint.xyz() / farPoint.w;
+    return alg::Ray(origin, (target - origin).normalized());
+}
+
 void Camera::processKeyboard(Camera_Movement direction, float deltaTime) {
     float velocity = MovementSpeed * deltaTime;
     if (direction == FORWARD)
@@ -54,10 +63,14 @@ void Camera::processMouseScroll(float yoffset) {
 
 void Camera::updateCameraVectors() {
     // Calcula o novo vetor Front
+    // alg::hot usa as aproximações de alg::fast quando ALG_FAST_MATH está definido
+    float sinYaw, cosYaw, sinPitch, cosPitch;
+    alg::hot::sincos(alg::degrees_to_radians(Yaw), sinYaw, cosYaw);
+    alg::hot::sincos(alg::degrees_to_radians(Pitch), sinPitch, cosPitch);
     alg::Vec3 front;
-    front.x = cos(alg::degrees_to_radians(Yaw)) * cos(alg::degrees_to_radians(Pitch));
-    front.y = sin(alg::degrees_to_radians(Pitch));
-    front.z = sin(alg::degrees_to_radians(Yaw)) * cos(alg::degrees_to_radians(Pitch));
+    front.x = cosYaw * cosPitch;
+    front.y = sinPitch;
+    front.z = sinYaw * cosPitch;
     Front = front.normalized();
     // Recalcula os vetores Right e Up
     Right = cross(Front, WorldUp).normalized();
@@ -3,6 +3,7 @@
 
 #include <glad/glad.h>
 #include "algebra.hpp"
+#include "geometry.hpp"
 
 // Enum para as direções de movimento possíveis
 enum Camera_Movement {
@@ -43,6 +44,10 @@ public:
     // Retorna a matriz de visualização
     alg::Mat4 getViewMatrix();
 
+    // Raio em espaço de mundo pelo ponto (ndcX, ndcY) da tela, ambos em
+    // [-1, 1] (y para cima), partindo do plano near
+    alg::Ray screenRay(float ndcX, float ndcY, const alg::Mat4& projection);
+
     // Processa input do teclado
     void processKeyboard(Camera_Movement direction, float deltaTime);
 
@@ -4,24 +4,35 @@
 #include "Entity.hpp"
 #include "Camera.hpp"
 
-class CameraEntity : public Entity {
-public:
+struct CameraComponent {
     Camera camera;
-    bool isActive;
+    bool isActive = false;
+};
 
-    CameraEntity(const std::string& name = "Camera")
-        : Entity(name), isActive((false)) {
-        camera.Position = position;
+// Fachada sobre CameraComponent
+class CameraEntity : public Entity {
+public:
+    CameraEntity(Registry& registry, const std::string& name = "Camera")
+        : Entity(registry, name) {
+        registry.emplace<CameraComponent>(id);
+        camera().Position = getPosition();
     }
 
+    CameraComponent& cameraComponent() const { return registry->get<CameraComponent>(id); }
+    Camera& camera() const { return cameraComponent().camera; }
+
+    bool isActive() const { return cameraComponent().isActive; }
+    void setActive(bool active) { cameraComponent().isActive = active; }
+
     void updateCamera() {
-        camera.Position = position;
-        camera.updateCameraVectors();
+        Camera& cam = camera();
+        cam.Position = getPosition();
+        cam.updateCameraVectors();
     }
 
     void drawUI() override {
         Entity::drawUI();
-        ImGui::Checkbox("Active", &isActive);
+        ImGui::Checkbox("Active", &cameraComponent().isActive);
     }
 
 };
@@ -0,0 +1,35 @@
+// Components.hpp
+
+#pragma once
+#include "algebra.hpp"
+
+// Componentes de transform, comuns a todas as entidades. Componentes
+// específicos ficam junto da fachada que os usa (MeshRendererComponent em
+// ModelEntity.hpp, LightComponent em Light.hpp, CameraComponent em
+// CameraEntity.hpp).
+
+// Transform local (relativo ao pai)
+struct TransformComponent {
+    alg::Vec3 position = alg::Vec3(0.0f, 0.0f, 0.0f);
+    alg::Quat orientation;
+    alg::Vec3 scale = alg::Vec3(1.0f, 1.0f, 1.0f);
+    alg::Vec3 eulerDegrees = alg::Vec3(0.0f, 0.0f, 0.0f); // Apenas para o editor
+
+    // Cache de from_trs(position, orientation, scale)
+    alg::Mat4 local;
+    bool dirty = true;
+
+    const alg::Mat4& getLocalMatrix() {
+        if (dirty) {
+            local = alg::Mat4::from_trs(position, orientation, scale);
+            dirty = false;
+        }
+        return local;
+    }
+};
+
+// Matrizes de mundo, escritas pelo SceneGraph a cada Scene::updateTransforms()
+struct WorldTransformComponent {
+    alg::Mat4 world;
+    alg::Mat4 normal; // Inversa transposta de world (para normais)
+};
@@ -2,36 +2,101 @@
 
 #pragma once
 #include "algebra.hpp"
+#include "SceneGraph.hpp"
+#include "Registry.hpp"
+#include "Components.hpp"
 #include "imgui.h"
 #include "string"
 #include "memory"
+#include <vector>
 
+// Fachada sobre o Registry: os dados de transform vivem em componentes
+// (TransformComponent/WorldTransformComponent) e esta classe só guarda o
+// id, o nome e os links de hierarquia usados pelo editor e pelo SceneGraph.
 class Entity {
 public:
     std::string name;
     bool enabled = true;
 
+    Entity(Registry& registry, const std::string& name = "Entity")
+        : name(name), registry(&registry), id(registry.create()) {
+        registry.emplace<TransformComponent>(id);
+        registry.emplace<WorldTransformComponent>(id);
+    }
+
+    // Se a Scene já destruiu a entidade (Scene::flushDestroyed), o handle
+    // está inválido e destroy() não faz nada
+    virtual ~Entity() {
+        registry->destroy(id);
+    }
 
-    Entity(const std::string& name = "Entity")
-        : name(name), position(0.0f, 0.0f, 0.0f), rotation(0.0f, 0.0f, 0.0f), scale(1.0f,1.0f,1.0f) {}
+    Entity(const Entity&) = delete;
+    Entity& operator=(const Entity&) = delete;
 
-    virtual ~Entity() = default;
+    EntityId getId() const { return id; }
+    Registry& getRegistry() const { return *registry; }
+
+    const alg::Vec3& getPosition() const { return transform().position; }
+    // Ângulos de Euler em graus (usados pelo editor)
+    const alg::Vec3& getRotation() const { return transform().eulerDegrees; }
+    const alg::Quat& getOrientation() const { return transform().orientation; }
+    const alg::Vec3& getScale() const { return transform().scale; }
+
+    // Setters (todos marcam a matriz como suja)
+    void setPosition(const alg::Vec3& newPos) {
+        transform().position = newPos;
+        markDirty();
+    }
+    void setRotation(const alg::Vec3& newRotDegrees) {
+        TransformComponent& t = transform();
+        t.eulerDegrees = newRotDegrees;
+        t.orientation = alg::Quat::from_euler(alg::Vec3(
+            alg::degrees_to_radians(newRotDegrees.x),
+            alg::degrees_to_radians(newRotDegrees.y),
+            alg::degrees_to_radians(newRotDegrees.z)));
+        markDirty();
+    }
+    void setOrientation(const alg::Quat& newOrientation) {
+        TransformComponent& t = transform();
+        t.orientation = newOrientation.normalized();
+        const alg::Vec3 euler = t.orientation.to_euler();
+        t.eulerDegrees = alg::Vec3(
+            alg::radians_to_degrees(euler.x),
+            alg::radians_to_degrees(euler.y),
+            alg::radians_to_degrees(euler.z));
+        markDirty();
+    }
+    void setScale(const alg::Vec3& newScale) {
+        transform().scale = newScale;
+        markDirty();
+    }
 
-    const alg::Vec3& getPosition() const { return position; }
-    const alg::Vec3& getRotation() const { return rotation; }
-    const alg::Vec3& getScale() const { return scale; }
+    // Transform local (TRS) em cache; só é recalculado quando algo mudou
+    const alg::Mat4& getLocalMatrix() const {
+        return transform().getLocalMatrix();
+    }
 
-    // Setters
-    void setPosition(const alg::Vec3& newPos) { position = newPos; }
-    void setRotation(const alg::Vec3& newRot) { rotation = newRot; }
-    void setScale(const alg::Vec3& newScale) { scale = newScale; }
+    // Matriz de mundo (model). Dentro de uma Scene é escrita pelo SceneGraph
+    // e vale a partir do último Scene::updateTransforms(); fora dela é o local.
+    const alg::Mat4& getTransformMatrix() const {
+        if (graph && graphIndex >= 0) return world().world;
+        return getLocalMatrix();
+    }
 
-    virtual alg::Mat4 getTransformMatrix() const {
-        return alg::Mat4::create_translation(position) *
-            alg::Mat4::create_rotation_xyz(rotation) *
-                alg::Mat4::create_scale(scale);
+    // Inversa transposta da matriz de mundo (para normais)
+    const alg::Mat4& getNormalMatrix() const {
+        if (!(graph && graphIndex >= 0)) {
+            world().normal = getLocalMatrix().normal_matrix();
+        }
+        return world().normal;
     }
 
+    bool isDirty() const { return transform().dirty; }
+
+    // Hierarquia (alterada via Scene::setParent)
+    Entity* getParent() const { return parent; }
+    const std::vector<Entity*>& getChildren() const { return children; }
+
     virtual void drawUI() {
        char nameBuffer[256];
         strncpy(nameBuffer, name.c_str(), sizeof(nameBuffer));
@@ -43,13 +108,45 @@ public:
 
         ImGui::Separator();
         ImGui::Text("Transform");
-        ImGui::DragFloat3("Position", &position.x, 0.1f);
-        ImGui::DragFloat3("Rotation", &rotation.x, 1.0f, -180.0f, 180.0f);
-        ImGui::DragFloat3("Scale", &scale.x, 0.1f, 0.01f, 10.0f);
+        TransformComponent& t = transform();
+        if (ImGui::DragFloat3("Position", &t.position.x, 0.1f)) {
+            markDirty();
+        }
+        // O editor trabalha em Euler; o quaternion é a fonte da verdade para o transform
+        alg::Vec3 eulerDegrees = t.eulerDegrees;
+        if (ImGui::DragFloat3("Rotation", &eulerDegrees.x, 1.0f, -180.0f, 180.0f)) {
+            setRotation(eulerDegrees);
+        }
+        if (ImGui::DragFloat3("Scale", &t.scale.x, 0.1f, 0.01f, 10.0f)) {
+            markDirty();
+        }
     }
 
 protected:
-    alg::Vec3 position = alg::Vec3(0.0f,0.0f,0.0f);
-    alg::Vec3 rotation = alg::Vec3(0.0f,0.0f,0.0f);
-    alg::Vec3 scale = alg::Vec3(1.0f,1.0f,1.0f);
-};
\ No newline at end of file
+    // Referências válidas até o próximo emplace/remove no mesmo pool
+    TransformComponent& transform() const { return registry->get<TransformComponent>(id); }
+    WorldTransformComponent& world() const { return registry->get<WorldTransformComponent>(id); }
+
+    // Deve ser chamado após qualquer alteração direta no TransformComponent
+    void markDirty() {
+        transform().dirty = true;
+        if (graph && pendingIndex < 0) {
+            graph->enqueue(this);
+        }
+    }
+
+    Registry* registry;
+    EntityId id;
+
+private:
+    friend class SceneGraph;
+
+    // Hierarquia; os ponteiros não são donos (a Scene guarda os shared_ptr)
+    Entity* parent = nullptr;
+    std::vector<Entity*> children;
+    int siblingIndex = -1;             // Posição em parent->children (ou nas raízes)
+
+    SceneGraph* graph = nullptr;
+    int graphIndex = -1;               // Posição na ordem BFS do grafo
+    int pendingIndex = -1;             // Posição na fila de alterações do grafo (-1 = fora)
+};
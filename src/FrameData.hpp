@@ -0,0 +1,126 @@
+// FrameData.hpp
+
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "algebra.hpp"
+#include "geometry.hpp"
+#include "LightClusters.hpp"
+#include "RenderQueue.hpp"
+
+class Mesh;
+class Shader;
+class Texture;
+
+// Luzes escolhidas por draw quando o forward clusterizado está desligado
+// (LightSelection), como índices no texture buffer de luzes
+inline constexpr std::uint32_t LIGHTS_PER_DRAW = 4;
+inline constexpr std::uint32_t NO_LIGHT = 0xFFFFFFFFu; // Posição vazia
+
+// Um draw pronto para a submissão: cópia dos dados da entidade no momento
+// em que a lista foi montada, para a cena poder mudar enquanto o frame é
+// desenhado.
+struct DrawItem {
+    Mesh* mesh = nullptr;
+    Shader* shader = nullptr;
+    Texture* texture = nullptr; // Difusa do material (pode não ter)
+    // Nomes GL (programa, textura, VAO), usados nas chaves da RenderQueue
+    std::uint32_t shaderId = 0;
+    std::uint32_t textureId = 0;
+    std::uint32_t meshId = 0;
+    bool transparent = false;
+    std::uint32_t material = 0; // Posição no buffer de materiais
+    alg::Mat4 model;
+    alg::Mat4 normal;
+    alg::AABB bounds; // Caixa de mundo, para escolher as luzes
+    std::uint32_t lights[LIGHTS_PER_DRAW] = {NO_LIGHT, NO_LIGHT, NO_LIGHT, NO_LIGHT};
+};
+
+// Dados por instância, no layout dos atributos 3-12 de basic.vert
+struct InstanceData {
+    alg::Mat4 model;
+    alg::Mat4 normal;
+    std::uint32_t material;
+    std::uint32_t padding[3];
+    std::uint32_t lights[LIGHTS_PER_DRAW];
+};
+static_assert(sizeof(InstanceData) == 160, "InstanceData precisa bater com o stride do buffer de instâncias");
+
+// Cores de um Material como o shader as lê: 3 texels RGBA32F do buffer de
+// materiais (samplerBuffer materials em basic.vert)
+struct MaterialData {
+    alg::Vec4 ambientShininess; // xyz = ambient, w = shininess
+    alg::Vec4 diffuse;          // w sem uso
+    alg::Vec4 specular;         // w sem uso
+};
+static_assert(sizeof(MaterialData) == 48, "MaterialData precisa ter 3 texels");
+
+struct MaterialUpdate {
+    std::uint32_t slot;
+    MaterialData data;
+};
+
+// Draws consecutivos (na ordem da RenderQueue) com o mesmo mesh, shader e
+// textura viram um único draw instanciado: instanceCount instâncias a
+// partir de firstInstance em FrameData::instances
+struct DrawBatch {
+    std::uint32_t firstInstance = 0;
+    std::uint32_t instanceCount = 0;
+    std::uint32_t draw = 0; // DrawItem de onde vem o estado (mesh, shader, textura)
+    bool transparent = false;
+};
+
+// Os valores são os códigos de tipo de basic.frag (directionType.w)
+enum class LightType {
+    POINT,
+    DIRECTIONAL,
+    SPOT,
+    AREA
+};
+
+// Luz já em espaço de mundo, no formato do struct Light de basic.frag
+struct FrameLight {
+    LightType type = LightType::POINT;
+    bool enabled = true;
+    alg::Vec3 position;
+    alg::Vec3 direction;
+    alg::Vec3 color;
+    float intensity = 1.0f;
+    float range = 10.0f;
+    float cosInner = 1.0f;
+    float cosOuter = 1.0f;
+};
+
+// Tudo que a submissão GL de um frame lê. São dois: enquanto a thread
+// principal desenha um, os workers preparam o outro (veja main.cpp).
+// Meshes e shaders são ponteiros crus: a Scene segura os recursos de
+// entidades destruídas por um frame a mais (Scene::flushDestroyed).
+struct FrameData {
+    std::uint64_t frameIndex = 0;
+    bool ready = false; // false até a primeira preparação terminar
+
+    // Câmera (copiada na thread principal antes de lançar a preparação)
+    alg::Mat4 projection;
+    alg::Mat4 view;
+    alg::Vec3 viewPos;
+    alg::Frustum frustum;
+    float nearPlane = 0.1f;
+    float farPlane = 100.0f;
+    int viewportWidth = 1;  // Em pixels (framebuffer)
+    int viewportHeight = 1;
+    // Cópia de Renderer::isClusteredLightingEnabled(): sem clusters, cada
+    // draw leva as suas luzes (DrawItem::lights)
+    bool clusteredLighting = true;
+
+    std::vector<DrawItem> draws;
+    RenderQueue queue; // Ordem de submissão de draws
+    std::vector<InstanceData> instances; // Na ordem da fila
+    std::vector<DrawBatch> batches;
+    std::vector<FrameLight> lights;
+    LightClusters clusters; // Das luzes acima (sem os clusters, só os dados das luzes)
+
+    // Materiais que mudaram desde o frame anterior (os frames são
+    // submetidos em ordem, então o buffer na GPU acompanha)
+    std::vector<MaterialUpdate> materialUpdates;
+    std::uint32_t materialCount = 0;
+};
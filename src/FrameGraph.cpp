@@ -0,0 +1,61 @@
+#include "FrameGraph.hpp"
+
+#include <chrono>
+
+namespace {
+    std::uint64_t nowNs() {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+}
+
+FrameGraph::TaskId FrameGraph::addTask(std::string name, std::function<void()> fn,
+                                       std::initializer_list<TaskId> dependencies) {
+    const TaskId id = static_cast<TaskId>(tasks.size());
+    auto task = std::make_unique<Task>();
+    task->name = std::move(name);
+    task->fn = std::move(fn);
+    for (const TaskId dependency : dependencies) {
+        if (dependency < id) {
+            tasks[dependency]->successors.push_back(id);
+            ++task->dependencyCount;
+        }
+    }
+    tasks.push_back(std::move(task));
+    return id;
+}
+
+void FrameGraph::launch(JobSystem& jobs) {
+    launchNs = nowNs();
+    // Tudo é reiniciado antes de lançar a primeira etapa: depois disso os
+    // contadores já podem estar sendo decrementados pelos workers
+    for (const std::unique_ptr<Task>& task : tasks) {
+        task->remaining.store(task->dependencyCount, std::memory_order_relaxed);
+    }
+    for (TaskId id = 0; id < tasks.size(); ++id) {
+        if (tasks[id]->dependencyCount == 0) {
+            jobs.run([this, &jobs, id] { runTask(jobs, id); }, &running);
+        }
+    }
+}
+
+void FrameGraph::wait(JobSystem& jobs) {
+    jobs.wait(running);
+}
+
+void FrameGraph::runTask(JobSystem& jobs, TaskId id) {
+    Task& task = *tasks[id];
+    const std::uint64_t start = nowNs();
+    task.fn();
+    const std::uint64_t end = nowNs();
+    task.timing.startMs = static_cast<float>(start - launchNs) * 1e-6f;
+    task.timing.durationMs = static_cast<float>(end - start) * 1e-6f;
+
+    // Libera os sucessores cuja última dependência era esta. São lançados
+    // com o mesmo contador antes deste job terminar, então ele não zera no meio.
+    for (const TaskId successor : task.successors) {
+        if (tasks[successor]->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            jobs.run([this, &jobs, successor] { runTask(jobs, successor); }, &running);
+        }
+    }
+}
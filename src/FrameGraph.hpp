@@ -0,0 +1,66 @@
+#ifndef FRAMEGRAPH_HPP
+#define FRAMEGRAPH_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <vector>
+#include "JobSystem.hpp"
+
+// Grafo de dependências das etapas de CPU de um frame.
+//
+// As etapas são registradas uma vez (addTask) e o grafo é executado a cada
+// frame no JobSystem: uma etapa é lançada assim que todas as suas
+// dependências terminam, então etapas independentes rodam ao mesmo tempo
+// em workers diferentes. launch() não bloqueia, o que deixa a thread
+// principal livre para outra coisa (a submissão GL do frame anterior)
+// antes de chamar wait().
+class FrameGraph {
+public:
+    using TaskId = std::uint32_t;
+
+    struct TaskTiming {
+        float startMs = 0.0f;    // Desde launch()
+        float durationMs = 0.0f;
+    };
+
+    FrameGraph() = default;
+    FrameGraph(const FrameGraph&) = delete;
+    FrameGraph& operator=(const FrameGraph&) = delete;
+
+    // Dependências precisam ter sido adicionadas antes (o grafo não tem
+    // ciclos por construção). Não chamar com o grafo rodando.
+    TaskId addTask(std::string name, std::function<void()> fn, std::initializer_list<TaskId> dependencies = {});
+
+    // Lança as etapas sem dependências; as outras saem conforme as
+    // anteriores terminam
+    void launch(JobSystem& jobs);
+    // Executa jobs até a última etapa terminar
+    void wait(JobSystem& jobs);
+
+    std::size_t taskCount() const { return tasks.size(); }
+    const std::string& taskName(TaskId id) const { return tasks[id]->name; }
+    // Tempos da última execução completa
+    const TaskTiming& taskTiming(TaskId id) const { return tasks[id]->timing; }
+
+private:
+    struct Task {
+        std::string name;
+        std::function<void()> fn;
+        std::vector<TaskId> successors;
+        int dependencyCount = 0;
+        std::atomic<int> remaining{0};
+        TaskTiming timing;
+    };
+
+    void runTask(JobSystem& jobs, TaskId id);
+
+    std::vector<std::unique_ptr<Task>> tasks;
+    JobCounter running;
+    std::uint64_t launchNs = 0;
+};
+
+#endif // FRAMEGRAPH_HPP
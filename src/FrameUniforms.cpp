@@ -0,0 +1,110 @@
+#include "FrameUniforms.hpp"
+
+#include <glad/glad.h>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    std::size_t alignUp(std::size_t value, std::size_t alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+}
+
+void packCameraBlock(const FrameData& frame, CameraBlock& block) {
+    block.projection = frame.projection;
+    block.view = frame.view;
+    block.viewPos = alg::Vec4(frame.viewPos.x, frame.viewPos.y, frame.viewPos.z, 1.0f);
+}
+
+LightBlockEntry packLight(const FrameLight& light) {
+    LightBlockEntry entry;
+    entry.positionRange = alg::Vec4(light.position.x, light.position.y, light.position.z, light.range);
+    entry.directionType = alg::Vec4(light.direction.x, light.direction.y, light.direction.z, static_cast<float>(static_cast<int>(light.type)));
+    entry.colorIntensity = alg::Vec4(light.color.x, light.color.y, light.color.z, light.intensity);
+    entry.cone = alg::Vec4(light.cosInner, light.cosOuter, light.enabled ? 1.0f : 0.0f, 0.0f);
+    return entry;
+}
+
+void packLightBlock(const FrameData& frame, LightBlock& block) {
+    const int count = std::min(static_cast<int>(frame.lights.size()), MAX_SHADER_LIGHTS);
+    for (int i = 0; i < count; ++i) {
+        block.lights[i] = packLight(frame.lights[i]);
+    }
+    block.activeLightCount = count;
+}
+
+void packClusterBlock(const FrameData& frame, bool enabled, ClusterBlock& block) {
+    const LightClusters& clusters = frame.clusters;
+    block.grid[0] = LightClusters::GRID_X;
+    block.grid[1] = LightClusters::GRID_Y;
+    block.grid[2] = LightClusters::GRID_Z;
+    block.grid[3] = enabled ? 1u : 0u;
+    block.depth = alg::Vec4(clusters.getDepthScale(), clusters.getDepthBias(), clusters.getNearPlane(), clusters.getFarPlane());
+    block.tileSize = alg::Vec4(clusters.getTileWidth(), clusters.getTileHeight(), 0.0f, 0.0f);
+}
+
+FrameUniformRing::~FrameUniformRing() {
+    for (void* sync : fences) {
+        if (sync) glDeleteSync(static_cast<GLsync>(sync));
+    }
+    if (buffer) {
+        glDeleteBuffers(1, &buffer);
+    }
+}
+
+void FrameUniformRing::create() {
+    GLint alignment = 256;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    const std::size_t align = static_cast<std::size_t>(std::max(alignment, 16));
+    lightOffset = alignUp(sizeof(CameraBlock), align);
+    clusterOffset = alignUp(lightOffset + sizeof(LightBlock), align);
+    sliceSize = alignUp(clusterOffset + sizeof(ClusterBlock), align);
+
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+    glBufferData(GL_UNIFORM_BUFFER, static_cast<GLsizeiptr>(sliceSize * FRAMES), nullptr, GL_DYNAMIC_DRAW);
+}
+
+void FrameUniformRing::upload(const CameraBlock& camera, const LightBlock& lights, const ClusterBlock& clusters) {
+    if (!buffer) {
+        create();
+    }
+    current = (current + 1) % FRAMES;
+
+    // Com FRAMES fatias, isto quase nunca espera: a fence é de dois frames atrás
+    if (fences[current]) {
+        GLsync sync = static_cast<GLsync>(fences[current]);
+        glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, GLuint64(1000000000));
+        glDeleteSync(sync);
+        fences[current] = nullptr;
+    }
+
+    const std::size_t base = std::size_t(current) * sliceSize;
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+    void* mapped = glMapBufferRange(GL_UNIFORM_BUFFER, static_cast<GLintptr>(base), static_cast<GLsizeiptr>(sliceSize),
+                                    GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    if (mapped) {
+        std::memcpy(mapped, &camera, sizeof(CameraBlock));
+        std::memcpy(static_cast<char*>(mapped) + lightOffset, &lights, sizeof(LightBlock));
+        std::memcpy(static_cast<char*>(mapped) + clusterOffset, &clusters, sizeof(ClusterBlock));
+        glUnmapBuffer(GL_UNIFORM_BUFFER);
+    }
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    glBindBufferRange(GL_UNIFORM_BUFFER, CAMERA_BLOCK_BINDING, buffer,
+                      static_cast<GLintptr>(base), static_cast<GLsizeiptr>(sizeof(CameraBlock)));
+    glBindBufferRange(GL_UNIFORM_BUFFER, LIGHT_BLOCK_BINDING, buffer,
+                      static_cast<GLintptr>(base + lightOffset), static_cast<GLsizeiptr>(sizeof(LightBlock)));
+    glBindBufferRange(GL_UNIFORM_BUFFER, CLUSTER_BLOCK_BINDING, buffer,
+                      static_cast<GLintptr>(base + clusterOffset), static_cast<GLsizeiptr>(sizeof(ClusterBlock)));
+}
+
+void FrameUniformRing::fence() {
+    if (current < 0) {
+        return;
+    }
+    if (fences[current]) {
+        glDeleteSync(static_cast<GLsync>(fences[current]));
+    }
+    fences[current] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
@@ -0,0 +1,99 @@
+#ifndef FRAMEUNIFORMS_HPP
+#define FRAMEUNIFORMS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include "algebra.hpp"
+#include "FrameData.hpp"
+
+// Tamanho do array lights[] em basic.frag (MAX_LIGHTS), usado quando o
+// forward clusterizado está desligado e o draw não tem luzes escolhidas
+// (ModelEntity::render)
+inline constexpr int MAX_SHADER_LIGHTS = 8;
+
+// Binding points fixos dos uniform blocks. O GLSL 330 não tem
+// layout(binding = N): o Shader liga os blocos pelo nome depois do link.
+inline constexpr unsigned int CAMERA_BLOCK_BINDING = 0;
+inline constexpr unsigned int LIGHT_BLOCK_BINDING = 1;
+inline constexpr unsigned int CLUSTER_BLOCK_BINDING = 2;
+
+struct UniformBlockBinding {
+    const char* name;
+    unsigned int binding;
+};
+inline constexpr UniformBlockBinding FRAME_UNIFORM_BLOCKS[] = {
+    {"Camera", CAMERA_BLOCK_BINDING},
+    {"Lights", LIGHT_BLOCK_BINDING},
+    {"Clusters", CLUSTER_BLOCK_BINDING},
+};
+
+// Espelhos std140 dos blocos de basic.vert/basic.frag. Só vec4/mat4 (e um
+// int no fim), para o layout do C++ coincidir sem padding escondido.
+struct CameraBlock {
+    alg::Mat4 projection;
+    alg::Mat4 view;
+    alg::Vec4 viewPos; // w sem uso
+};
+static_assert(sizeof(CameraBlock) == 144, "CameraBlock precisa bater com o bloco Camera (std140)");
+
+struct LightBlockEntry {
+    alg::Vec4 positionRange;  // xyz = posição, w = alcance
+    alg::Vec4 directionType;  // xyz = direção, w = tipo (0 point, 1 directional, 2 spot)
+    alg::Vec4 colorIntensity; // xyz = cor, w = intensidade
+    alg::Vec4 cone;           // x = cos(inner), y = cos(outer), z = ligada (0/1)
+};
+
+struct LightBlock {
+    LightBlockEntry lights[MAX_SHADER_LIGHTS];
+    std::int32_t activeLightCount = 0;
+    std::int32_t padding[3] = {};
+};
+static_assert(sizeof(LightBlock) == MAX_SHADER_LIGHTS * 64 + 16, "LightBlock precisa bater com o bloco Lights (std140)");
+
+// Parâmetros do grid de clusters (LightClusters) para o fragment shader
+struct ClusterBlock {
+    std::uint32_t grid[4]; // xyz = clusters por eixo, w = 1 se o caminho clusterizado está ligado
+    alg::Vec4 depth;       // x = escala, y = bias da fatia log, z = near, w = far
+    alg::Vec4 tileSize;    // xy = pixels por tile
+};
+static_assert(sizeof(ClusterBlock) == 48, "ClusterBlock precisa bater com o bloco Clusters (std140)");
+
+LightBlockEntry packLight(const FrameLight& light);
+void packCameraBlock(const FrameData& frame, CameraBlock& block);
+// As primeiras MAX_SHADER_LIGHTS luzes do frame
+void packLightBlock(const FrameData& frame, LightBlock& block);
+void packClusterBlock(const FrameData& frame, bool enabled, ClusterBlock& block);
+
+// Anel de uniform buffers para os blocos por frame: um buffer só, com uma
+// fatia por frame em voo. Cada upload escreve na fatia seguinte sem
+// sincronizar com o driver (mapeamento unsynchronized); uma fence por
+// fatia garante que a GPU já terminou de ler o que estava lá.
+//
+// Só na thread do contexto GL.
+class FrameUniformRing {
+public:
+    static constexpr int FRAMES = 3;
+
+    FrameUniformRing() = default;
+    ~FrameUniformRing();
+
+    FrameUniformRing(const FrameUniformRing&) = delete;
+    FrameUniformRing& operator=(const FrameUniformRing&) = delete;
+
+    // Escreve os blocos na próxima fatia e a liga nos binding points
+    void upload(const CameraBlock& camera, const LightBlock& lights, const ClusterBlock& clusters);
+    // Depois dos draws que leem a fatia atual
+    void fence();
+
+private:
+    void create();
+
+    unsigned int buffer = 0;
+    std::size_t lightOffset = 0;   // Dentro da fatia, alinhados
+    std::size_t clusterOffset = 0;
+    std::size_t sliceSize = 0;   // Alinhado
+    int current = -1;
+    void* fences[FRAMES] = {}; // GLsync
+};
+
+#endif // FRAMEUNIFORMS_HPP
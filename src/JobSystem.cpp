@@ -0,0 +1,270 @@
+#include "JobSystem.hpp"
+
+namespace {
+    // A qual sistema (e em qual posição) a thread atual pertence
+    thread_local JobSystem* currentSystem = nullptr;
+    thread_local int currentThread = -1;
+    thread_local std::uint32_t stealSeed = 0;
+
+    std::uint32_t nextRandom() {
+        // xorshift32: só para espalhar as vítimas do roubo
+        std::uint32_t x = stealSeed;
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        stealSeed = x;
+        return x;
+    }
+
+    std::uint64_t nowNs() {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+}
+
+// --- WorkStealingQueue ---
+// Segue "Correct and Efficient Work-Stealing for Weak Memory Models"
+// (Lê et al., 2013), com buffer fixo.
+
+bool WorkStealingQueue::push(Job* job) {
+    const std::int64_t b = bottom.load(std::memory_order_relaxed);
+    const std::int64_t t = top.load(std::memory_order_acquire);
+    if (b - t >= CAPACITY) {
+        return false;
+    }
+    buffer[b & MASK].store(job, std::memory_order_relaxed);
+    bottom.store(b + 1, std::memory_order_release);
+    return true;
+}
+
+Job* WorkStealingQueue::pop() {
+    const std::int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+    bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t t = top.load(std::memory_order_relaxed);
+
+    if (t > b) {
+        // Vazia
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    Job* job = buffer[b & MASK].load(std::memory_order_relaxed);
+    if (t == b) {
+        // Último elemento: disputa com quem estiver roubando
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            job = nullptr;
+        }
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+    return job;
+}
+
+Job* WorkStealingQueue::steal() {
+    std::int64_t t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const std::int64_t b = bottom.load(std::memory_order_acquire);
+    if (t >= b) {
+        return nullptr;
+    }
+
+    Job* job = buffer[t & MASK].load(std::memory_order_relaxed);
+    if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return nullptr; // Outra thread levou
+    }
+    return job;
+}
+
+// --- JobSystem ---
+
+JobSystem::JobSystem(unsigned int workerCount) {
+    if (workerCount == 0) {
+        const unsigned int cores = std::thread::hardware_concurrency();
+        workerCount = cores > 1 ? cores - 1 : 0;
+    }
+
+    const unsigned int threads = workerCount + 1;
+    for (unsigned int i = 0; i < threads; ++i) {
+        queues.push_back(std::make_unique<WorkStealingQueue>());
+        stats.push_back(std::make_unique<ThreadStats>());
+    }
+    lastBusy.assign(threads, 0);
+    lastJobs.assign(threads, 0);
+    utilization.assign(threads, 0.0f);
+    jobCounts.assign(threads, 0);
+    lastSample = std::chrono::steady_clock::now();
+
+    // A thread que cria o sistema é a de índice 0
+    currentSystem = this;
+    currentThread = 0;
+    stealSeed = 0x9E3779B9u;
+
+    workers.reserve(workerCount);
+    for (unsigned int i = 1; i < threads; ++i) {
+        workers.emplace_back([this, i] { workerLoop(static_cast<int>(i)); });
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping.store(true);
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    // O que sobrou (continuações lançadas sem ninguém esperar) roda aqui
+    bool ranAny = true;
+    while (ranAny) {
+        ranAny = false;
+        for (const std::unique_ptr<WorkStealingQueue>& queue : queues) {
+            while (Job* job = queue->steal()) {
+                execute(job, 0);
+                ranAny = true;
+            }
+        }
+    }
+
+    if (currentSystem == this) {
+        currentSystem = nullptr;
+        currentThread = -1;
+    }
+}
+
+int JobSystem::currentIndex() const {
+    return currentSystem == this ? currentThread : -1;
+}
+
+void JobSystem::submit(Job* job) {
+    const int self = currentIndex();
+    if (self < 0 || !queues[self]->push(job)) {
+        // Thread de fora ou deque cheia: executa aqui mesmo
+        execute(job, self);
+        return;
+    }
+
+    queuedJobs.fetch_add(1);
+    if (sleeping.load() > 0) {
+        // Passa pelo mutex para não perder o aviso de um worker que acabou
+        // de testar o predicado e ainda não dormiu
+        { std::lock_guard<std::mutex> lock(sleepMutex); }
+        wake.notify_one();
+    }
+}
+
+Job* JobSystem::findJob(int self) {
+    if (Job* job = queues[self]->pop()) {
+        queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+        return job;
+    }
+
+    // Rouba começando de uma vítima aleatória
+    const int count = static_cast<int>(queues.size());
+    const int start = static_cast<int>(nextRandom() % static_cast<std::uint32_t>(count));
+    for (int i = 0; i < count; ++i) {
+        const int victim = (start + i) % count;
+        if (victim == self) continue;
+        if (Job* job = queues[victim]->steal()) {
+            queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+void JobSystem::execute(Job* job, int self) {
+    const std::uint64_t start = nowNs();
+    job->invoke(*job);
+    JobCounter* counter = job->counter;
+    delete job;
+
+    if (self >= 0) {
+        // Só esta thread escreve nas suas estatísticas
+        ThreadStats& threadStats = *stats[self];
+        threadStats.busyNs.store(threadStats.busyNs.load(std::memory_order_relaxed) + (nowNs() - start),
+                                 std::memory_order_relaxed);
+        threadStats.jobs.store(threadStats.jobs.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    if (counter) {
+        finish(counter);
+    }
+}
+
+void JobSystem::finish(JobCounter* counter) {
+    counter->finishing.fetch_add(1, std::memory_order_acq_rel);
+    if (counter->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::vector<Job*> ready;
+        {
+            std::lock_guard<std::mutex> lock(counter->continuationMutex);
+            ready.swap(counter->continuations);
+        }
+        for (Job* job : ready) {
+            submit(job);
+        }
+    }
+    // Último acesso ao contador: depois disso quem espera pode destruí-lo
+    counter->finishing.fetch_sub(1, std::memory_order_release);
+}
+
+void JobSystem::wait(JobCounter& counter) {
+    const int self = currentIndex();
+    while (!counter.done()) {
+        Job* job = self >= 0 ? findJob(self) : nullptr;
+        if (job) {
+            execute(job, self);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::workerLoop(int self) {
+    currentSystem = this;
+    currentThread = self;
+    stealSeed = 0x9E3779B9u * static_cast<std::uint32_t>(self + 1);
+
+    constexpr int SPINS_BEFORE_SLEEP = 64;
+    int idleSpins = 0;
+    while (!stopping.load(std::memory_order_relaxed)) {
+        if (Job* job = findJob(self)) {
+            execute(job, self);
+            idleSpins = 0;
+            continue;
+        }
+
+        // Um pouco de espera ativa antes de dormir: trabalho costuma chegar
+        // em rajadas (um parallelFor lança vários jobs de uma vez)
+        if (++idleSpins < SPINS_BEFORE_SLEEP) {
+            std::this_thread::yield();
+            continue;
+        }
+        idleSpins = 0;
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleeping.fetch_add(1);
+        wake.wait(lock, [this] { return queuedJobs.load() > 0 || stopping.load(); });
+        sleeping.fetch_sub(1);
+    }
+}
+
+void JobSystem::sampleUtilization() {
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    const double elapsedNs = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now - lastSample).count());
+    lastSample = now;
+
+    for (std::size_t i = 0; i < stats.size(); ++i) {
+        const std::uint64_t busy = stats[i]->busyNs.load(std::memory_order_relaxed);
+        const std::uint64_t jobs = stats[i]->jobs.load(std::memory_order_relaxed);
+        // Um job é contado quando termina, então um job longo pode passar de 100%
+        utilization[i] = elapsedNs > 0.0
+            ? std::min(1.0f, static_cast<float>(static_cast<double>(busy - lastBusy[i]) / elapsedNs))
+            : 0.0f;
+        jobCounts[i] = static_cast<std::uint32_t>(jobs - lastJobs[i]);
+        lastBusy[i] = busy;
+        lastJobs[i] = jobs;
+    }
+}
@@ -0,0 +1,210 @@
+#ifndef JOBSYSTEM_HPP
+#define JOBSYSTEM_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <condition_variable>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+class JobSystem;
+class JobCounter;
+
+// Um job: a função (guardada inline, sem alocação extra) e o contador que
+// ele decrementa ao terminar. Ocupa exatamente uma linha de cache.
+struct alignas(64) Job {
+    static constexpr std::size_t STORAGE = 48;
+
+    void (*invoke)(Job&) = nullptr; // Chama a função guardada e a destrói
+    JobCounter* counter = nullptr;
+    alignas(std::max_align_t) unsigned char storage[STORAGE];
+};
+
+// Contador de dependência: cada job lançado com ele incrementa, cada job
+// que termina decrementa. Serve para esperar um grupo de jobs (wait) e para
+// encadear continuações (runAfter), que são liberadas quando chega a zero.
+//
+// Precisa viver até wait() retornar ou done() dar true.
+class JobCounter {
+public:
+    JobCounter() = default;
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    bool done() const {
+        return pending.load(std::memory_order_acquire) == 0 &&
+               finishing.load(std::memory_order_acquire) == 0;
+    }
+
+private:
+    friend class JobSystem;
+
+    std::atomic<int> pending{0};
+    // Threads ainda dentro de JobSystem::finish() com este contador: quem
+    // espera não pode destruí-lo enquanto alguém ainda mexe nele
+    std::atomic<int> finishing{0};
+    std::mutex continuationMutex;
+    std::vector<Job*> continuations;
+};
+
+// Deque de Chase-Lev com capacidade fixa. O dono empurra e tira do fundo
+// (LIFO, o que está quente no cache); as outras threads roubam do topo.
+class WorkStealingQueue {
+public:
+    static constexpr std::int64_t CAPACITY = 4096; // Potência de 2
+
+    // Só o dono. false se estiver cheia (quem chamou executa o job na hora)
+    bool push(Job* job);
+    // Só o dono
+    Job* pop();
+    // Qualquer thread
+    Job* steal();
+
+private:
+    static constexpr std::int64_t MASK = CAPACITY - 1;
+
+    alignas(64) std::atomic<std::int64_t> top{0};
+    alignas(64) std::atomic<std::int64_t> bottom{0};
+    alignas(64) std::atomic<Job*> buffer[CAPACITY] = {};
+};
+
+// Pool fixo de threads com roubo de trabalho.
+//
+// Cada thread (workers e a thread que criou o sistema, índice 0) tem sua
+// deque sem lock; jobs novos vão para a deque de quem os lançou e threads
+// ociosas roubam das outras. wait() não bloqueia: a thread que espera
+// executa jobs até o contador zerar, então a thread principal também
+// trabalha. Workers sem nada para fazer dormem numa condition variable.
+//
+// Jobs só podem ser lançados de threads do próprio sistema; de outra thread
+// eles são executados na hora. Jobs não devem lançar exceções.
+class JobSystem {
+public:
+    // 0 = uma thread por núcleo (contando a principal)
+    explicit JobSystem(unsigned int workerCount = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Lança fn() (capturas até Job::STORAGE bytes). Com counter, ele é
+    // incrementado agora e decrementado quando fn terminar.
+    template <class F>
+    void run(F&& fn, JobCounter* counter = nullptr) {
+        if (counter) counter->pending.fetch_add(1, std::memory_order_relaxed);
+        submit(makeJob(std::forward<F>(fn), counter));
+    }
+
+    // Lança fn() quando dependency chegar a zero (na hora, se já estiver).
+    // counter é incrementado já, então wait(*counter) espera a continuação.
+    template <class F>
+    void runAfter(JobCounter& dependency, F&& fn, JobCounter* counter = nullptr) {
+        if (counter) counter->pending.fetch_add(1, std::memory_order_relaxed);
+        Job* job = makeJob(std::forward<F>(fn), counter);
+        {
+            std::lock_guard<std::mutex> lock(dependency.continuationMutex);
+            if (dependency.pending.load(std::memory_order_acquire) != 0) {
+                dependency.continuations.push_back(job);
+                return;
+            }
+        }
+        submit(job);
+    }
+
+    // Executa jobs até counter zerar
+    void wait(JobCounter& counter);
+
+    // fn(first, last) sobre pedaços de [begin, end) de pelo menos grain
+    // índices, em paralelo; retorna quando todos terminarem. Intervalos
+    // até grain rodam direto em quem chamou.
+    template <class F>
+    void parallelFor(std::size_t begin, std::size_t end, std::size_t grain, F&& fn) {
+        if (begin >= end) return;
+        const std::size_t count = end - begin;
+        grain = std::max<std::size_t>(grain, 1);
+        if (count <= grain || workers.empty()) {
+            fn(begin, end);
+            return;
+        }
+
+        // Alguns pedaços por thread, para o roubo equilibrar pedaços desiguais
+        const std::size_t chunks = std::min((count + grain - 1) / grain, std::size_t(threadCount()) * 4);
+        const std::size_t chunkSize = (count + chunks - 1) / chunks;
+
+        JobCounter counter;
+        for (std::size_t first = begin + chunkSize; first < end; first += chunkSize) {
+            const std::size_t last = std::min(first + chunkSize, end);
+            run([&fn, first, last] { fn(first, last); }, &counter);
+        }
+        // O primeiro pedaço fica com quem chamou
+        fn(begin, begin + chunkSize);
+        wait(counter);
+    }
+
+    // Workers + a thread principal
+    unsigned int threadCount() const { return static_cast<unsigned int>(queues.size()); }
+
+    // Fecha a janela de medição (uma vez por frame): fração do tempo que
+    // cada thread passou executando jobs e quantos executou desde a última
+    // chamada. Índice 0 = thread principal.
+    void sampleUtilization();
+    const std::vector<float>& getUtilization() const { return utilization; }
+    const std::vector<std::uint32_t>& getJobCounts() const { return jobCounts; }
+
+private:
+    struct alignas(64) ThreadStats {
+        std::atomic<std::uint64_t> busyNs{0};
+        std::atomic<std::uint64_t> jobs{0};
+    };
+
+    template <class F>
+    static Job* makeJob(F&& fn, JobCounter* counter) {
+        using Fn = std::decay_t<F>;
+        static_assert(sizeof(Fn) <= Job::STORAGE, "Captura grande demais para um job: capture por referência");
+        static_assert(alignof(Fn) <= alignof(std::max_align_t));
+
+        Job* job = new Job;
+        ::new (static_cast<void*>(job->storage)) Fn(std::forward<F>(fn));
+        job->invoke = [](Job& self) {
+            Fn& f = *std::launder(reinterpret_cast<Fn*>(self.storage));
+            f();
+            f.~Fn();
+        };
+        job->counter = counter;
+        return job;
+    }
+
+    void submit(Job* job);
+    Job* findJob(int self);
+    void execute(Job* job, int self);
+    void finish(JobCounter* counter);
+    void workerLoop(int self);
+    int currentIndex() const;
+
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<WorkStealingQueue>> queues; // [0] = thread principal
+    std::vector<std::unique_ptr<ThreadStats>> stats;
+
+    // Dica para os workers dormirem: jobs nas deques (pode estar atrasada)
+    std::atomic<int> queuedJobs{0};
+    std::atomic<int> sleeping{0};
+    std::atomic<bool> stopping{false};
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+
+    std::chrono::steady_clock::time_point lastSample;
+    std::vector<std::uint64_t> lastBusy;
+    std::vector<std::uint64_t> lastJobs;
+    std::vector<float> utilization;
+    std::vector<std::uint32_t> jobCounts;
+};
+
+#endif // JOBSYSTEM_HPP
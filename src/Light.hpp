@@ -1,80 +1,88 @@
 #pragma once
 #include "Entity.hpp"
 #include "algebra.hpp"
-#include "Shader.hpp"
+#include "FrameData.hpp"
+#include "FrameUniforms.hpp" // MAX_SHADER_LIGHTS
 
-class Light : public Entity {
-public:
-    enum class Type {
-        POINT,
-        DIRECTIONAL,
-        SPOT,
-        AREA
-    };
-
-    Type type = Type::POINT;
+struct LightComponent {
+    LightType type = LightType::POINT;
     bool enabled = true;
     alg::Vec3 color = alg::Vec3(1.0f, 1.0f, 1.0f);
     float intensity = 1.0f;
     float range = 10.0f;
     float innerAngle = 15.0f;  // Para spotlight
     float outerAngle = 30.0f;  // Para spotlight
-    
+};
+
+// Direção forward a partir da rotação do editor (Euler em graus)
+inline alg::Vec3 lightForwardDirection(const TransformComponent& transform) {
+    float sinPitch, cosPitch, sinYaw, cosYaw;
+    alg::hot::sincos(alg::degrees_to_radians(transform.eulerDegrees.x), sinPitch, cosPitch);
+    alg::hot::sincos(alg::degrees_to_radians(transform.eulerDegrees.y), sinYaw, cosYaw);
+
+    return alg::Vec3(
+        cosYaw * cosPitch,
+        sinPitch,
+        sinYaw * cosPitch
+    ).normalized();
+}
+
+// Luz como o shader a vê. A posição vem da matriz de mundo, então luzes
+// filhas de outros objetos acompanham o pai.
+inline FrameLight makeFrameLight(const LightComponent& light, const TransformComponent& transform,
+                                 const WorldTransformComponent& world) {
+    FrameLight frameLight;
+    frameLight.type = light.type;
+    frameLight.enabled = light.enabled;
+    frameLight.position = alg::Vec3(world.world.m[12], world.world.m[13], world.world.m[14]);
+    frameLight.direction = lightForwardDirection(transform);
+    frameLight.color = light.color;
+    frameLight.intensity = light.intensity;
+    frameLight.range = light.range;
+    frameLight.cosInner = cos(alg::degrees_to_radians(light.innerAngle));
+    frameLight.cosOuter = cos(alg::degrees_to_radians(light.outerAngle));
+    return frameLight;
+}
+
+// Fachada sobre LightComponent
+class Light : public Entity {
+public:
+    using Type = LightType;
+
     // Construtor
-    Light(const std::string& name = "Light") : Entity(name) {}
+    Light(Registry& registry, const std::string& name = "Light") : Entity(registry, name) {
+        registry.emplace<LightComponent>(id);
+    }
+
+    LightComponent& light() const { return registry->get<LightComponent>(id); }
 
     void drawUI() override {
         Entity::drawUI();  // Herda a UI básica de Entity (nome, transformações)
-        
+
+        LightComponent& l = light();
+
         ImGui::Separator();
         ImGui::Text("Light Properties");
-        
+
         // Checkbox para ativar/desativar
-        ImGui::Checkbox("Enabled", &enabled);
-        
+        ImGui::Checkbox("Light Enabled", &l.enabled);
+
         // Tipo de luz
         const char* types[] = { "Point", "Directional", "Spot", "Area" };
-        ImGui::Combo("Type", (int*)&type, types, 4);
-        
+        ImGui::Combo("Type", (int*)&l.type, types, 4);
+
         // Propriedades básicas
-        ImGui::ColorEdit3("Color", &color.x);
-        ImGui::DragFloat("Intensity", &intensity, 0.1f, 0.0f, 100.0f);
-        
+        ImGui::ColorEdit3("Color", &l.color.x);
+        ImGui::DragFloat("Intensity", &l.intensity, 0.1f, 0.0f, 100.0f);
+
         // Propriedades específicas por tipo
-        if (type != Type::DIRECTIONAL) {
-            ImGui::DragFloat("Range", &range, 0.1f, 0.1f, 1000.0f);
+        if (l.type != Type::DIRECTIONAL) {
+            ImGui::DragFloat("Range", &l.range, 0.1f, 0.1f, 1000.0f);
         }
-        
-        if (type == Type::SPOT) {
-            ImGui::DragFloat("Inner Angle", &innerAngle, 0.5f, 0.0f, outerAngle);
-            ImGui::DragFloat("Outer Angle", &outerAngle, 0.5f, innerAngle, 90.0f);
-        }
-    }
 
-    void setupInShader(Shader& shader, int index = 0) const {
-        std::string prefix = "lights[" + std::to_string(index) + "].";
-        
-        shader.setInt(prefix + "type", (int)type);
-        shader.setVec3(prefix + "position", position);
-        shader.setVec3(prefix + "direction", getForwardDirection());
-        shader.setVec3(prefix + "color", color);
-        shader.setFloat(prefix + "intensity", intensity);
-        shader.setFloat(prefix + "range", range);
-        shader.setFloat(prefix + "innerAngle", cos(alg::degrees_to_radians(innerAngle)));
-        shader.setFloat(prefix + "outerAngle", cos(alg::degrees_to_radians(outerAngle)));
-        shader.setBool(prefix + "enabled", enabled);
-    }
-
-private:
-    alg::Vec3 getForwardDirection() const {
-        // Calcula a direção forward baseada na rotação
-        float pitch = rotation.x;
-        float yaw = rotation.y;
-        
-        return alg::Vec3(
-            cos(yaw) * cos(pitch),
-            sin(pitch),
-            sin(yaw) * cos(pitch)
-        ).normalized();
+        if (l.type == Type::SPOT) {
+            ImGui::DragFloat("Inner Angle", &l.innerAngle, 0.5f, 0.0f, l.outerAngle);
+            ImGui::DragFloat("Outer Angle", &l.outerAngle, 0.5f, l.innerAngle, 90.0f);
+        }
     }
-};
\ No newline at end of file
+};
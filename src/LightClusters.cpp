@@ -0,0 +1,164 @@
+#include "LightClusters.hpp"
+#include "FrameUniforms.hpp"
+#include "JobSystem.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // Luzes por pedaço no cálculo dos limites
+    constexpr std::size_t LIGHT_GRAIN = 256;
+
+    std::uint8_t tileOf(float ndc, std::uint32_t tiles) {
+        const float t = std::floor((ndc * 0.5f + 0.5f) * static_cast<float>(tiles));
+        return static_cast<std::uint8_t>(std::clamp(t, 0.0f, static_cast<float>(tiles - 1)));
+    }
+
+    template <class Fn>
+    void forRange(std::size_t count, std::size_t grain, JobSystem* jobs, Fn&& fn) {
+        if (jobs) {
+            jobs->parallelFor(0, count, grain, fn);
+        } else {
+            fn(0, count);
+        }
+    }
+}
+
+std::uint32_t LightClusters::sliceOf(float depth) const {
+    const float slice = std::floor(std::log(depth) * depthScale + depthBias);
+    return static_cast<std::uint32_t>(std::clamp(slice, 0.0f, static_cast<float>(GRID_Z - 1)));
+}
+
+void LightClusters::build(const std::vector<FrameLight>& lights, const Params& params, JobSystem* jobs) {
+    nearPlane = params.nearPlane;
+    farPlane = params.farPlane;
+    const float logRatio = std::log(farPlane / nearPlane);
+    depthScale = static_cast<float>(GRID_Z) / logRatio;
+    depthBias = -static_cast<float>(GRID_Z) * std::log(nearPlane) / logRatio;
+    tileWidth = static_cast<float>(std::max(params.viewportWidth, 1)) / static_cast<float>(GRID_X);
+    tileHeight = static_cast<float>(std::max(params.viewportHeight, 1)) / static_cast<float>(GRID_Y);
+
+    const std::size_t lightCount = std::min<std::size_t>(lights.size(), MAX_LIGHTS);
+    lightTexels.resize(lightCount * 4);
+    bounds.resize(lightCount);
+
+    // 1. Dados para a GPU e clusters tocados por cada luz
+    const float* v = params.view.m;
+    const float scaleX = params.projection.m[0];
+    const float scaleY = params.projection.m[5];
+    forRange(lightCount, LIGHT_GRAIN, jobs, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+            const FrameLight& light = lights[i];
+            const LightBlockEntry entry = packLight(light);
+            lightTexels[i * 4 + 0] = entry.positionRange;
+            lightTexels[i * 4 + 1] = entry.directionType;
+            lightTexels[i * 4 + 2] = entry.colorIntensity;
+            lightTexels[i * 4 + 3] = entry.cone;
+
+            LightBounds& b = bounds[i];
+            b = LightBounds{0, GRID_X - 1, 0, GRID_Y - 1, 0, GRID_Z - 1, light.enabled};
+            if (!light.enabled || light.type == LightType::DIRECTIONAL) {
+                continue; // Direcional: todos os clusters
+            }
+
+            // Centro em view-space; a câmera olha para -z
+            const alg::Vec3& p = light.position;
+            const float cx = v[0] * p.x + v[4] * p.y + v[8] * p.z + v[12];
+            const float cy = v[1] * p.x + v[5] * p.y + v[9] * p.z + v[13];
+            const float depth = -(v[2] * p.x + v[6] * p.y + v[10] * p.z + v[14]);
+            const float r = light.range;
+            if (depth + r < nearPlane || depth - r > farPlane) {
+                b.visible = false;
+                continue;
+            }
+            const float d0 = std::max(depth - r, nearPlane);
+            const float d1 = std::min(depth + r, farPlane);
+            b.z0 = static_cast<std::uint8_t>(sliceOf(d0));
+            b.z1 = static_cast<std::uint8_t>(sliceOf(d1));
+
+            // Caixa da esfera projetada: para x fixo, x/d é monótono em d,
+            // então os extremos estão nos cantos (x0|x1, d0|d1)
+            const float xs[4] = {(cx - r) / d0, (cx - r) / d1, (cx + r) / d0, (cx + r) / d1};
+            const float ys[4] = {(cy - r) / d0, (cy - r) / d1, (cy + r) / d0, (cy + r) / d1};
+            const float minX = scaleX * *std::min_element(xs, xs + 4);
+            const float maxX = scaleX * *std::max_element(xs, xs + 4);
+            const float minY = scaleY * *std::min_element(ys, ys + 4);
+            const float maxY = scaleY * *std::max_element(ys, ys + 4);
+            if (maxX < -1.0f || minX > 1.0f || maxY < -1.0f || minY > 1.0f) {
+                b.visible = false;
+                continue;
+            }
+            b.x0 = tileOf(minX, GRID_X);
+            b.x1 = tileOf(maxX, GRID_X);
+            b.y0 = tileOf(minY, GRID_Y);
+            b.y1 = tileOf(maxY, GRID_Y);
+        }
+    });
+
+    if (!params.assignClusters) {
+        ranges.clear();
+        indices.clear();
+        return;
+    }
+
+    // 2. Por fatia Z (cada job é dono dos clusters da sua fatia): quantas
+    //    luzes cada cluster recebe, limitado a MAX_LIGHTS_PER_CLUSTER
+    ranges.assign(std::size_t(CLUSTER_COUNT) * 2, 0u);
+    sliceTotals.assign(GRID_Z, 0u);
+    const auto eachClusterOfLight = [&](std::uint32_t z, const LightBounds& b, auto&& fn) {
+        for (std::uint32_t y = b.y0; y <= b.y1; ++y) {
+            const std::uint32_t row = (z * GRID_Y + y) * GRID_X;
+            for (std::uint32_t x = b.x0; x <= b.x1; ++x) {
+                fn(row + x);
+            }
+        }
+    };
+    forRange(GRID_Z, 1, jobs, [&](std::size_t first, std::size_t last) {
+        for (std::uint32_t z = static_cast<std::uint32_t>(first); z < last; ++z) {
+            for (const LightBounds& b : bounds) {
+                if (!b.visible || z < b.z0 || z > b.z1) continue;
+                eachClusterOfLight(z, b, [&](std::uint32_t cluster) {
+                    std::uint32_t& count = ranges[cluster * 2 + 1];
+                    count += count < MAX_LIGHTS_PER_CLUSTER;
+                });
+            }
+            std::uint32_t total = 0;
+            for (std::uint32_t c = z * GRID_X * GRID_Y, end = c + GRID_X * GRID_Y; c < end; ++c) {
+                total += ranges[c * 2 + 1];
+            }
+            sliceTotals[z] = total;
+        }
+    });
+
+    // 3. Início de cada fatia na lista de índices
+    std::uint32_t indexCount = 0;
+    for (std::uint32_t& total : sliceTotals) {
+        const std::uint32_t sliceCount = total;
+        total = indexCount;
+        indexCount += sliceCount;
+    }
+    indices.resize(indexCount);
+
+    // 4. Por fatia de novo: início de cada cluster e os índices, na ordem das luzes
+    forRange(GRID_Z, 1, jobs, [&](std::size_t first, std::size_t last) {
+        for (std::uint32_t z = static_cast<std::uint32_t>(first); z < last; ++z) {
+            std::uint32_t offset = sliceTotals[z];
+            for (std::uint32_t c = z * GRID_X * GRID_Y, end = c + GRID_X * GRID_Y; c < end; ++c) {
+                ranges[c * 2] = offset;
+                offset += ranges[c * 2 + 1];
+                ranges[c * 2 + 1] = 0; // Vira o cursor de escrita
+            }
+            for (std::uint32_t light = 0; light < bounds.size(); ++light) {
+                const LightBounds& b = bounds[light];
+                if (!b.visible || z < b.z0 || z > b.z1) continue;
+                eachClusterOfLight(z, b, [&](std::uint32_t cluster) {
+                    // Mesma ordem e mesmo limite da contagem: termina igual a ela
+                    std::uint32_t& count = ranges[cluster * 2 + 1];
+                    if (count < MAX_LIGHTS_PER_CLUSTER) {
+                        indices[ranges[cluster * 2] + count++] = light;
+                    }
+                });
+            }
+        }
+    });
+}
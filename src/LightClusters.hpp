@@ -0,0 +1,90 @@
+#ifndef LIGHTCLUSTERS_HPP
+#define LIGHTCLUSTERS_HPP
+
+#include <cstdint>
+#include <vector>
+#include "algebra.hpp"
+
+class JobSystem;
+struct FrameLight;
+
+// Atribuição de luzes a clusters para o forward clusterizado.
+//
+// O frustum da câmera é dividido em GRID_X x GRID_Y tiles de tela e
+// GRID_Z fatias de profundidade (exponenciais entre near e far, então as
+// fatias perto da câmera são finas). Cada luz point/spot entra nos
+// clusters que a caixa da esfera de alcance dela toca (conservador: a
+// esfera do spot inteira, sem o cone); luzes direcionais entram em todos.
+// O fragment shader acha o seu cluster por gl_FragCoord e pela
+// profundidade e só percorre a lista de índices daquele cluster.
+//
+// Saída, em texture buffers no Renderer:
+//   lightTexels: 4 texels por luz (o layout de LightBlockEntry)
+//   ranges:      2 uints por cluster (início e quantidade em indices)
+//   indices:     índices de luz, cluster após cluster
+class LightClusters {
+public:
+    static constexpr std::uint32_t GRID_X = 16;
+    static constexpr std::uint32_t GRID_Y = 9;
+    static constexpr std::uint32_t GRID_Z = 24;
+    static constexpr std::uint32_t CLUSTER_COUNT = GRID_X * GRID_Y * GRID_Z;
+    // Luzes consideradas por frame (as seguintes ficam de fora)
+    static constexpr std::uint32_t MAX_LIGHTS = 4096;
+    // Limite de luzes por cluster, o que limita o custo por fragmento
+    static constexpr std::uint32_t MAX_LIGHTS_PER_CLUSTER = 128;
+
+    struct Params {
+        alg::Mat4 view;
+        alg::Mat4 projection; // Perspectiva; só m[0] e m[5] são usados
+        float nearPlane = 0.1f;
+        float farPlane = 100.0f;
+        int viewportWidth = 1;
+        int viewportHeight = 1;
+        // false: só os dados das luzes, sem ranges/indices (a seleção por
+        // draw do LightSelection indexa os mesmos texels)
+        bool assignClusters = true;
+    };
+
+    // Bina as luzes. Com jobs, os limites de cada luz e cada fatia Z em paralelo.
+    void build(const std::vector<FrameLight>& lights, const Params& params, JobSystem* jobs = nullptr);
+
+    // Fatia = floor(log(profundidade) * depthScale + depthBias)
+    float getDepthScale() const { return depthScale; }
+    float getDepthBias() const { return depthBias; }
+    float getTileWidth() const { return tileWidth; }   // Em pixels
+    float getTileHeight() const { return tileHeight; }
+    float getNearPlane() const { return nearPlane; }
+    float getFarPlane() const { return farPlane; }
+
+    const std::vector<alg::Vec4>& getLightTexels() const { return lightTexels; }
+    const std::vector<std::uint32_t>& getRanges() const { return ranges; }
+    const std::vector<std::uint32_t>& getIndices() const { return indices; }
+    std::uint32_t getLightCount() const { return static_cast<std::uint32_t>(lightTexels.size() / 4); }
+
+private:
+    // Clusters tocados por uma luz (intervalos fechados); visible = false
+    // se está desligada ou fora do frustum
+    struct LightBounds {
+        std::uint8_t x0, x1, y0, y1, z0, z1;
+        bool visible;
+    };
+
+    std::uint32_t sliceOf(float depth) const;
+
+    float depthScale = 0.0f;
+    float depthBias = 0.0f;
+    float tileWidth = 1.0f;
+    float tileHeight = 1.0f;
+    float nearPlane = 0.1f;
+    float farPlane = 100.0f;
+
+    std::vector<alg::Vec4> lightTexels;
+    std::vector<std::uint32_t> ranges;
+    std::vector<std::uint32_t> indices;
+
+    // Memória de trabalho, reaproveitada entre frames
+    std::vector<LightBounds> bounds;
+    std::vector<std::uint32_t> sliceTotals; // Índices por fatia Z, depois o início de cada fatia
+};
+
+#endif // LIGHTCLUSTERS_HPP
@@ -0,0 +1,92 @@
+#include "LightSelection.hpp"
+#include "FrameData.hpp"
+#include "JobSystem.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+    // Draws por pedaço na escolha
+    constexpr std::size_t DRAW_GRAIN = 256;
+    // Distância mínima na nota: luzes dentro da caixa empatam pela intensidade * alcance
+    constexpr float MIN_DISTANCE = 0.01f;
+
+    // As LIGHTS_PER_DRAW maiores notas vistas, em ordem decrescente
+    struct BestLights {
+        float score[LIGHTS_PER_DRAW];
+        std::uint32_t light[LIGHTS_PER_DRAW];
+
+        BestLights() {
+            std::fill(score, score + LIGHTS_PER_DRAW, -1.0f);
+            std::fill(light, light + LIGHTS_PER_DRAW, NO_LIGHT);
+        }
+
+        void offer(std::uint32_t index, float value) {
+            if (value <= score[LIGHTS_PER_DRAW - 1]) return;
+            std::uint32_t slot = LIGHTS_PER_DRAW - 1;
+            while (slot > 0 && score[slot - 1] < value) {
+                score[slot] = score[slot - 1];
+                light[slot] = light[slot - 1];
+                --slot;
+            }
+            score[slot] = value;
+            light[slot] = index;
+        }
+    };
+}
+
+void LightSelection::select(const std::vector<FrameLight>& lights, const alg::Frustum& frustum,
+                            std::vector<DrawItem>& draws, JobSystem* jobs) {
+    // 1. Candidatas: ligadas, no texture buffer de luzes e, se têm posição,
+    //    com a esfera de alcance tocando o frustum
+    directional.clear();
+    positional.clear();
+    boxes.clear();
+    const std::size_t lightCount = std::min<std::size_t>(lights.size(), LightClusters::MAX_LIGHTS);
+    for (std::uint32_t i = 0; i < lightCount; ++i) {
+        const FrameLight& light = lights[i];
+        if (!light.enabled || light.intensity <= 0.0f) continue;
+        if (light.type == LightType::DIRECTIONAL) {
+            directional.push_back(i);
+            continue;
+        }
+        if (!alg::intersects(frustum, alg::Sphere(light.position, light.range))) continue;
+        positional.push_back(i);
+        boxes.push_back(alg::AABB::from_center_extents(light.position, alg::Vec3(light.range, light.range, light.range)));
+    }
+    std::stable_sort(directional.begin(), directional.end(), [&](std::uint32_t a, std::uint32_t b) {
+        return lights[a].intensity > lights[b].intensity;
+    });
+    bvh.build(boxes);
+
+    // 2. Por draw: as luzes que alcançam a caixa, pela nota
+    const auto choose = [&](std::size_t first, std::size_t last) {
+        for (std::size_t k = first; k < last; ++k) {
+            DrawItem& draw = draws[k];
+            BestLights best;
+            // Direcionais antes de qualquer point/spot, na ordem da lista
+            float directionalScore = std::numeric_limits<float>::max();
+            for (const std::uint32_t index : directional) {
+                best.offer(index, directionalScore);
+                directionalScore = std::nextafter(directionalScore, 0.0f);
+            }
+            if (!draw.bounds.is_empty()) {
+                bvh.query_sphere(alg::Sphere::from_aabb(draw.bounds), [&](std::uint32_t item) {
+                    const std::uint32_t index = positional[item];
+                    const FrameLight& light = lights[index];
+                    const float distanceSquared = alg::distance_squared(draw.bounds, light.position);
+                    if (distanceSquared >= light.range * light.range) return;
+                    const float distance = std::max(std::sqrt(distanceSquared), MIN_DISTANCE);
+                    best.offer(index, light.intensity * light.range / distance);
+                });
+            }
+            std::copy(best.light, best.light + LIGHTS_PER_DRAW, draw.lights);
+        }
+    };
+    if (jobs) {
+        jobs->parallelFor(0, draws.size(), DRAW_GRAIN, choose);
+    } else {
+        choose(0, draws.size());
+    }
+}
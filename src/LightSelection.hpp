@@ -0,0 +1,42 @@
+#ifndef LIGHTSELECTION_HPP
+#define LIGHTSELECTION_HPP
+
+#include <cstdint>
+#include <vector>
+#include "geometry.hpp"
+#include "bvh.hpp"
+
+class JobSystem;
+struct DrawItem;
+struct FrameLight;
+
+// Escolha das luzes de cada draw para o forward sem clusters.
+//
+// As luzes point/spot cuja esfera de alcance não toca o frustum saem
+// antes de tudo (não iluminam nada visível). Para cada draw, as que
+// alcançam a caixa de mundo dele recebem a nota
+//     intensidade * alcance / distância até a caixa
+// e as LIGHTS_PER_DRAW melhores vão para DrawItem::lights. Direcionais
+// alcançam tudo e vêm na frente, da mais intensa para a menos.
+//
+// Os índices são posições em FrameData::lights, que são também as luzes
+// do texture buffer do LightClusters (só as primeiras MAX_LIGHTS contam).
+class LightSelection {
+public:
+    // Com jobs, os draws em paralelo
+    void select(const std::vector<FrameLight>& lights, const alg::Frustum& frustum,
+                std::vector<DrawItem>& draws, JobSystem* jobs = nullptr);
+
+    // Luzes que passaram no frustum na última seleção (direcionais incluídas)
+    std::uint32_t getCandidateCount() const {
+        return static_cast<std::uint32_t>(directional.size() + positional.size());
+    }
+
+private:
+    std::vector<std::uint32_t> directional; // Índices das direcionais, por intensidade
+    std::vector<std::uint32_t> positional;  // Item da BVH -> índice da luz
+    std::vector<alg::AABB> boxes;           // Caixa da esfera de alcance, por item
+    alg::Bvh bvh;
+};
+
+#endif // LIGHTSELECTION_HPP
@@ -1,6 +1,8 @@
 #pragma once
 #include "algebra.hpp"
+#include "Shader.hpp"
 #include "Texture.hpp"
+#include <cstdint>
 #include <memory>
 
 class Material {
@@ -9,8 +11,15 @@ public:
     alg::Vec3 diffuse;
     alg::Vec3 specular;
     float shininess;
+    // Desenhado depois dos opacos, de trás para frente, com blending (alfa da textura)
+    bool transparent = false;
     std::shared_ptr<Texture> diffuseTexture;
     std::shared_ptr<Texture> specularTexture;
+    // Muda a cada edição das cores/shininess; a Scene reenvia ao buffer de
+    // materiais só os que mudaram. Quem altera os campos por código chama markDirty().
+    std::uint32_t version = 1;
+
+    void markDirty() { ++version; }
 
     // Construtores
     Material() :
@@ -33,31 +42,32 @@ public:
     void setDiffuseTexture(std::shared_ptr<Texture> tex) { diffuseTexture = tex; }
     void setSpecularTexture(std::shared_ptr<Texture> tex) { specularTexture = tex; }
 
-    // Método para configurar o material no shader
-    void setupInShader(Shader& shader) const {
-        shader.setVec3("material.ambient", ambient);
-        shader.setVec3("material.diffuse", diffuse);
-        shader.setVec3("material.specular", specular);
-        shader.setFloat("material.shininess", shininess);
-
+    // Liga as texturas do material (as cores vêm do buffer de materiais);
+    // os handles são os samplers material.diffuse e material.specular
+    void setupInShader(const Shader& shader, UniformHandle diffuseSampler, UniformHandle specularSampler) const {
         // Configura texturas se existirem
         if (diffuseTexture) {
             diffuseTexture->bind(0); // Usa texture unit 0
-            shader.setInt("material.diffuseTexture", 0);
+            shader.setInt(diffuseSampler, 0);
         }
         
         if (specularTexture) {
             specularTexture->bind(1); // Usa texture unit 1
-            shader.setInt("material.specularTexture", 1);
+            shader.setInt(specularSampler, 1);
         }
     }
 
     // Método para UI no ImGui
     void drawUI() {
         ImGui::Text("Material Properties");
-        ImGui::ColorEdit3("Ambient", &ambient.x);
-        ImGui::ColorEdit3("Diffuse", &diffuse.x);
-        ImGui::ColorEdit3("Specular", &specular.x);
-        ImGui::DragFloat("Shininess", &shininess, 1.0f, 1.0f, 256.0f);
+        bool changed = false;
+        changed |= ImGui::ColorEdit3("Ambient", &ambient.x);
+        changed |= ImGui::ColorEdit3("Diffuse", &diffuse.x);
+        changed |= ImGui::ColorEdit3("Specular", &specular.x);
+        changed |= ImGui::DragFloat("Shininess", &shininess, 1.0f, 1.0f, 256.0f);
+        if (changed) {
+            markDirty();
+        }
+        ImGui::Checkbox("Transparent", &transparent);
     }
 };
\ No newline at end of file
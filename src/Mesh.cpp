@@ -1,15 +1,33 @@
 #include "Mesh.hpp"
 #include <glad/glad.h>
+#include <atomic>
+
+namespace {
+    std::atomic<std::uint64_t> nextMeshUid{1};
+}
 
 Mesh::Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices) {
     this->vertices = vertices;
     this->indices = indices;
+    uid = nextMeshUid.fetch_add(1, std::memory_order_relaxed);
 
     // Agora que temos os dados, configuramos os buffers da GPU
     setupMesh();
 }
 
 void Mesh::setupMesh() {
+    // 0. Bounds locais (usados no culling; a entidade só os transforma quando muda)
+    //    e a BVH de triângulos do picking, montada aqui para o primeiro clique
+    //    não pagar a construção
+    bounds = alg::AABB();
+    std::vector<alg::Vec3> positions;
+    positions.reserve(vertices.size());
+    for (const Vertex& vertex : vertices) {
+        bounds.expand(vertex.Position);
+        positions.push_back(vertex.Position);
+    }
+    triangleBvh.build(positions, indices);
+
     // 1. Gerar os buffers
     glGenVertexArrays(1, &VAO);
     glGenBuffers(1, &VBO);
@@ -39,6 +57,15 @@ void Mesh::setupMesh() {
     glBindVertexArray(0);
 }
 
+bool Mesh::raycast(const alg::Ray& ray, float& tHit) const {
+    const alg::Bvh::RayHit hit = triangleBvh.raycast(ray);
+    if (hit.item == alg::Bvh::NONE) {
+        return false;
+    }
+    tHit = hit.t;
+    return true;
+}
+
 void Mesh::draw(Shader &shader) {
     // Desenha a malha
     glBindVertexArray(VAO);
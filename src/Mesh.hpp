@@ -1,9 +1,11 @@
 #ifndef MESH_HPP
 #define MESH_HPP
 
+#include <cstdint>
 #include <vector>
 #include <functional> // Necessário para std::hash
 #include "algebra.hpp"
+#include "bvh.hpp"
 #include "Shader.hpp"
 
 // Usaremos esta struct para passar os dados de cada vértice de forma organizada
@@ -66,9 +68,25 @@ public:
     // Renderiza a malha
     void draw(Shader &shader);
 
+    // Para quem faz o próprio bind (Renderer): o VAO já tem o EBO
+    unsigned int getVAO() const { return VAO; }
+    unsigned int getIndexCount() const { return static_cast<unsigned int>(indices.size()); }
+    // Único por mesh criado (ao contrário do endereço, nunca é reaproveitado)
+    std::uint64_t getUid() const { return uid; }
+
+    // Caixa envolvente no espaço do modelo (calculada uma vez, no upload)
+    const alg::AABB& getBounds() const { return bounds; }
+
+    // Raio em espaço do modelo contra os triângulos (na CPU), pela BVH de
+    // triângulos montada no upload; tHit recebe a distância.
+    bool raycast(const alg::Ray& ray, float& tHit) const;
+
 private:
     // IDs dos buffers da GPU
     unsigned int VAO, VBO, EBO;
+    std::uint64_t uid;
+    alg::AABB bounds;
+    alg::TriangleBvh triangleBvh;
 
     // Função de inicialização que cria os buffers
     void setupMesh();
@@ -0,0 +1,105 @@
+#include "MeshPool.hpp"
+
+#include <glad/glad.h>
+#include <algorithm>
+#include <cstddef>
+
+#include "Mesh.hpp"
+
+namespace {
+    constexpr std::uint32_t MIN_VERTEX_CAPACITY = 1u << 16;
+    constexpr std::uint32_t MIN_INDEX_CAPACITY = 1u << 18;
+
+    // Buffer novo com a capacidade pedida e os primeiros usedBytes do antigo.
+    // Usa os alvos de cópia para não mexer no GL_ELEMENT_ARRAY_BUFFER (que é
+    // estado do VAO ligado) nem no GL_ARRAY_BUFFER de quem chamou.
+    unsigned int growBuffer(unsigned int oldBuffer, std::size_t usedBytes, std::size_t capacityBytes) {
+        unsigned int buffer = 0;
+        glGenBuffers(1, &buffer);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(capacityBytes), nullptr, GL_STATIC_DRAW);
+        if (oldBuffer) {
+            if (usedBytes > 0) {
+                glBindBuffer(GL_COPY_READ_BUFFER, oldBuffer);
+                glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, static_cast<GLsizeiptr>(usedBytes));
+                glBindBuffer(GL_COPY_READ_BUFFER, 0);
+            }
+            glDeleteBuffers(1, &oldBuffer);
+        }
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        return buffer;
+    }
+}
+
+MeshPool::~MeshPool() {
+    if (VAO) {
+        glDeleteVertexArrays(1, &VAO);
+        glDeleteBuffers(1, &VBO);
+        glDeleteBuffers(1, &EBO);
+    }
+}
+
+const MeshPool::Range& MeshPool::acquire(const Mesh& mesh) {
+    const auto found = ranges.find(mesh.getUid());
+    if (found != ranges.end()) {
+        return found->second;
+    }
+
+    const auto meshVertices = static_cast<std::uint32_t>(mesh.vertices.size());
+    const auto meshIndices = static_cast<std::uint32_t>(mesh.indices.size());
+    reserve(vertexCount + meshVertices, indexCount + meshIndices);
+
+    // Índices continuam locais ao mesh: o baseVertex do comando os desloca
+    glBindBuffer(GL_COPY_WRITE_BUFFER, VBO);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(std::size_t(vertexCount) * sizeof(Vertex)),
+                    static_cast<GLsizeiptr>(std::size_t(meshVertices) * sizeof(Vertex)), mesh.vertices.data());
+    glBindBuffer(GL_COPY_WRITE_BUFFER, EBO);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(std::size_t(indexCount) * sizeof(unsigned int)),
+                    static_cast<GLsizeiptr>(std::size_t(meshIndices) * sizeof(unsigned int)), mesh.indices.data());
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    Range range;
+    range.firstIndex = indexCount;
+    range.indexCount = meshIndices;
+    range.baseVertex = static_cast<std::int32_t>(vertexCount);
+    vertexCount += meshVertices;
+    indexCount += meshIndices;
+    return ranges.emplace(mesh.getUid(), range).first->second;
+}
+
+void MeshPool::reserve(std::uint32_t vertices, std::uint32_t indices) {
+    bool changed = false;
+    if (vertices > vertexCapacity) {
+        vertexCapacity = std::max({vertices, vertexCapacity * 2, MIN_VERTEX_CAPACITY});
+        VBO = growBuffer(VBO, std::size_t(vertexCount) * sizeof(Vertex), std::size_t(vertexCapacity) * sizeof(Vertex));
+        changed = true;
+    }
+    if (indices > indexCapacity) {
+        indexCapacity = std::max({indices, indexCapacity * 2, MIN_INDEX_CAPACITY});
+        EBO = growBuffer(EBO, std::size_t(indexCount) * sizeof(unsigned int), std::size_t(indexCapacity) * sizeof(unsigned int));
+        changed = true;
+    }
+    if (changed) {
+        setupVertexArray();
+    }
+}
+
+void MeshPool::setupVertexArray() {
+    if (!VAO) {
+        glGenVertexArrays(1, &VAO);
+    }
+    glBindVertexArray(VAO);
+
+    // Mesmo layout de Mesh::setupMesh
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Position));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Normal));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, TexCoords));
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
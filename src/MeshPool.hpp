@@ -0,0 +1,51 @@
+#ifndef MESHPOOL_HPP
+#define MESHPOOL_HPP
+
+#include <cstdint>
+#include <unordered_map>
+
+class Mesh;
+
+// Vértices e índices de todos os meshes num único VBO/EBO, com um VAO só,
+// para o caminho de multi-draw indirect do Renderer (um comando por mesh
+// aponta para a faixa dele). Cada mesh é copiado na primeira vez que é
+// pedido; os buffers dobram de tamanho quando enchem. Faixas de meshes
+// destruídos não são reaproveitadas (os meshes vêm do cache do
+// ResourceManager e em geral vivem o programa inteiro).
+//
+// Só na thread do contexto GL.
+class MeshPool {
+public:
+    struct Range {
+        std::uint32_t firstIndex = 0;
+        std::uint32_t indexCount = 0;
+        std::int32_t baseVertex = 0;
+    };
+
+    MeshPool() = default;
+    ~MeshPool();
+
+    MeshPool(const MeshPool&) = delete;
+    MeshPool& operator=(const MeshPool&) = delete;
+
+    // Faixa do mesh nos buffers compartilhados (copia na primeira vez).
+    // Pode trocar os buffers: ligar o VAO depois de todas as chamadas.
+    const Range& acquire(const Mesh& mesh);
+
+    // Atributos 0-2 como os de Mesh, sobre os buffers compartilhados
+    unsigned int getVAO() const { return VAO; }
+
+    std::uint32_t getVertexCount() const { return vertexCount; }
+    std::uint32_t getIndexCount() const { return indexCount; }
+
+private:
+    void reserve(std::uint32_t vertices, std::uint32_t indices);
+    void setupVertexArray();
+
+    unsigned int VAO = 0, VBO = 0, EBO = 0;
+    std::uint32_t vertexCount = 0, vertexCapacity = 0;
+    std::uint32_t indexCount = 0, indexCapacity = 0;
+    std::unordered_map<std::uint64_t, Range> ranges; // Por Mesh::getUid()
+};
+
+#endif // MESHPOOL_HPP
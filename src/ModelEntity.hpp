@@ -5,42 +5,63 @@
 #include "Shader.hpp"
 #include "algebra.hpp"
 
-class ModelEntity : public Entity {
-public:
+// O que é preciso para desenhar uma entidade (o Material é um componente à parte)
+struct MeshRendererComponent {
     std::shared_ptr<Mesh> mesh;
-    Material material;
     std::shared_ptr<Shader> shader;
+};
+
+// Caixa envolvente em espaço de mundo de um renderizável, atualizada pela
+// Scene só quando a matriz de mundo muda. O componente é o próprio alg::AABB
+// para o pool ser um array denso de caixas, consumido direto por
+// alg::batch::cull_aabbs.
+using WorldBoundsComponent = alg::AABB;
 
-    ModelEntity(std::shared_ptr<Mesh> mesh,
+// Fachada para entidades renderizáveis: MeshRendererComponent + Material
+class ModelEntity : public Entity {
+public:
+    ModelEntity(Registry& registry,
+               std::shared_ptr<Mesh> mesh,
                std::shared_ptr<Texture> diffuseTexture,
                std::shared_ptr<Shader> shader,
                alg::Vec3 position = alg::Vec3(0.0f,0.0f,0.0f),
                alg::Vec3 rotation = alg::Vec3(0.0f,0.0f,0.0f),
                alg::Vec3 scale = alg::Vec3(1.0f,1.0f,1.0f))
-       : Entity("ModelEntity"), mesh(mesh), shader(shader) {
+       : Entity(registry, "ModelEntity") {
+        registry.emplace<MeshRendererComponent>(id, MeshRendererComponent{mesh, shader});
+        registry.emplace<Material>(id);
+        registry.emplace<WorldBoundsComponent>(id, mesh->getBounds());
         setPosition(position);
         setRotation(rotation);
         setScale(scale);
-        material.setDiffuseTexture(diffuseTexture);
+        material().setDiffuseTexture(diffuseTexture);
     }
 
+    MeshRendererComponent& renderer() const { return registry->get<MeshRendererComponent>(id); }
+    Material& material() const { return registry->get<Material>(id); }
+    const WorldBoundsComponent& worldBounds() const { return registry->get<WorldBoundsComponent>(id); }
 
+    // Renderiza o modelo (câmera e luzes vêm dos uniform blocks que o
+    // Renderer ligou para o frame)
+    void render() {
+        Shader& shader = *renderer().shader;
+        shader.use();
+        if (uniformsProgram != shader.ID) {
+            resolveUniforms(shader);
+        }
+
+        // Configura transformações (uniforms, sem os atributos por instância)
+        shader.setBool(uniforms.instanced, false);
+        shader.setMat4(uniforms.model, getTransformMatrix());
+        shader.setMat4(uniforms.normalMatrix, getNormalMatrix());
+
+        // Configura material: cores pelo índice no buffer de materiais
+        // (o pool de Material, veja Scene::collectMaterialUpdates)
+        shader.setInt(uniforms.materialIndex, static_cast<int>(registry->pool<Material>().indexOf(id)));
+        material().setupInShader(shader, uniforms.materialDiffuse, uniforms.materialSpecular);
 
-    // Renderiza o modelo
-    void render(const alg::Mat4& view, const alg::Mat4& projection, const alg::Vec3& viewPos) {
-        shader->use();
-        
-        // Configura transformações
-        shader->setMat4("model", getTransformMatrix());
-        shader->setMat4("view", view);
-        shader->setMat4("projection", projection);
-        shader->setVec3("viewPos", viewPos);
-        
-        // Configura material
-        material.setupInShader(*shader);
-        
         // Renderiza o mesh
-        mesh->draw(*shader);
+        renderer().mesh->draw(shader);
     }
 
     // Interface de usuário
@@ -48,19 +69,42 @@ public:
         Entity::drawUI();
 
 
-        
+
         ImGui::Separator();
-        material.drawUI();
+        material().drawUI();
     }
 
     // Atualiza a textura difusa
     void setDiffuseTexture(std::shared_ptr<Texture> tex) {
-        material.setDiffuseTexture(tex);
+        material().setDiffuseTexture(tex);
     }
 
     // Atualiza a textura especular
     void setSpecularTexture(std::shared_ptr<Texture> tex) {
-        material.setSpecularTexture(tex);
+        material().setSpecularTexture(tex);
     }
 
-};
\ No newline at end of file
+private:
+    // Handles dos uniforms de render(), do programa uniformsProgram
+    struct Uniforms {
+        UniformHandle instanced;
+        UniformHandle model;
+        UniformHandle normalMatrix;
+        UniformHandle materialIndex;
+        UniformHandle materialDiffuse;
+        UniformHandle materialSpecular;
+    };
+    Uniforms uniforms;
+    unsigned int uniformsProgram = 0;
+
+    // Uma busca por nome quando o shader do renderer muda, não a cada render()
+    void resolveUniforms(const Shader& shader) {
+        uniforms.instanced = shader.uniform("instanced");
+        uniforms.model = shader.uniform("model");
+        uniforms.normalMatrix = shader.uniform("normalMatrix");
+        uniforms.materialIndex = shader.uniform("materialIndex");
+        uniforms.materialDiffuse = shader.uniform("material.diffuse");
+        uniforms.materialSpecular = shader.uniform("material.specular");
+        uniformsProgram = shader.ID;
+    }
+};
@@ -0,0 +1,281 @@
+#ifndef REGISTRY_HPP
+#define REGISTRY_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// Armazenamento de componentes em sparse sets (estilo ECS).
+//
+// Cada tipo de componente tem um pool com três vetores:
+//   sparse[idx]   -> posição do componente em dense/data (ou INVALID),
+//                    indexado pelo índice do slot da entidade
+//   dense[i]      -> id da entidade dona de data[i]
+//   data[i]       -> o componente
+// Os componentes de um tipo ficam contíguos, então iterar todos os
+// transforms ou todos os renderizáveis é uma varredura linear, sem
+// ponteiros nem RTTI. Remoção é swap-and-pop (O(1), não preserva ordem).
+
+// Handle geracional: índice do slot nos 32 bits baixos e geração nos 32
+// altos. Destruir uma entidade incrementa a geração do slot, então handles
+// antigos para um slot reutilizado deixam de ser válidos em vez de
+// apontarem para outra entidade.
+using EntityId = std::uint64_t;
+inline constexpr EntityId NULL_ENTITY = std::numeric_limits<EntityId>::max();
+
+inline constexpr std::uint32_t entityIndex(EntityId id) {
+    return static_cast<std::uint32_t>(id);
+}
+
+inline constexpr std::uint32_t entityGeneration(EntityId id) {
+    return static_cast<std::uint32_t>(id >> 32);
+}
+
+inline constexpr EntityId makeEntityId(std::uint32_t index, std::uint32_t generation) {
+    return (static_cast<EntityId>(generation) << 32) | index;
+}
+
+// Base sem template para o Registry guardar pools de tipos diferentes
+class ComponentPoolBase {
+public:
+    static constexpr std::uint32_t INVALID = std::numeric_limits<std::uint32_t>::max();
+
+    virtual ~ComponentPoolBase() = default;
+    virtual void remove(EntityId id) = 0;
+    virtual void swapSlots(std::uint32_t a, std::uint32_t b) = 0;
+
+    // Compara o handle inteiro, então handles de gerações antigas dão false
+    bool has(EntityId id) const {
+        const std::uint32_t index = entityIndex(id);
+        return index < sparse.size() && sparse[index] != INVALID && dense[sparse[index]] == id;
+    }
+
+    std::size_t size() const { return dense.size(); }
+
+    // Ids na ordem de armazenamento (paralelo aos componentes)
+    const std::vector<EntityId>& entities() const { return dense; }
+
+    std::uint32_t indexOf(EntityId id) const { return sparse[entityIndex(id)]; }
+
+    // Reordena este pool para que as entidades que também estão em leader
+    // fiquem no início, na mesma ordem de leader. Depois disso, uma view
+    // guiada por leader acessa este pool pelo mesmo índice (linear). O(n).
+    void arrangeLike(const ComponentPoolBase& leader) {
+        std::uint32_t pos = 0;
+        for (EntityId id : leader.dense) {
+            if (!has(id)) continue;
+            const std::uint32_t current = sparse[entityIndex(id)];
+            if (current != pos) swapSlots(current, pos);
+            ++pos;
+        }
+    }
+
+protected:
+    std::vector<std::uint32_t> sparse;
+    std::vector<EntityId> dense;
+};
+
+template <class T>
+class ComponentPool : public ComponentPoolBase {
+public:
+    template <class... Args>
+    T& emplace(EntityId id, Args&&... args) {
+        assert(!has(id));
+        const std::uint32_t index = entityIndex(id);
+        if (index >= sparse.size()) sparse.resize(index + 1, INVALID);
+        sparse[index] = static_cast<std::uint32_t>(dense.size());
+        dense.push_back(id);
+        data.emplace_back(std::forward<Args>(args)...);
+        return data.back();
+    }
+
+    void remove(EntityId id) override {
+        if (!has(id)) return;
+        const std::uint32_t index = sparse[entityIndex(id)];
+        const std::uint32_t last = static_cast<std::uint32_t>(dense.size() - 1);
+        if (index != last) {
+            data[index] = std::move(data[last]);
+            dense[index] = dense[last];
+            sparse[entityIndex(dense[index])] = index;
+        }
+        data.pop_back();
+        dense.pop_back();
+        sparse[entityIndex(id)] = INVALID;
+    }
+
+    void swapSlots(std::uint32_t a, std::uint32_t b) override {
+        std::swap(data[a], data[b]);
+        std::swap(dense[a], dense[b]);
+        sparse[entityIndex(dense[a])] = a;
+        sparse[entityIndex(dense[b])] = b;
+    }
+
+    // A entidade precisa ter o componente (handle velho ou sem ele: use tryGet)
+    T& get(EntityId id) {
+        assert(has(id));
+        return data[sparse[entityIndex(id)]];
+    }
+    const T& get(EntityId id) const {
+        assert(has(id));
+        return data[sparse[entityIndex(id)]];
+    }
+
+    T* tryGet(EntityId id) { return has(id) ? &data[sparse[entityIndex(id)]] : nullptr; }
+
+    // Busca tentando primeiro a posição i (pools alinhados, ver
+    // arrangeLike); senão cai no lookup pelo sparse. nullptr se não tiver.
+    T* findNear(std::uint32_t i, EntityId id) {
+        if (i < dense.size() && dense[i] == id) return &data[i];
+        return has(id) ? &data[sparse[entityIndex(id)]] : nullptr;
+    }
+
+    T* begin() { return data.data(); }
+    T* end() { return data.data() + data.size(); }
+    std::vector<T>& components() { return data; }
+
+private:
+    std::vector<T> data;
+};
+
+// Itera as entidades que têm todos os componentes Ts. O primeiro tipo
+// guia a iteração (escolha o pool mais restrito); os outros são buscados
+// pelo mesmo índice quando os pools estão alinhados.
+template <class... Ts>
+class View {
+public:
+    explicit View(ComponentPool<Ts>*... pools) : pools(pools...) {}
+
+    // fn(EntityId, Ts&...)
+    template <class Fn>
+    void each(Fn&& fn) {
+        auto* lead = std::get<0>(pools);
+        const std::vector<EntityId>& ids = lead->entities();
+        for (std::uint32_t i = 0; i < ids.size(); ++i) {
+            const EntityId id = ids[i];
+            const std::tuple<Ts*...> found(std::get<ComponentPool<Ts>*>(pools)->findNear(i, id)...);
+            if (!((std::get<Ts*>(found) != nullptr) && ...)) continue;
+            fn(id, *std::get<Ts*>(found)...);
+        }
+    }
+
+private:
+    std::tuple<ComponentPool<Ts>*...> pools;
+};
+
+class Registry {
+public:
+    Registry() = default;
+    Registry(const Registry&) = delete;
+    Registry& operator=(const Registry&) = delete;
+
+    // O(1): reutiliza um slot livre (com a geração já incrementada) ou cria um novo
+    EntityId create() {
+        if (!freeSlots.empty()) {
+            const std::uint32_t index = freeSlots.back();
+            freeSlots.pop_back();
+            return makeEntityId(index, generations[index]);
+        }
+        const std::uint32_t index = static_cast<std::uint32_t>(generations.size());
+        generations.push_back(0);
+        return makeEntityId(index, 0);
+    }
+
+    // Remove todos os componentes e libera o slot. Custa um swap-and-pop
+    // por tipo de componente; destruir um handle inválido não faz nada.
+    void destroy(EntityId id) {
+        if (!valid(id)) return;
+        for (auto& pool : pools) {
+            if (pool) pool->remove(id);
+        }
+        ++generations[entityIndex(id)];
+        freeSlots.push_back(entityIndex(id));
+    }
+
+    bool valid(EntityId id) const {
+        const std::uint32_t index = entityIndex(id);
+        return id != NULL_ENTITY && index < generations.size() && generations[index] == entityGeneration(id);
+    }
+
+    std::size_t aliveCount() const { return generations.size() - freeSlots.size(); }
+
+    template <class T, class... Args>
+    T& emplace(EntityId id, Args&&... args) {
+        return pool<T>().emplace(id, std::forward<Args>(args)...);
+    }
+
+    template <class T>
+    void remove(EntityId id) {
+        pool<T>().remove(id);
+    }
+
+    template <class T>
+    bool has(EntityId id) const {
+        const ComponentPool<T>* p = findPool<T>();
+        return p && p->has(id);
+    }
+
+    template <class T>
+    T& get(EntityId id) {
+        return pool<T>().get(id);
+    }
+
+    // Sem pool ainda nenhuma entidade tem T: mesma regra do get() do pool
+    template <class T>
+    const T& get(EntityId id) const {
+        const ComponentPool<T>* p = findPool<T>();
+        assert(p);
+        return p->get(id);
+    }
+
+    template <class T>
+    T* tryGet(EntityId id) {
+        ComponentPool<T>* p = findPool<T>();
+        return p ? p->tryGet(id) : nullptr;
+    }
+
+    template <class T>
+    ComponentPool<T>& pool() {
+        const std::size_t index = typeIndex<T>();
+        if (index >= pools.size()) pools.resize(index + 1);
+        if (!pools[index]) pools[index] = std::make_unique<ComponentPool<T>>();
+        return static_cast<ComponentPool<T>&>(*pools[index]);
+    }
+
+    template <class... Ts>
+    View<Ts...> view() {
+        return View<Ts...>(&pool<Ts>()...);
+    }
+
+    // Alinha o pool T à ordem do pool Leader (ver ComponentPoolBase::arrangeLike)
+    template <class T, class Leader>
+    void arrangeLike() {
+        pool<T>().arrangeLike(pool<Leader>());
+    }
+
+private:
+    template <class T>
+    ComponentPool<T>* findPool() const {
+        const std::size_t index = typeIndex<T>();
+        if (index >= pools.size() || !pools[index]) return nullptr;
+        return static_cast<ComponentPool<T>*>(pools[index].get());
+    }
+
+    // Índice sequencial por tipo de componente, atribuído no primeiro uso
+    static inline std::size_t typeCounter = 0;
+    template <class T>
+    static std::size_t typeIndex() {
+        static const std::size_t index = typeCounter++;
+        return index;
+    }
+
+    std::vector<std::unique_ptr<ComponentPoolBase>> pools;
+    std::vector<std::uint32_t> generations; // Geração atual de cada slot
+    std::vector<std::uint32_t> freeSlots;
+};
+
+#endif // REGISTRY_HPP
@@ -0,0 +1,156 @@
+#include "RenderQueue.hpp"
+#include "FrameData.hpp"
+#include "JobSystem.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    constexpr std::uint64_t SHADER_MASK = (1u << 12) - 1;
+    constexpr std::uint64_t TEXTURE_MASK = (1u << 12) - 1;
+    constexpr std::uint64_t MESH_MASK = (1u << 14) - 1;
+
+    // Draws por pedaço abaixo do qual a ordenação/montagem fica numa thread só
+    constexpr std::size_t PARALLEL_GRAIN = 4096;
+
+    // 24 bits que crescem com a distância: para floats >= 0 os bits IEEE já
+    // são monotônicos, então basta tirar o sinal e os 8 bits mais baixos
+    std::uint64_t depthBits(float depth) {
+        depth = depth > 0.0f ? depth : 0.0f;
+        std::uint32_t bits;
+        std::memcpy(&bits, &depth, sizeof(bits));
+        return bits >> 8;
+    }
+
+    // fn(chunk) para cada pedaço, em paralelo se houver mais de um
+    template <class Fn>
+    void forEachChunk(std::size_t chunkCount, JobSystem* jobs, Fn&& fn) {
+        if (chunkCount == 1 || !jobs) {
+            for (std::size_t c = 0; c < chunkCount; ++c) fn(c);
+            return;
+        }
+        jobs->parallelFor(0, chunkCount, 1, [&](std::size_t first, std::size_t last) {
+            for (std::size_t c = first; c < last; ++c) fn(c);
+        });
+    }
+}
+
+std::uint64_t RenderQueue::opaqueKey(std::uint32_t shader, std::uint32_t texture, std::uint32_t mesh, float depth) {
+    return (std::uint64_t(PASS_OPAQUE) << PASS_SHIFT) |
+           ((shader & SHADER_MASK) << 50) |
+           ((texture & TEXTURE_MASK) << 38) |
+           ((mesh & MESH_MASK) << 24) |
+           depthBits(depth);
+}
+
+std::uint64_t RenderQueue::transparentKey(std::uint32_t shader, std::uint32_t texture, std::uint32_t mesh, float depth) {
+    return (std::uint64_t(PASS_TRANSPARENT) << PASS_SHIFT) |
+           ((~depthBits(depth) & 0xFFFFFFu) << 38) |
+           ((shader & SHADER_MASK) << 26) |
+           ((texture & TEXTURE_MASK) << 14) |
+           (mesh & MESH_MASK);
+}
+
+void RenderQueue::build(const std::vector<DrawItem>& draws, const alg::Mat4& view, JobSystem* jobs) {
+    packets.resize(draws.size());
+
+    const auto fill = [&](std::size_t first, std::size_t last) {
+        for (std::size_t k = first; k < last; ++k) {
+            const DrawItem& draw = draws[k];
+            // -z em view-space da origem do objeto (coluna 3 da model)
+            const float* m = draw.model.m;
+            const float viewZ = view.m[2] * m[12] + view.m[6] * m[13] + view.m[10] * m[14] + view.m[14];
+            const float depth = -viewZ;
+
+            RenderPacket& packet = packets[k];
+            packet.key = draw.transparent
+                ? transparentKey(draw.shaderId, draw.textureId, draw.meshId, depth)
+                : opaqueKey(draw.shaderId, draw.textureId, draw.meshId, depth);
+            packet.draw = static_cast<std::uint32_t>(k);
+            packet.padding = 0;
+        }
+    };
+    if (jobs) {
+        jobs->parallelFor(0, draws.size(), PARALLEL_GRAIN, fill);
+    } else {
+        fill(0, draws.size());
+    }
+
+    unsortedStateChanges = 0;
+    for (std::size_t k = 0; k < draws.size(); ++k) {
+        const DrawItem* previous = k > 0 ? &draws[k - 1] : nullptr;
+        unsortedStateChanges += !previous || previous->shader != draws[k].shader;
+        unsortedStateChanges += !previous || previous->texture != draws[k].texture;
+        unsortedStateChanges += !previous || previous->mesh != draws[k].mesh;
+    }
+}
+
+void RenderQueue::sort(JobSystem* jobs) {
+    radixSortPackets(packets, scratch, histograms, jobs);
+}
+
+void radixSortPackets(std::vector<RenderPacket>& packets, std::vector<RenderPacket>& scratch,
+                      std::vector<std::uint32_t>& histograms, JobSystem* jobs) {
+    const std::size_t n = packets.size();
+    if (n < 2) {
+        return;
+    }
+    scratch.resize(n);
+
+    // Bytes em que alguma chave difere da primeira; os outros não precisam
+    // de passada (na prática o pass e boa parte do estado são constantes)
+    const std::uint64_t firstKey = packets[0].key;
+    std::uint64_t varying = 0;
+    for (const RenderPacket& packet : packets) {
+        varying |= packet.key ^ firstKey;
+    }
+
+    std::size_t chunkCount = 1;
+    if (jobs) {
+        chunkCount = std::max<std::size_t>(1, std::min<std::size_t>(jobs->threadCount(), n / PARALLEL_GRAIN));
+    }
+    histograms.resize(chunkCount * 256);
+    const auto chunkBegin = [n, chunkCount](std::size_t c) { return c * n / chunkCount; };
+
+    RenderPacket* src = packets.data();
+    RenderPacket* dst = scratch.data();
+    for (int shift = 0; shift < 64; shift += 8) {
+        if (((varying >> shift) & 0xFF) == 0) {
+            continue;
+        }
+
+        // 1. Histograma do byte em cada pedaço
+        forEachChunk(chunkCount, jobs, [&](std::size_t c) {
+            std::uint32_t* histogram = &histograms[c * 256];
+            std::fill(histogram, histogram + 256, 0u);
+            for (std::size_t i = chunkBegin(c), end = chunkBegin(c + 1); i < end; ++i) {
+                ++histogram[(src[i].key >> shift) & 0xFF];
+            }
+        });
+
+        // 2. Prefixo exclusivo na ordem (byte, pedaço): cada pedaço ganha
+        //    uma faixa própria dentro de cada balde
+        std::uint32_t sum = 0;
+        for (std::size_t digit = 0; digit < 256; ++digit) {
+            for (std::size_t c = 0; c < chunkCount; ++c) {
+                const std::uint32_t count = histograms[c * 256 + digit];
+                histograms[c * 256 + digit] = sum;
+                sum += count;
+            }
+        }
+
+        // 3. Scatter
+        forEachChunk(chunkCount, jobs, [&](std::size_t c) {
+            std::uint32_t* offsets = &histograms[c * 256];
+            for (std::size_t i = chunkBegin(c), end = chunkBegin(c + 1); i < end; ++i) {
+                dst[offsets[(src[i].key >> shift) & 0xFF]++] = src[i];
+            }
+        });
+
+        std::swap(src, dst);
+    }
+
+    if (src != packets.data()) {
+        packets.swap(scratch);
+    }
+}
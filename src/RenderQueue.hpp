@@ -0,0 +1,71 @@
+#ifndef RENDERQUEUE_HPP
+#define RENDERQUEUE_HPP
+
+#include <cstdint>
+#include <vector>
+#include "algebra.hpp"
+
+class JobSystem;
+struct DrawItem;
+
+// Um draw na fila: a chave de ordenação e o índice do DrawItem
+struct RenderPacket {
+    std::uint64_t key;
+    std::uint32_t draw;
+    std::uint32_t padding;
+};
+
+// Fila de draws de um frame, ordenada por uma chave de 64 bits que agrupa
+// o estado GL. Layout da chave (bit mais alto primeiro):
+//
+//   opacos:       pass(2) | shader(12) | textura(12) | mesh(14) | profundidade(24)
+//   transparentes: pass(2) | ~profundidade(24) | shader(12) | textura(12) | mesh(14)
+//
+// Opacos ficam agrupados por shader, depois textura, depois mesh, e dentro
+// do mesmo estado vão de frente para trás (ajuda o early-z). Transparentes
+// vêm depois, de trás para frente, que é o que o blending exige; o estado
+// só desempata. Os ids são os nomes GL truncados: colisões só custam trocas
+// de estado a mais, nunca um draw errado (a submissão compara os ponteiros).
+class RenderQueue {
+public:
+    enum Pass : std::uint64_t {
+        PASS_OPAQUE = 0,
+        PASS_TRANSPARENT = 1,
+    };
+
+    static constexpr int PASS_SHIFT = 62;
+
+    static std::uint64_t opaqueKey(std::uint32_t shader, std::uint32_t texture, std::uint32_t mesh, float depth);
+    static std::uint64_t transparentKey(std::uint32_t shader, std::uint32_t texture, std::uint32_t mesh, float depth);
+    static Pass passOf(std::uint64_t key) { return static_cast<Pass>(key >> PASS_SHIFT); }
+
+    // Uma chave por draw; a profundidade é a distância da origem do objeto
+    // ao plano da câmera (view-space). Com jobs, em paralelo.
+    void build(const std::vector<DrawItem>& draws, const alg::Mat4& view, JobSystem* jobs = nullptr);
+
+    // Radix sort LSD das chaves (estável). Com jobs, em paralelo.
+    void sort(JobSystem* jobs = nullptr);
+
+    const std::vector<RenderPacket>& getPackets() const { return packets; }
+
+    // Trocas de shader + textura + mesh se os draws fossem na ordem da
+    // cena (para comparar com o que a submissão ordenada faz)
+    std::uint32_t getUnsortedStateChanges() const { return unsortedStateChanges; }
+
+private:
+    std::vector<RenderPacket> packets;
+    std::vector<RenderPacket> scratch;
+    std::vector<std::uint32_t> histograms; // [pedaço][256]
+    std::uint32_t unsortedStateChanges = 0;
+};
+
+// Radix sort LSD de 8 bits por passada sobre RenderPacket::key. Passadas
+// em que todas as chaves têm o mesmo byte são puladas. Com jobs, cada
+// passada divide a entrada em pedaços: histogramas por pedaço em paralelo,
+// soma de prefixos e scatter em paralelo (cada pedaço escreve numa faixa
+// reservada, o que mantém a ordenação estável). scratch e histograms são
+// só memória de trabalho, reaproveitada entre frames.
+void radixSortPackets(std::vector<RenderPacket>& packets, std::vector<RenderPacket>& scratch,
+                      std::vector<std::uint32_t>& histograms, JobSystem* jobs = nullptr);
+
+#endif // RENDERQUEUE_HPP
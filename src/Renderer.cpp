@@ -0,0 +1,441 @@
+#include "Renderer.hpp"
+
+#include <glad/glad.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+
+#include "JobSystem.hpp"
+#include "Mesh.hpp"
+#include "Shader.hpp"
+#include "Texture.hpp"
+
+namespace {
+    // Instâncias por pedaço na cópia para o buffer de instâncias
+    constexpr std::size_t INSTANCE_GRAIN = 2048;
+
+    // Locations dos atributos por instância em basic.vert
+    constexpr GLuint INSTANCE_MODEL_LOCATION = 3;    // mat4: 3-6
+    constexpr GLuint INSTANCE_NORMAL_LOCATION = 7;   // mat4: 7-10
+    constexpr GLuint INSTANCE_MATERIAL_LOCATION = 11; // uint
+    constexpr GLuint INSTANCE_LIGHTS_LOCATION = 12;   // uvec4
+    constexpr GLuint INSTANCE_LOCATION_END = 13;
+
+    // Unidades 0 e 1 são as texturas difusa/especular do material
+    constexpr int MATERIAL_TEXTURE_UNIT = 2;
+    constexpr int CLUSTER_LIGHTS_UNIT = 3;
+    constexpr int CLUSTER_RANGES_UNIT = 4;
+    constexpr int CLUSTER_INDICES_UNIT = 5;
+
+    // O caminho sem instancing (ModelEntity::render) usa os mesmos VAOs:
+    // o VAO não pode ficar com os atributos por instância ligados
+    void disableInstanceAttributes() {
+        for (GLuint location = INSTANCE_MODEL_LOCATION; location < INSTANCE_LOCATION_END; ++location) {
+            glDisableVertexAttribArray(location);
+        }
+    }
+
+    // glMultiDrawElementsIndirect (GL 4.3 / ARB_multi_draw_indirect), que o
+    // GLAD gerado para 4.1 não conhece
+    using MultiDrawElementsIndirectFn = void (APIENTRYP)(GLenum mode, GLenum type, const void* indirect,
+                                                          GLsizei drawCount, GLsizei stride);
+    MultiDrawElementsIndirectFn multiDrawElementsIndirect = nullptr;
+
+    bool hasExtension(const char* name) {
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        for (GLint i = 0; i < count; ++i) {
+            const char* extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+            if (extension && std::strcmp(extension, name) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool versionAtLeast(int major, int minor) {
+        return GLVersion.major > major || (GLVersion.major == major && GLVersion.minor >= minor);
+    }
+
+    bool sameState(const DrawItem& a, const DrawItem& b) {
+        return a.mesh == b.mesh && a.shader == b.shader && a.texture == b.texture && a.transparent == b.transparent;
+    }
+}
+
+Renderer::~Renderer() {
+    if (instanceVBO) {
+        glDeleteBuffers(1, &instanceVBO);
+    }
+    if (indirectBuffer) {
+        glDeleteBuffers(1, &indirectBuffer);
+    }
+    if (whiteTexture) {
+        glDeleteTextures(1, &whiteTexture);
+    }
+    if (materialBuffer) {
+        glDeleteTextures(1, &materialTexture);
+        glDeleteBuffers(1, &materialBuffer);
+    }
+    for (TextureBuffer* target : {&clusterLights, &clusterRanges, &clusterIndices}) {
+        if (target->buffer) {
+            glDeleteTextures(1, &target->texture);
+            glDeleteBuffers(1, &target->buffer);
+        }
+    }
+}
+
+void Renderer::loadExtensions(ProcLoader load) {
+    // O baseInstance dos comandos precisa ser respeitado (GL 4.2 ou
+    // ARB_base_instance); sem ele a extensão exige baseInstance = 0
+    const bool core = versionAtLeast(4, 3);
+    const bool extension = hasExtension("GL_ARB_multi_draw_indirect") &&
+                           (versionAtLeast(4, 2) || hasExtension("GL_ARB_base_instance"));
+    if (core || extension) {
+        multiDrawElementsIndirect = reinterpret_cast<MultiDrawElementsIndirectFn>(load("glMultiDrawElementsIndirect"));
+    }
+    multiDrawIndirectSupported = multiDrawElementsIndirect != nullptr;
+}
+
+void Renderer::prepareQueue(FrameData& frame, JobSystem* jobs) {
+    frame.queue.build(frame.draws, frame.view, jobs);
+    frame.queue.sort(jobs);
+
+    // Lotes: só draws vizinhos na fila, o que mantém a ordem de trás para
+    // frente dos transparentes (dois transparentes iguais só se juntam se
+    // nada ficou entre eles)
+    const std::vector<RenderPacket>& packets = frame.queue.getPackets();
+    frame.batches.clear();
+    for (std::size_t k = 0; k < packets.size(); ++k) {
+        const DrawItem& draw = frame.draws[packets[k].draw];
+        if (frame.batches.empty() || !sameState(frame.draws[frame.batches.back().draw], draw)) {
+            DrawBatch batch;
+            batch.firstInstance = static_cast<std::uint32_t>(k);
+            batch.draw = packets[k].draw;
+            batch.transparent = draw.transparent;
+            frame.batches.push_back(batch);
+        }
+        ++frame.batches.back().instanceCount;
+    }
+
+    // Dados por instância na ordem da fila
+    frame.instances.resize(packets.size());
+    const auto fill = [&](std::size_t first, std::size_t last) {
+        for (std::size_t k = first; k < last; ++k) {
+            const DrawItem& draw = frame.draws[packets[k].draw];
+            InstanceData& instance = frame.instances[k];
+            instance.model = draw.model;
+            instance.normal = draw.normal;
+            instance.material = draw.material;
+            std::copy(draw.lights, draw.lights + LIGHTS_PER_DRAW, instance.lights);
+        }
+    };
+    if (jobs) {
+        jobs->parallelFor(0, packets.size(), INSTANCE_GRAIN, fill);
+    } else {
+        fill(0, packets.size());
+    }
+}
+
+void Renderer::setShaderUniforms(const Shader& shader) {
+    auto [it, inserted] = programUniforms.try_emplace(shader.ID);
+    ProgramUniforms& uniforms = it->second;
+    if (inserted) {
+        uniforms.materialDiffuse = shader.uniform("material.diffuse");
+        uniforms.materials = shader.uniform("materials");
+        uniforms.clusterLights = shader.uniform("clusterLights");
+        uniforms.clusterRanges = shader.uniform("clusterRanges");
+        uniforms.clusterIndices = shader.uniform("clusterIndices");
+        uniforms.instanced = shader.uniform("instanced");
+    }
+
+    // Unidades de textura dos samplers
+    shader.setInt(uniforms.materialDiffuse, 0);
+    shader.setInt(uniforms.materials, MATERIAL_TEXTURE_UNIT);
+    shader.setInt(uniforms.clusterLights, CLUSTER_LIGHTS_UNIT);
+    shader.setInt(uniforms.clusterRanges, CLUSTER_RANGES_UNIT);
+    shader.setInt(uniforms.clusterIndices, CLUSTER_INDICES_UNIT);
+    shader.setBool(uniforms.instanced, true);
+}
+
+void Renderer::bindInstanceAttributes(std::uint32_t firstInstance) {
+    // Os atributos por instância fazem parte do VAO: são reapontados a cada
+    // lote para a faixa dele no buffer (o VAO do mesh pode ter sido usado
+    // por outro lote, ou pelo caminho sem instancing, antes)
+    const GLsizei stride = sizeof(InstanceData);
+    const std::size_t base = std::size_t(firstInstance) * sizeof(InstanceData);
+    const auto pointer = [base](std::size_t offset) {
+        return reinterpret_cast<const void*>(base + offset);
+    };
+    for (GLuint column = 0; column < 4; ++column) {
+        glVertexAttribPointer(INSTANCE_MODEL_LOCATION + column, 4, GL_FLOAT, GL_FALSE, stride,
+                              pointer(offsetof(InstanceData, model) + column * sizeof(alg::Vec4)));
+        glVertexAttribPointer(INSTANCE_NORMAL_LOCATION + column, 4, GL_FLOAT, GL_FALSE, stride,
+                              pointer(offsetof(InstanceData, normal) + column * sizeof(alg::Vec4)));
+    }
+    glVertexAttribIPointer(INSTANCE_MATERIAL_LOCATION, 1, GL_UNSIGNED_INT, stride, pointer(offsetof(InstanceData, material)));
+    glVertexAttribIPointer(INSTANCE_LIGHTS_LOCATION, LIGHTS_PER_DRAW, GL_UNSIGNED_INT, stride, pointer(offsetof(InstanceData, lights)));
+    for (GLuint location = INSTANCE_MODEL_LOCATION; location < INSTANCE_LOCATION_END; ++location) {
+        glEnableVertexAttribArray(location);
+        glVertexAttribDivisor(location, 1);
+    }
+}
+
+void Renderer::uploadInstances(const FrameData& frame) {
+    // Todas as instâncias do frame de uma vez; o buffer só cresce
+    if (!instanceVBO) {
+        glGenBuffers(1, &instanceVBO);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    const std::size_t instanceBytes = frame.instances.size() * sizeof(InstanceData);
+    if (frame.instances.size() > instanceCapacity) {
+        instanceCapacity = frame.instances.size();
+        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(instanceBytes), frame.instances.data(), GL_STREAM_DRAW);
+    } else {
+        // Orphaning: o driver não espera a GPU terminar o frame anterior
+        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(instanceCapacity * sizeof(InstanceData)), nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(instanceBytes), frame.instances.data());
+    }
+}
+
+void Renderer::uploadMaterials(const FrameData& frame) {
+    if (!materialBuffer) {
+        glGenBuffers(1, &materialBuffer);
+        glGenTextures(1, &materialTexture);
+    }
+
+    materials.resize(frame.materialCount);
+    for (const MaterialUpdate& update : frame.materialUpdates) {
+        materials[update.slot] = update.data;
+    }
+    stats.materialUploads = static_cast<std::uint32_t>(frame.materialUpdates.size());
+
+    glBindBuffer(GL_TEXTURE_BUFFER, materialBuffer);
+    if (materials.size() > materialCapacity) {
+        // Cresce: manda tudo (a cópia da CPU já tem as atualizações)
+        materialCapacity = std::max<std::size_t>(materials.size(), materialCapacity * 2);
+        glBufferData(GL_TEXTURE_BUFFER, static_cast<GLsizeiptr>(materialCapacity * sizeof(MaterialData)), nullptr, GL_DYNAMIC_DRAW);
+        glBufferSubData(GL_TEXTURE_BUFFER, 0, static_cast<GLsizeiptr>(materials.size() * sizeof(MaterialData)), materials.data());
+        glActiveTexture(GL_TEXTURE0 + MATERIAL_TEXTURE_UNIT);
+        glBindTexture(GL_TEXTURE_BUFFER, materialTexture);
+        glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, materialBuffer);
+    } else {
+        // Só as posições que mudaram, juntando as vizinhas num envio
+        const std::vector<MaterialUpdate>& updates = frame.materialUpdates;
+        std::size_t first = 0;
+        while (first < updates.size()) {
+            std::size_t last = first + 1;
+            while (last < updates.size() && updates[last].slot == updates[last - 1].slot + 1) ++last;
+            const std::size_t slot = updates[first].slot;
+            glBufferSubData(GL_TEXTURE_BUFFER, static_cast<GLintptr>(slot * sizeof(MaterialData)),
+                            static_cast<GLsizeiptr>((last - first) * sizeof(MaterialData)), &materials[slot]);
+            first = last;
+        }
+    }
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+    glActiveTexture(GL_TEXTURE0 + MATERIAL_TEXTURE_UNIT);
+    glBindTexture(GL_TEXTURE_BUFFER, materialTexture);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+void Renderer::uploadClusters(const FrameData& frame) {
+    const LightClusters& clusters = frame.clusters;
+    stats.clusterLights = clusters.getLightCount();
+    stats.clusterIndices = static_cast<std::uint32_t>(clusters.getIndices().size());
+
+    // Tudo muda a cada frame (a câmera anda): orphaning e envio inteiro.
+    // Sem clusters vão só as luzes (ranges e indices ficam vazios), que as
+    // luzes escolhidas por draw indexam.
+    const auto upload = [](TextureBuffer& target, GLenum format, int unit, const void* data, std::size_t bytes) {
+        const bool created = !target.buffer;
+        if (created) {
+            glGenBuffers(1, &target.buffer);
+            glGenTextures(1, &target.texture);
+        }
+        glBindBuffer(GL_TEXTURE_BUFFER, target.buffer);
+        glBufferData(GL_TEXTURE_BUFFER, static_cast<GLsizeiptr>(bytes), data, GL_STREAM_DRAW);
+        glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+        glActiveTexture(GL_TEXTURE0 + unit);
+        glBindTexture(GL_TEXTURE_BUFFER, target.texture);
+        if (created) {
+            glTexBuffer(GL_TEXTURE_BUFFER, format, target.buffer);
+        }
+    };
+    const std::vector<alg::Vec4>& lights = clusters.getLightTexels();
+    const std::vector<std::uint32_t>& ranges = clusters.getRanges();
+    const std::vector<std::uint32_t>& indices = clusters.getIndices();
+    upload(clusterLights, GL_RGBA32F, CLUSTER_LIGHTS_UNIT, lights.data(), lights.size() * sizeof(alg::Vec4));
+    upload(clusterRanges, GL_RG32UI, CLUSTER_RANGES_UNIT, ranges.data(), ranges.size() * sizeof(std::uint32_t));
+    upload(clusterIndices, GL_R32UI, CLUSTER_INDICES_UNIT, indices.data(), indices.size() * sizeof(std::uint32_t));
+    glActiveTexture(GL_TEXTURE0);
+}
+
+void Renderer::bindBatchState(const FrameData& frame, const DrawBatch& batch) {
+    const DrawItem& draw = frame.draws[batch.draw];
+
+    if (!transparentPass && batch.transparent) {
+        // Daqui para frente só transparentes (de trás para frente):
+        // blending ligado e sem escrita no depth buffer
+        transparentPass = true;
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        glDepthMask(GL_FALSE);
+    }
+
+    if (draw.shader != boundShader) {
+        boundShader = draw.shader;
+        boundShader->use();
+        setShaderUniforms(*boundShader);
+        ++stats.shaderBinds;
+    }
+    // Sem textura a unidade 0 não pode ficar com a do lote anterior
+    if (!draw.texture && !whiteTexture) {
+        const unsigned char white[4] = {255, 255, 255, 255};
+        glGenTextures(1, &whiteTexture);
+        glBindTexture(GL_TEXTURE_2D, whiteTexture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, white);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        boundTexture = 0; // Ligada na unidade ativa, que pode não ser a 0
+    }
+    const unsigned int texture = draw.texture ? draw.texture->getID() : whiteTexture;
+    if (texture != boundTexture) {
+        boundTexture = texture;
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        ++stats.textureBinds;
+    }
+}
+
+void Renderer::submit(const FrameData& frame) {
+    stats = Stats{};
+    stats.unsortedStateChanges = frame.queue.getUnsortedStateChanges();
+    // Mesmo sem draws: as atualizações de materiais valem só para este frame
+    uploadMaterials(frame);
+    if (frame.batches.empty()) {
+        return;
+    }
+
+    // Câmera, luzes e parâmetros dos clusters: uma escrita por frame no anel
+    // de UBOs. O modo de iluminação é o de quando o frame foi preparado (os
+    // clusters ou as luzes por draw só existem para ele).
+    packCameraBlock(frame, cameraBlock);
+    packLightBlock(frame, lightBlock);
+    packClusterBlock(frame, frame.clusteredLighting, clusterBlock);
+    frameUniforms.upload(cameraBlock, lightBlock, clusterBlock);
+    uploadClusters(frame);
+
+    // O estado GL é outro a cada frame (a UI desenha no meio), então o
+    // rastreamento recomeça do zero
+    boundShader = nullptr;
+    boundTexture = 0;
+    transparentPass = false;
+
+    stats.batches = static_cast<std::uint32_t>(frame.batches.size());
+    stats.instances = static_cast<std::uint32_t>(frame.instances.size());
+    if (multiDrawIndirectSupported && multiDrawIndirectEnabled) {
+        stats.multiDrawIndirect = true;
+        submitMultiDrawIndirect(frame);
+    } else {
+        submitInstanced(frame);
+    }
+    frameUniforms.fence();
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    if (transparentPass) {
+        glDepthMask(GL_TRUE);
+        glDisable(GL_BLEND);
+    }
+}
+
+void Renderer::submitInstanced(const FrameData& frame) {
+    uploadInstances(frame);
+
+    Mesh* boundMesh = nullptr;
+    for (const DrawBatch& batch : frame.batches) {
+        bindBatchState(frame, batch);
+
+        Mesh* mesh = frame.draws[batch.draw].mesh;
+        if (mesh != boundMesh) {
+            if (boundMesh) {
+                disableInstanceAttributes();
+            }
+            boundMesh = mesh;
+            glBindVertexArray(boundMesh->getVAO());
+            ++stats.meshBinds;
+        }
+
+        bindInstanceAttributes(batch.firstInstance);
+        glDrawElementsInstanced(GL_TRIANGLES, static_cast<GLsizei>(boundMesh->getIndexCount()), GL_UNSIGNED_INT, 0,
+                                static_cast<GLsizei>(batch.instanceCount));
+        ++stats.draws;
+    }
+    disableInstanceAttributes();
+}
+
+void Renderer::submitMultiDrawIndirect(const FrameData& frame) {
+    // 1. Um comando por lote. Meshes novos entram no pool aqui, antes de
+    //    ligar o VAO dele (crescer o pool mexe nos bindings).
+    commands.resize(frame.batches.size());
+    for (std::size_t i = 0; i < frame.batches.size(); ++i) {
+        const DrawBatch& batch = frame.batches[i];
+        const MeshPool::Range& range = meshPool.acquire(*frame.draws[batch.draw].mesh);
+        DrawElementsIndirectCommand& command = commands[i];
+        command.count = range.indexCount;
+        command.instanceCount = batch.instanceCount;
+        command.firstIndex = range.firstIndex;
+        command.baseVertex = range.baseVertex;
+        command.baseInstance = batch.firstInstance;
+    }
+
+    if (!indirectBuffer) {
+        glGenBuffers(1, &indirectBuffer);
+    }
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer);
+    const std::size_t commandBytes = commands.size() * sizeof(DrawElementsIndirectCommand);
+    if (commands.size() > indirectCapacity) {
+        indirectCapacity = commands.size();
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, static_cast<GLsizeiptr>(commandBytes), commands.data(), GL_STREAM_DRAW);
+    } else {
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, static_cast<GLsizeiptr>(indirectCapacity * sizeof(DrawElementsIndirectCommand)),
+                     nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, static_cast<GLsizeiptr>(commandBytes), commands.data());
+    }
+
+    // 2. Instâncias a partir do início do buffer: o baseInstance de cada
+    //    comando desloca a leitura dos atributos por instância
+    uploadInstances(frame);
+    glBindVertexArray(meshPool.getVAO());
+    ++stats.meshBinds;
+    bindInstanceAttributes(0);
+
+    // 3. Um multi-draw por sequência de lotes com o mesmo pass, shader e textura
+    std::size_t first = 0;
+    while (first < frame.batches.size()) {
+        const DrawItem& head = frame.draws[frame.batches[first].draw];
+        std::size_t last = first + 1;
+        while (last < frame.batches.size()) {
+            const DrawBatch& next = frame.batches[last];
+            const DrawItem& draw = frame.draws[next.draw];
+            // Sem textura também é um estado (a branca): não entra numa sequência texturizada
+            if (next.transparent != frame.batches[first].transparent || draw.shader != head.shader ||
+                draw.texture != head.texture) {
+                break;
+            }
+            ++last;
+        }
+
+        bindBatchState(frame, frame.batches[first]);
+        multiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT,
+                                  reinterpret_cast<const void*>(first * sizeof(DrawElementsIndirectCommand)),
+                                  static_cast<GLsizei>(last - first), 0);
+        ++stats.draws;
+        first = last;
+    }
+
+    disableInstanceAttributes();
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
@@ -0,0 +1,164 @@
+#ifndef RENDERER_HPP
+#define RENDERER_HPP
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "FrameData.hpp"
+#include "FrameUniforms.hpp"
+#include "MeshPool.hpp"
+#include "Shader.hpp"
+
+class JobSystem;
+
+// Layout fixo do GL (glMultiDrawElementsIndirect lê isto do buffer)
+struct DrawElementsIndirectCommand {
+    std::uint32_t count;
+    std::uint32_t instanceCount;
+    std::uint32_t firstIndex;
+    std::int32_t baseVertex;
+    std::uint32_t baseInstance;
+};
+static_assert(sizeof(DrawElementsIndirectCommand) == 20, "DrawElementsIndirectCommand precisa de 20 bytes");
+
+// Submissão GL de um FrameData, na ordem da RenderQueue. Draws seguidos com
+// o mesmo mesh, shader e textura saem num único glDrawElementsInstanced,
+// com matrizes e material de cada instância num buffer de vértices por
+// instância (enviado uma vez por frame). Shader, textura e VAO só são
+// trocados quando o próximo lote usa outro. Câmera e luzes vão uma vez por
+// frame, nos uniform blocks Camera e Lights (FrameUniformRing); as cores dos
+// materiais ficam num buffer na GPU, atualizado só onde mudou, e cada
+// instância leva só o índice do seu material.
+//
+// Com GL 4.3 ou ARB_multi_draw_indirect (+ base instance), os meshes ficam
+// num MeshPool e cada lote vira um DrawElementsIndirectCommand; sequências
+// de lotes com o mesmo shader e textura saem num glMultiDrawElementsIndirect
+// só. O baseInstance do comando é o firstInstance do lote, então os
+// atributos por instância apontam para o buffer inteiro uma vez por frame.
+// Sem suporte (GL 3.3), fica o caminho de um draw instanciado por lote.
+class Renderer {
+public:
+    // Mesma assinatura de GLADloadproc
+    using ProcLoader = void* (*)(const char* name);
+
+    Renderer() = default;
+    ~Renderer();
+
+    Renderer(const Renderer&) = delete;
+    Renderer& operator=(const Renderer&) = delete;
+
+    struct Stats {
+        std::uint32_t draws = 0;     // Chamadas de draw
+        std::uint32_t batches = 0;   // Lotes (comandos indiretos no multi-draw)
+        std::uint32_t instances = 0; // Objetos desenhados
+        std::uint32_t materialUploads = 0; // Materiais reenviados
+        std::uint32_t clusterLights = 0;   // Luzes binadas nos clusters (0 sem o caminho clusterizado)
+        std::uint32_t clusterIndices = 0;  // Tamanho das listas de luz dos clusters
+        bool multiDrawIndirect = false;
+        std::uint32_t shaderBinds = 0;
+        std::uint32_t textureBinds = 0;
+        std::uint32_t meshBinds = 0;
+        // Trocas que os mesmos draws custariam na ordem da cena
+        std::uint32_t unsortedStateChanges = 0;
+
+        std::uint32_t stateChanges() const { return shaderBinds + textureBinds + meshBinds; }
+    };
+
+    // Etapa do grafo do frame: chaves de ordenação, radix sort e os lotes
+    // instanciados com seus dados por instância (workers, sem GL)
+    static void prepareQueue(FrameData& frame, JobSystem* jobs = nullptr);
+
+    // Thread do contexto GL, depois do gladLoadGLLoader: procura suporte a
+    // multi-draw indirect (o GLAD do projeto só carrega até o GL 4.1)
+    void loadExtensions(ProcLoader load);
+    bool supportsMultiDrawIndirect() const { return multiDrawIndirectSupported; }
+    // Para comparar os caminhos; sem suporte não tem efeito
+    void setMultiDrawIndirect(bool enabled) { multiDrawIndirectEnabled = enabled; }
+    bool isMultiDrawIndirectEnabled() const { return multiDrawIndirectEnabled; }
+
+    // Forward clusterizado (LightClusters) ou as luzes escolhidas por draw
+    // (LightSelection). Vale a partir do próximo frame preparado: main.cpp
+    // copia para FrameData::clusteredLighting.
+    void setClusteredLighting(bool enabled) { clusteredLighting = enabled; }
+    bool isClusteredLightingEnabled() const { return clusteredLighting; }
+
+    // Thread do contexto GL
+    void submit(const FrameData& frame);
+
+    // Da última submit()
+    const Stats& getStats() const { return stats; }
+
+private:
+    // Handles dos uniforms soltos de um programa (samplers, modo
+    // instanciado), resolvidos na primeira vez que ele é ligado
+    struct ProgramUniforms {
+        UniformHandle materialDiffuse;
+        UniformHandle materials;
+        UniformHandle clusterLights;
+        UniformHandle clusterRanges;
+        UniformHandle clusterIndices;
+        UniformHandle instanced;
+    };
+
+    // Uniforms soltos do shader, por troca de shader
+    void setShaderUniforms(const Shader& shader);
+    // Aponta os atributos 3-12 do VAO ligado para o lote que começa em firstInstance
+    void bindInstanceAttributes(std::uint32_t firstInstance);
+    void uploadInstances(const FrameData& frame);
+    // Aplica frame.materialUpdates e liga o buffer na unidade MATERIAL_TEXTURE_UNIT
+    void uploadMaterials(const FrameData& frame);
+    // Luzes, faixas e índices de frame.clusters nos seus texture buffers
+    // (as luzes também servem à escolha por draw)
+    void uploadClusters(const FrameData& frame);
+    // Pass, shader e textura do lote (só o que mudou desde o anterior)
+    void bindBatchState(const FrameData& frame, const DrawBatch& batch);
+
+    void submitInstanced(const FrameData& frame);
+    void submitMultiDrawIndirect(const FrameData& frame);
+
+    Stats stats;
+    FrameUniformRing frameUniforms;
+    CameraBlock cameraBlock;
+    LightBlock lightBlock;
+    ClusterBlock clusterBlock;
+    unsigned int instanceVBO = 0;
+    std::size_t instanceCapacity = 0; // Em instâncias
+
+    // Materiais num texture buffer (RGBA32F, 3 texels cada): com um
+    // material por entidade, dezenas de milhares não cabem num UBO
+    std::vector<MaterialData> materials; // Cópia do que está na GPU
+    unsigned int materialBuffer = 0;
+    unsigned int materialTexture = 0;
+    std::size_t materialCapacity = 0; // Em materiais
+
+    // Um buffer com a textura que o expõe ao shader (samplerBuffer)
+    struct TextureBuffer {
+        unsigned int buffer = 0;
+        unsigned int texture = 0;
+    };
+    bool clusteredLighting = true;
+    TextureBuffer clusterLights;  // RGBA32F, 4 texels por luz
+    TextureBuffer clusterRanges;  // RG32UI, por cluster
+    TextureBuffer clusterIndices; // R32UI
+
+    bool multiDrawIndirectSupported = false;
+    bool multiDrawIndirectEnabled = true;
+    MeshPool meshPool;
+    std::vector<DrawElementsIndirectCommand> commands;
+    unsigned int indirectBuffer = 0;
+    std::size_t indirectCapacity = 0; // Em comandos
+
+    // Branca 1x1 na unidade 0 dos draws sem textura difusa (o shader fica
+    // só com a cor do material). Criada no primeiro draw que precisar.
+    unsigned int whiteTexture = 0;
+
+    // Por Shader::ID (os shaders vivem no ResourceManager até o fim)
+    std::unordered_map<unsigned int, ProgramUniforms> programUniforms;
+
+    // Estado GL ligado durante uma submit()
+    Shader* boundShader = nullptr;
+    unsigned int boundTexture = 0; // Nome GL na unidade 0; 0 = não sabemos
+    bool transparentPass = false;
+};
+
+#endif // RENDERER_HPP
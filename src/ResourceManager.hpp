@@ -2,9 +2,11 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 #include "Shader.hpp"
 #include "Texture.hpp"
 #include "Mesh.hpp"
+#include "JobSystem.hpp"
 
 class ResourceManager {
 public:
@@ -20,6 +22,24 @@ public:
         return std::make_shared<Texture>(path.c_str());
     }
 
+    // Decodifica as imagens em paralelo nos workers e faz o upload aqui, na
+    // thread do contexto GL. Mesma ordem de paths.
+    static std::vector<std::shared_ptr<Texture>> loadTextures(const std::vector<std::string>& paths, JobSystem& jobs) {
+        std::vector<TextureImage> images(paths.size());
+        jobs.parallelFor(0, paths.size(), 1, [&](std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; ++i) {
+                images[i] = Texture::decode(paths[i].c_str());
+            }
+        });
+
+        std::vector<std::shared_ptr<Texture>> result;
+        result.reserve(images.size());
+        for (const TextureImage& image : images) {
+            result.push_back(std::make_shared<Texture>(image));
+        }
+        return result;
+    }
+
     std::shared_ptr<Mesh> loadMesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices) {
         std::string key = std::to_string(vertices.size()) + "_" + std::to_string(indices.size());
         if (meshes.count(key)) return meshes[key];
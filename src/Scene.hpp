@@ -1,8 +1,14 @@
 // Scene.hpp
 
 #pragma once
+#include <algorithm>
 #include <vector>
 #include <memory>
+#include <limits>
+#include "geometry.hpp"
+#include "bvh.hpp"
+#include "JobSystem.hpp"
+#include "FrameData.hpp"
 #include "Entity.hpp"
 #include "CameraEntity.hpp"
 #include "Light.hpp"
@@ -10,62 +16,357 @@
 
 class Scene {
 public:
+    // Declarado primeiro: é destruído por último, depois das entidades que o usam
+    Registry registry;
+
+    // Sem ordem definida: remoções são swap-and-pop (veja flushDestroyed)
     std::vector<std::shared_ptr<Entity>> entities;
-    std::vector<std::shared_ptr<CameraEntity>> cameras;
-    std::vector<std::shared_ptr<Light>> lights;
 
     std::shared_ptr<CameraEntity> activeCamera;
     std::shared_ptr<Entity> selectedEntity;
 
     Scene() {
-        auto defaultCamera = std::make_shared<CameraEntity>("Main Camera");
-        defaultCamera->isActive = true;
-        cameras.push_back(defaultCamera);
+        // As etapas do frame leem estes pools em paralelo, e pool<T>() cria
+        // o pool sob demanda (não é thread-safe): ficam criados desde já
+        registry.pool<TransformComponent>();
+        registry.pool<WorldTransformComponent>();
+        registry.pool<WorldBoundsComponent>();
+        registry.pool<MeshRendererComponent>();
+        registry.pool<Material>();
+        registry.pool<LightComponent>();
+
+        auto defaultCamera = create<CameraEntity>("Main Camera");
+        defaultCamera->setActive(true);
         activeCamera = defaultCamera;
-        entities.push_back(defaultCamera);
     }
 
+    // Cria uma entidade (fachada) com os componentes no registry desta cena
+    template <class T, class... Args>
+    std::shared_ptr<T> create(Args&&... args) {
+        auto entity = std::make_shared<T>(registry, std::forward<Args>(args)...);
+        addEntity(entity);
+        return entity;
+    }
+
+    // A entidade precisa ter sido criada com o registry desta cena
     void addEntity(std::shared_ptr<Entity> entity) {
+        const std::uint32_t index = entityIndex(entity->getId());
+        if (index >= entitySlot.size()) entitySlot.resize(index + 1, NO_SLOT);
+        entitySlot[index] = static_cast<std::uint32_t>(entities.size());
         entities.push_back(entity);
+        graph.add(entity.get());
+
+        if (registry.has<MeshRendererComponent>(entity->getId())) {
+            renderOrderDirty = true;
+        }
+    }
+
+    // O(1): nullptr se o handle for de uma entidade já destruída
+    std::shared_ptr<Entity> find(EntityId id) const {
+        if (!registry.valid(id)) return nullptr;
+        const std::uint32_t index = entityIndex(id);
+        if (index >= entitySlot.size() || entitySlot[index] == NO_SLOT) return nullptr;
+        return entities[entitySlot[index]];
+    }
+
+    // Marca a entidade (e seus descendentes) para destruição no fim do frame.
+    // Até lá ela continua válida, então pode ser chamado no meio da UI ou de
+    // um loop sobre as entidades.
+    void destroy(EntityId id) { pendingDestroy.push_back(id); }
+    void destroy(const std::shared_ptr<Entity>& entity) { destroy(entity->getId()); }
+
+    // Aplica as destruições pendentes: cada entidade sai do grafo, de
+    // entities (swap-and-pop, atualizando entitySlot) e do registry, e o
+    // handle dela passa a ser inválido. Chamar entre frames, sem preparação
+    // rodando.
+    //
+    // Mesh/shader/texturas de renderizáveis destruídos ficam vivos até a próxima
+    // chamada: o FrameData do frame anterior, que ainda vai ser desenhado,
+    // guarda ponteiros crus para eles.
+    void flushDestroyed() {
+        retiredRenderers.clear();
+        retiredMaterials.clear();
+        if (pendingDestroy.empty()) return;
+
+        // Mantém as facades vivas até o fim: os filhos ainda apontam para o pai
+        std::vector<std::shared_ptr<Entity>> dying;
+        for (std::size_t i = 0; i < pendingDestroy.size(); ++i) { // Cresce com os filhos
+            const EntityId id = pendingDestroy[i];
+            std::shared_ptr<Entity> entity = find(id);
+            if (!entity) continue; // Destruída duas vezes
+
+            for (Entity* child : entity->getChildren()) {
+                pendingDestroy.push_back(child->getId());
+            }
+            graph.remove(entity.get());
+
+            const std::uint32_t slot = entitySlot[entityIndex(id)];
+            if (slot + 1 != entities.size()) {
+                entities[slot] = std::move(entities.back());
+                entitySlot[entityIndex(entities[slot]->getId())] = slot;
+            }
+            entities.pop_back();
+            entitySlot[entityIndex(id)] = NO_SLOT;
+
+            if (MeshRendererComponent* renderer = registry.tryGet<MeshRendererComponent>(id)) {
+                retiredRenderers.push_back(std::move(*renderer));
+                if (Material* material = registry.tryGet<Material>(id)) {
+                    retiredMaterials.push_back(std::move(*material));
+                }
+                renderOrderDirty = true;
+            }
+            registry.destroy(id);
+
+            if (selectedEntity == entity) selectedEntity.reset();
+            if (activeCamera == entity) activeCamera.reset();
+            dying.push_back(std::move(entity));
+        }
+        pendingDestroy.clear();
+    }
+
+    // Muda o pai de child (nullptr = raiz). O transform local é mantido,
+    // então o objeto passa a se mover junto com o novo pai.
+    bool setParent(const std::shared_ptr<Entity>& child, const std::shared_ptr<Entity>& parent) {
+        return graph.setParent(child.get(), parent.get());
+    }
+
+    // Recalcula as matrizes de mundo de tudo que mudou desde a última chamada
+    // (e dos descendentes). Chamar uma vez por frame, depois da UI e antes de
+    // desenhar; numa cena estática não há trabalho nenhum. Com jobs, as
+    // matrizes e as caixas de mundo são calculadas nas threads do pool.
+    void updateTransforms(JobSystem* jobs = nullptr) {
+        graph.update(jobs);
+
+        // Bounds de mundo só de quem mudou (inclui filhos de quem se moveu).
+        // Os itens da BVH são as posições no pool de WorldBounds, que só
+        // mudam junto com renderOrderDirty (e aí a BVH é reconstruída).
+        ComponentPool<WorldBoundsComponent>& bounds = registry.pool<WorldBoundsComponent>();
+        const std::vector<Entity*>& changed = graph.getChangedThisFrame();
+        const auto transformBounds = [&](std::size_t first, std::size_t last) {
+            for (std::size_t k = first; k < last; ++k) {
+                const EntityId id = changed[k]->getId();
+                if (WorldBoundsComponent* box = bounds.tryGet(id)) {
+                    const MeshRendererComponent& renderer = registry.get<MeshRendererComponent>(id);
+                    *box = renderer.mesh->getBounds().transformed(registry.get<WorldTransformComponent>(id).world);
+                }
+            }
+        };
+        if (jobs) {
+            jobs->parallelFor(0, changed.size(), BOUNDS_GRAIN, transformBounds);
+        } else {
+            transformBounds(0, changed.size());
+        }
+
+        // A lista de sujos da BVH não é thread-safe: essa parte fica serial
+        if (!renderOrderDirty) {
+            for (Entity* entity : changed) {
+                const EntityId id = entity->getId();
+                if (const WorldBoundsComponent* box = bounds.tryGet(id)) {
+                    bvh.update(bounds.indexOf(id), *box);
+                }
+            }
+        }
+
+        // Mantém os WorldTransform dos renderizáveis na mesma ordem do pool de
+        // MeshRenderer, para a view de renderização andar pelos dois em paralelo
+        if (renderOrderDirty) {
+            registry.arrangeLike<WorldTransformComponent, MeshRendererComponent>();
+            registry.arrangeLike<Material, MeshRendererComponent>();
+            registry.arrangeLike<WorldBoundsComponent, MeshRendererComponent>();
+            bvh.build(bounds.components());
+            renderOrderDirty = false;
+        } else {
+            // Refit só do caminho de quem se moveu; reconstrói quando a
+            // topologia antiga ficou cara demais para as posições atuais
+            bvh.refit();
+            if (bvh.cost() > BVH_REBUILD_RATIO * bvh.build_cost()) {
+                bvh.build(bounds.components());
+            }
+        }
+    }
+
+    // Coleta os renderizáveis cuja caixa de mundo toca o frustum, antes de
+    // qualquer chamada GL. Desce pela BVH, então o custo acompanha o que
+    // está na tela e não o tamanho da cena. Chamar depois de
+    // updateTransforms(); retorna quantos ficaram visíveis.
+    std::size_t cullRenderables(const alg::Frustum& frustum) {
+        visibleItems.clear();
+        bvh.query_frustum(frustum, [&](std::uint32_t item) { visibleItems.push_back(item); });
+        return visibleItems.size();
+    }
+
+    // Copia os visíveis do último cullRenderables() para uma lista de draws
+    // independente da cena (em paralelo, com jobs)
+    void buildRenderList(std::vector<DrawItem>& draws, JobSystem* jobs = nullptr) {
+        const std::vector<EntityId>& ids = registry.pool<WorldBoundsComponent>().entities();
+        ComponentPool<MeshRendererComponent>& renderers = registry.pool<MeshRendererComponent>();
+        ComponentPool<WorldTransformComponent>& transforms = registry.pool<WorldTransformComponent>();
+        ComponentPool<Material>& materials = registry.pool<Material>();
+        const std::vector<WorldBoundsComponent>& bounds = registry.pool<WorldBoundsComponent>().components();
 
-        if (auto camera = std::dynamic_pointer_cast<CameraEntity>(entity)) {
-            cameras.push_back(camera);
+        draws.resize(visibleItems.size());
+        const auto fill = [&](std::size_t first, std::size_t last) {
+            for (std::size_t k = first; k < last; ++k) {
+                DrawItem& draw = draws[k];
+                draw.mesh = nullptr;
+                const std::uint32_t i = visibleItems[k];
+                if (i >= ids.size()) continue;
+                const EntityId id = ids[i];
+                const MeshRendererComponent* renderer = renderers.findNear(i, id);
+                const WorldTransformComponent* transform = transforms.findNear(i, id);
+                const Material* material = materials.findNear(i, id);
+                if (!renderer || !transform || !material) continue;
+
+                draw.mesh = renderer->mesh.get();
+                draw.shader = renderer->shader.get();
+                draw.texture = material->diffuseTexture.get();
+                draw.shaderId = draw.shader->ID;
+                draw.textureId = draw.texture ? draw.texture->getID() : 0;
+                draw.meshId = draw.mesh->getVAO();
+                draw.transparent = material->transparent;
+                // O buffer de materiais espelha o pool (collectMaterialUpdates)
+                draw.material = static_cast<std::uint32_t>(material - materials.begin());
+                draw.model = transform->world;
+                draw.normal = transform->normal;
+                draw.bounds = bounds[i];
+            }
+        };
+        if (jobs) {
+            jobs->parallelFor(0, draws.size(), RENDER_LIST_GRAIN, fill);
+        } else {
+            fill(0, draws.size());
+        }
+
+        // Itens sem todos os componentes (raro) saem da lista
+        draws.erase(std::remove_if(draws.begin(), draws.end(), [](const DrawItem& draw) { return !draw.mesh; }),
+                    draws.end());
+    }
+
+    // Todas as luzes, já em espaço de mundo (os clusters ou a escolha por
+    // draw decidem quais o shader usa)
+    void collectLights(std::vector<FrameLight>& lights) {
+        lights.clear();
+        registry.view<LightComponent, TransformComponent, WorldTransformComponent>().each(
+            [&](EntityId, const LightComponent& light, const TransformComponent& transform,
+                const WorldTransformComponent& world) {
+                lights.push_back(makeFrameLight(light, transform, world));
+            });
+    }
+
+    // Materiais a reenviar: o buffer de materiais da GPU segue a ordem do
+    // pool de Material, e uma posição muda quando o material dela foi
+    // editado (version) ou quando outro material foi movido para lá (remoção
+    // no pool). Como cada lista é aplicada uma vez e na ordem dos frames, a
+    // cópia da GPU fica igual ao pool.
+    void collectMaterialUpdates(std::vector<MaterialUpdate>& updates, std::uint32_t& materialCount) {
+        ComponentPool<Material>& materials = registry.pool<Material>();
+        const std::vector<EntityId>& owners = materials.entities();
+
+        updates.clear();
+        materialCount = static_cast<std::uint32_t>(owners.size());
+        uploadedMaterials.resize(owners.size());
+        for (std::uint32_t slot = 0; slot < owners.size(); ++slot) {
+            const Material& material = materials.begin()[slot];
+            UploadedMaterial& uploaded = uploadedMaterials[slot];
+            if (uploaded.owner == owners[slot] && uploaded.version == material.version) {
+                continue;
+            }
+            uploaded.owner = owners[slot];
+            uploaded.version = material.version;
+
+            MaterialUpdate update;
+            update.slot = slot;
+            update.data.ambientShininess = alg::Vec4(material.ambient.x, material.ambient.y, material.ambient.z, material.shininess);
+            update.data.diffuse = alg::Vec4(material.diffuse.x, material.diffuse.y, material.diffuse.z, 0.0f);
+            update.data.specular = alg::Vec4(material.specular.x, material.specular.y, material.specular.z, 0.0f);
+            updates.push_back(update);
+        }
+    }
+
+    // fn(EntityId, MeshRendererComponent&, WorldTransformComponent&, Material&)
+    // para cada renderizável que passou no último cullRenderables()
+    template <class Fn>
+    void eachVisible(Fn&& fn) {
+        const std::vector<EntityId>& ids = registry.pool<WorldBoundsComponent>().entities();
+        ComponentPool<MeshRendererComponent>& renderers = registry.pool<MeshRendererComponent>();
+        ComponentPool<WorldTransformComponent>& transforms = registry.pool<WorldTransformComponent>();
+        ComponentPool<Material>& materials = registry.pool<Material>();
+
+        for (const std::uint32_t i : visibleItems) {
+            if (i >= ids.size()) continue;
+            const EntityId id = ids[i];
+            MeshRendererComponent* renderer = renderers.findNear(i, id);
+            WorldTransformComponent* transform = transforms.findNear(i, id);
+            Material* material = materials.findNear(i, id);
+            if (renderer && transform && material) {
+                fn(id, *renderer, *transform, *material);
+            }
         }
     }
 
-    void addLight(std::shared_ptr<Light> light) {
-        lights.push_back(light);
-        addEntity(light);
+    // Resultado do último cullRenderables()
+    std::size_t getVisibleCount() const { return visibleItems.size(); }
+    std::size_t getRenderableCount() const { return bvh.size(); }
+
+    // Renderizável mais próximo ao longo de um raio em mundo: a BVH da cena
+    // filtra pelas caixas e só as malhas atravessadas pelo raio são testadas
+    // triângulo a triângulo (em espaço do modelo). nullptr se não acertar nada.
+    std::shared_ptr<Entity> pick(const alg::Ray& ray) {
+        constexpr float INF = std::numeric_limits<float>::infinity();
+        const alg::Bvh::RayHit hit = bvh.raycast(ray, INF, [&](std::uint32_t item) {
+            const EntityId id = renderableAt(item);
+            if (id == NULL_ENTITY) return INF;
+            MeshRendererComponent& renderer = registry.get<MeshRendererComponent>(id);
+            const alg::Mat4 toLocal = registry.get<WorldTransformComponent>(id).world.affine_inverse();
+            // Direção sem normalizar: o t do raio local é o mesmo do raio de mundo
+            const alg::Ray local(toLocal * ray.origin, (toLocal * alg::Vec4(ray.direction, 0.0f)).xyz());
+            float t;
+            return renderer.mesh->raycast(local, t) ? t : INF;
+        });
+        if (hit.item == alg::Bvh::NONE) return nullptr;
+        return find(renderableAt(hit.item));
     }
 
-    void setupLightsInShader(Shader& shader) {
-        int MAX_LIGHTS = 8;
-        int lightCount = std::min((int)lights.size(), MAX_LIGHTS);
-        shader.setInt("activeLightCount", lightCount);
+    // BVH dos renderizáveis (caixas de mundo), válida a partir do último
+    // updateTransforms(). Para picking e consultas espaciais; os itens
+    // viram entidades com renderableAt(), que dá NULL_ENTITY se renderizáveis
+    // foram criados ou destruídos desde então.
+    const alg::Bvh& getBvh() const { return bvh; }
+    EntityId renderableAt(std::uint32_t item) {
+        const std::vector<EntityId>& ids = registry.pool<WorldBoundsComponent>().entities();
+        if (renderOrderDirty || item >= ids.size()) return NULL_ENTITY;
+        return ids[item];
+    }
+
+    // Entidades cuja matriz de mundo mudou neste frame (válido até o próximo updateTransforms)
+    const std::vector<Entity*>& getChangedThisFrame() const { return graph.getChangedThisFrame(); }
+
+    // Seleciona para o painel Properties (nullptr limpa a seleção). Se for
+    // uma câmera, também a torna ativa.
+    void selectEntity(Entity* entity) {
+        selectedEntity = entity ? find(entity->getId()) : nullptr;
 
-        for (int i = 0; i < lightCount; i++) {
-            lights[i]->setupInShader(shader, i);
+        // Só CameraEntity tem CameraComponent
+        if (entity && registry.has<CameraComponent>(entity->getId())) {
+            activeCamera = std::static_pointer_cast<CameraEntity>(selectedEntity);
         }
     }
 
     void setActiveCamera(std::shared_ptr<CameraEntity> camera) {
-        if (activeCamera) activeCamera->isActive = false;
+        if (activeCamera) activeCamera->setActive(false);
         activeCamera = camera;
-        camera->isActive = true;
+        camera->setActive(true);
     }
     void drawSceneUI() {
         ImGui::Begin("Scene Hierarchy");
 
-        for (auto& entity : entities) {
-            bool isSelected = (selectedEntity == entity);
-            if (ImGui::Selectable(entity->name.c_str(), isSelected)) {
-                selectedEntity = entity;
-
-                // Se for uma câmera, também a torna ativa
-                if (auto camera = std::dynamic_pointer_cast<CameraEntity>(entity)) {
-                    activeCamera = camera;
-                }
-            }
+        Entity* dragChild = nullptr;
+        Entity* dragParent = nullptr;
+        for (Entity* root : graph.getRoots()) {
+            drawHierarchyNode(root, dragChild, dragParent);
+        }
+        if (dragChild) {
+            graph.setParent(dragChild, dragParent);
         }
 
         ImGui::End();
@@ -76,9 +377,76 @@ public:
             // Mostra UI genérica para qualquer entidade
             selectedEntity->drawUI();
 
+            if (ImGui::Button("Delete")) {
+                destroy(selectedEntity);
+            }
 
+            if (selectedEntity->getParent()) {
+                ImGui::Separator();
+                ImGui::Text("Parent: %s", selectedEntity->getParent()->name.c_str());
+                if (ImGui::Button("Detach from parent")) {
+                    graph.setParent(selectedEntity.get(), nullptr);
+                }
+            }
         }
 
         ImGui::End();
     }
+
+private:
+    static constexpr std::uint32_t NO_SLOT = std::numeric_limits<std::uint32_t>::max();
+
+    // Desenha um nó da árvore e seus filhos. Arrastar um nó sobre outro
+    // muda o pai; a mudança é aplicada depois de desenhar a árvore inteira.
+    void drawHierarchyNode(Entity* entity, Entity*& dragChild, Entity*& dragParent) {
+        ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_SpanAvailWidth |
+                                   ImGuiTreeNodeFlags_DefaultOpen;
+        if (entity->getChildren().empty()) flags |= ImGuiTreeNodeFlags_Leaf;
+        if (selectedEntity.get() == entity) flags |= ImGuiTreeNodeFlags_Selected;
+
+        const bool open = ImGui::TreeNodeEx(static_cast<void*>(entity), flags, "%s", entity->name.c_str());
+        if (ImGui::IsItemClicked() && !ImGui::IsItemToggledOpen()) {
+            selectEntity(entity);
+        }
+        if (ImGui::BeginDragDropSource()) {
+            ImGui::SetDragDropPayload("SCENE_ENTITY", &entity, sizeof(Entity*));
+            ImGui::Text("%s", entity->name.c_str());
+            ImGui::EndDragDropSource();
+        }
+        if (ImGui::BeginDragDropTarget()) {
+            if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("SCENE_ENTITY")) {
+                dragChild = *static_cast<Entity* const*>(payload->Data);
+                dragParent = entity;
+            }
+            ImGui::EndDragDropTarget();
+        }
+
+        if (open) {
+            for (Entity* child : entity->getChildren()) {
+                drawHierarchyNode(child, dragChild, dragParent);
+            }
+            ImGui::TreePop();
+        }
+    }
+
+    SceneGraph graph;
+    std::vector<std::uint32_t> entitySlot;  // Índice do handle -> posição em entities
+    std::vector<EntityId> pendingDestroy;
+    // Reconstrói a BVH quando o custo SAH depois de refits passa deste múltiplo do custo do build
+    static constexpr float BVH_REBUILD_RATIO = 2.0f;
+    // Caixas por job em updateTransforms (menos que isso roda em série)
+    static constexpr std::size_t BOUNDS_GRAIN = 512;
+    static constexpr std::size_t RENDER_LIST_GRAIN = 1024;
+    alg::Bvh bvh;                           // Itens = posições no pool de WorldBoundsComponent
+    std::vector<std::uint32_t> visibleItems;
+    bool renderOrderDirty = false;
+    std::vector<MeshRendererComponent> retiredRenderers; // Veja flushDestroyed
+    std::vector<Material> retiredMaterials;
+
+    // Último conteúdo enviado de cada posição do buffer de materiais
+    struct UploadedMaterial {
+        EntityId owner = NULL_ENTITY;
+        std::uint32_t version = 0;
+    };
+    std::vector<UploadedMaterial> uploadedMaterials;
 };
\ No newline at end of file
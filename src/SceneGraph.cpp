@@ -0,0 +1,205 @@
+#include "SceneGraph.hpp"
+#include "Entity.hpp"
+#include "JobSystem.hpp"
+
+#include <algorithm>
+
+SceneGraph::~SceneGraph() {
+    // Anda pela hierarquia e não por order, que pode ainda conter entidades
+    // removidas (e já destruídas) desde o último update()
+    std::vector<Entity*> stack(roots.begin(), roots.end());
+    while (!stack.empty()) {
+        Entity* entity = stack.back();
+        stack.pop_back();
+        entity->graph = nullptr;
+        entity->graphIndex = -1;
+        entity->pendingIndex = -1;
+        stack.insert(stack.end(), entity->children.begin(), entity->children.end());
+    }
+}
+
+// Swap-and-pop de entity na lista de irmãos atual
+void SceneGraph::unlinkSibling(std::vector<Entity*>& siblings, Entity* entity) {
+    Entity* moved = siblings.back();
+    siblings[entity->siblingIndex] = moved;
+    moved->siblingIndex = entity->siblingIndex;
+    siblings.pop_back();
+}
+
+void SceneGraph::add(Entity* entity) {
+    entity->graph = this;
+    entity->graphIndex = -1;
+    entity->parent = nullptr;
+    entity->siblingIndex = static_cast<int>(roots.size());
+    roots.push_back(entity);
+    orderDirty = true;
+    entity->pendingIndex = -1;
+    entity->markDirty();
+}
+
+void SceneGraph::enqueue(Entity* entity) {
+    entity->pendingIndex = static_cast<int>(pending.size());
+    pending.push_back(entity);
+}
+
+void SceneGraph::remove(Entity* entity) {
+    if (entity->graph != this) {
+        return;
+    }
+    unlinkSibling(entity->parent ? entity->parent->children : roots, entity);
+
+    if (entity->pendingIndex >= 0) {
+        Entity* moved = pending.back();
+        pending[entity->pendingIndex] = moved;
+        moved->pendingIndex = entity->pendingIndex;
+        pending.pop_back();
+    }
+
+    entity->parent = nullptr;
+    entity->siblingIndex = -1;
+    entity->graph = nullptr;
+    entity->graphIndex = -1;
+    entity->pendingIndex = -1;
+    orderDirty = true;
+}
+
+bool SceneGraph::setParent(Entity* child, Entity* parent) {
+    if (child->graph != this || (parent && parent->graph != this)) {
+        return false;
+    }
+    for (Entity* p = parent; p; p = p->parent) {
+        if (p == child) {
+            return false;
+        }
+    }
+    if (child->parent == parent) {
+        return true;
+    }
+
+    unlinkSibling(child->parent ? child->parent->children : roots, child);
+
+    std::vector<Entity*>& newSiblings = parent ? parent->children : roots;
+    child->siblingIndex = static_cast<int>(newSiblings.size());
+    newSiblings.push_back(child);
+    child->parent = parent;
+
+    // O local não muda, mas o mundo sim: a subárvore toda é recalculada
+    orderDirty = true;
+    child->markDirty();
+    return true;
+}
+
+void SceneGraph::linearize() {
+    std::vector<Entity*> newOrder;
+    newOrder.reserve(order.size() + pending.size());
+    newOrder.insert(newOrder.end(), roots.begin(), roots.end());
+    levelEnd.clear();
+    std::size_t currentLevelEnd = newOrder.size();
+    for (std::size_t i = 0; i < newOrder.size(); ++i) {
+        if (i == currentLevelEnd) {
+            levelEnd.push_back(currentLevelEnd);
+            currentLevelEnd = newOrder.size();
+        }
+        const std::vector<Entity*>& children = newOrder[i]->children;
+        newOrder.insert(newOrder.end(), children.begin(), children.end());
+    }
+    if (!newOrder.empty()) {
+        levelEnd.push_back(newOrder.size());
+    }
+
+    // Leva as matrizes já calculadas para as novas posições; nós novos
+    // entram na fila (já estão em pending via add())
+    const std::size_t n = newOrder.size();
+    std::vector<alg::Mat4> newWorld(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const int old = newOrder[i]->graphIndex;
+        if (old >= 0) {
+            newWorld[i] = world[old];
+        }
+    }
+
+    parentIndex.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        newOrder[i]->graphIndex = static_cast<int>(i);
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        const Entity* parent = newOrder[i]->parent;
+        parentIndex[i] = parent ? parent->graphIndex : -1;
+    }
+
+    order.swap(newOrder);
+    world.swap(newWorld);
+    dirtyStamp.assign(n, 0);
+    frameStamp = 0;
+    orderDirty = false;
+}
+
+void SceneGraph::update(JobSystem* jobs) {
+    changedThisFrame.clear();
+    if (orderDirty) {
+        linearize();
+    }
+    if (pending.empty()) {
+        return; // Cena estática: nenhum trabalho
+    }
+
+    ++frameStamp;
+    std::size_t first = order.size();
+    for (Entity* entity : pending) {
+        entity->pendingIndex = -1;
+        const std::size_t index = static_cast<std::size_t>(entity->graphIndex);
+        dirtyStamp[index] = frameStamp;
+        first = std::min(first, index);
+    }
+    pending.clear();
+
+    // Passada linear a partir do primeiro nó sujo: um nó é recalculado se
+    // ele ou o pai (que vem antes na ordem BFS) foi recalculado neste update.
+    // Aqui só se marca; as matrizes vêm depois, nível a nível.
+    for (std::size_t i = first; i < order.size(); ++i) {
+        const int p = parentIndex[i];
+        if (p >= 0 && dirtyStamp[p] == frameStamp) {
+            dirtyStamp[i] = frameStamp;
+        }
+        if (dirtyStamp[i] == frameStamp) {
+            changedThisFrame.push_back(order[i]);
+        }
+    }
+
+    // changedThisFrame está em ordem BFS, então cada nível é um trecho
+    // contíguo dela; dentro de um nível os nós são independentes
+    const auto computeWorld = [this](std::size_t firstChanged, std::size_t lastChanged) {
+        for (std::size_t k = firstChanged; k < lastChanged; ++k) {
+            Entity* entity = changedThisFrame[k];
+            const std::size_t i = static_cast<std::size_t>(entity->graphIndex);
+            const int p = parentIndex[i];
+            const alg::Mat4& local = entity->getLocalMatrix();
+            world[i] = p >= 0 ? world[p] * local : local;
+
+            // Cópia densa no Registry, lida pelas views de renderização
+            WorldTransformComponent& component = entity->world();
+            component.world = world[i];
+            component.normal = world[i].normal_matrix();
+        }
+    };
+
+    // Abaixo disso o custo de distribuir é maior que o das matrizes
+    constexpr std::size_t PARALLEL_GRAIN = 256;
+    std::size_t levelBegin = 0;
+    for (const std::size_t end : levelEnd) {
+        std::size_t levelStop = levelBegin;
+        while (levelStop < changedThisFrame.size() &&
+               static_cast<std::size_t>(changedThisFrame[levelStop]->graphIndex) < end) {
+            ++levelStop;
+        }
+        if (jobs) {
+            jobs->parallelFor(levelBegin, levelStop, PARALLEL_GRAIN, computeWorld);
+        } else {
+            computeWorld(levelBegin, levelStop);
+        }
+        levelBegin = levelStop;
+        if (levelBegin == changedThisFrame.size()) {
+            break;
+        }
+    }
+}
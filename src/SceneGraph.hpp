@@ -0,0 +1,79 @@
+#ifndef SCENEGRAPH_HPP
+#define SCENEGRAPH_HPP
+
+#include <cstdint>
+#include <vector>
+#include "algebra.hpp"
+
+class Entity;
+class JobSystem;
+
+// Hierarquia de transforms de uma Scene.
+//
+// Os links pai/filho ficam nas próprias entidades; aqui ficam as matrizes
+// de mundo, linearizadas em ordem BFS (o pai sempre vem antes dos filhos).
+// Assim a propagação é uma única passada linear que começa no primeiro nó
+// sujo: ao chegar num nó, a matriz do pai já está atualizada. As matrizes
+// recalculadas também são copiadas para o WorldTransformComponent de cada
+// entidade, que é o que as views de renderização leem.
+//
+// Reparentar e remover são O(1) (swap-and-pop na lista de irmãos); a ordem
+// BFS só é reconstruída uma vez, no próximo update(), não importa quantas
+// mudanças de hierarquia aconteceram no frame.
+//
+// Com um JobSystem, as matrizes de cada nível da hierarquia são calculadas
+// em paralelo: os pais estão todos em níveis anteriores, já prontos.
+class SceneGraph {
+public:
+    SceneGraph() = default;
+    ~SceneGraph();
+
+    // As entidades guardam ponteiro para o grafo
+    SceneGraph(const SceneGraph&) = delete;
+    SceneGraph& operator=(const SceneGraph&) = delete;
+
+    // Adiciona uma entidade como raiz
+    void add(Entity* entity);
+
+    // Muda o pai de child (nullptr = vira raiz), mantendo o transform local.
+    // Retorna false se parent for child ou um descendente dele (ciclo).
+    bool setParent(Entity* child, Entity* parent);
+
+    // Tira a entidade do grafo. Os filhos precisam ser removidos também ou
+    // reparentados antes do próximo update() (a Scene remove a subárvore).
+    void remove(Entity* entity);
+
+    // Recalcula as matrizes de mundo de tudo que mudou desde a última chamada
+    void update(JobSystem* jobs = nullptr);
+
+    // Chamado por Entity::markDirty
+    void enqueue(Entity* entity);
+
+    const std::vector<Entity*>& getRoots() const { return roots; }
+
+    // Entidades cuja matriz de mundo mudou no último update() (inclui os
+    // descendentes de quem foi alterado)
+    const std::vector<Entity*>& getChangedThisFrame() const { return changedThisFrame; }
+
+    const alg::Mat4& worldMatrix(int index) const { return world[index]; }
+
+private:
+    void linearize();
+    static void unlinkSibling(std::vector<Entity*>& siblings, Entity* entity);
+
+    std::vector<Entity*> roots;
+
+    // Ordem BFS; os vetores abaixo são paralelos a order
+    std::vector<Entity*> order;
+    std::vector<int> parentIndex;          // -1 para raízes
+    std::vector<std::size_t> levelEnd;     // Fim (exclusivo) de cada nível em order
+    std::vector<alg::Mat4> world;
+    std::vector<std::uint32_t> dirtyStamp; // == frameStamp: mundo recalculado neste update
+
+    std::vector<Entity*> pending;          // Preenchida pelas entidades via markDirty()
+    std::vector<Entity*> changedThisFrame;
+    std::uint32_t frameStamp = 0;
+    bool orderDirty = false;
+};
+
+#endif // SCENEGRAPH_HPP
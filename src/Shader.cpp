@@ -1,8 +1,10 @@
 #include "Shader.hpp"
+#include "FrameUniforms.hpp"
 #include <glad/glad.h>
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <algorithm>
 
 Shader::Shader(const char* vertexPath, const char* fragmentPath) {
     // 1. Obter o código-fonte dos shaders a partir dos caminhos
@@ -61,6 +63,16 @@ Shader::Shader(const char* vertexPath, const char* fragmentPath) {
     glLinkProgram(ID);
     checkCompileErrors(ID, "PROGRAM");
 
+    reflectUniforms();
+
+    // Blocos por frame nos binding points fixos (o GLSL 330 não tem layout(binding))
+    for (const UniformBlockBinding& block : FRAME_UNIFORM_BLOCKS) {
+        const GLuint index = glGetUniformBlockIndex(ID, block.name);
+        if (index != GL_INVALID_INDEX) {
+            glUniformBlockBinding(ID, index, block.binding);
+        }
+    }
+
     // Deletar os shaders pois eles já estão linkados no nosso programa e não são mais necessários
     glDeleteShader(vertex);
     glDeleteShader(fragment);
@@ -70,39 +82,111 @@ void Shader::use() const {
     glUseProgram(ID);
 }
 
-void Shader::setBool(const std::string &name, bool value) const {
-    glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value);
+void Shader::reflectUniforms() {
+    GLint count = 0;
+    GLint maxLength = 0;
+    glGetProgramiv(ID, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+    // Arrays aparecem uma vez só, como "nome[0]": entram "nome" e cada "nome[i]"
+    std::size_t capacity = 16;
+    while (capacity < static_cast<std::size_t>(count) * 4) capacity *= 2;
+    uniformSlots.assign(capacity, UniformSlot{});
+    uniformSlotCount = 0;
+
+    std::string name(static_cast<std::size_t>(std::max(maxLength, 1)), '\0');
+    for (GLint i = 0; i < count; ++i) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(ID, static_cast<GLuint>(i), maxLength, &length, &size, &type, name.data());
+        const std::string_view fullName(name.data(), static_cast<std::size_t>(length));
+
+        const GLint location = glGetUniformLocation(ID, name.c_str());
+        if (location < 0) {
+            continue; // Dentro de um uniform block
+        }
+
+        const bool isArray = fullName.size() > 3 && fullName.substr(fullName.size() - 3) == "[0]";
+        if (!isArray) {
+            insertUniform(UniformName::runtime(fullName).hash, location);
+            continue;
+        }
+        const std::string_view baseName = fullName.substr(0, fullName.size() - 3);
+        insertUniform(UniformName::runtime(baseName).hash, location);
+        for (GLint element = 0; element < size; ++element) {
+            const std::string elementName = std::string(baseName) + "[" + std::to_string(element) + "]";
+            insertUniform(UniformName::runtime(elementName).hash, glGetUniformLocation(ID, elementName.c_str()));
+        }
+    }
 }
 
-void Shader::setInt(const std::string &name, int value) const {
-    glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
+void Shader::insertUniform(std::uint64_t hash, int location) {
+    if (hash == 0) hash = 1;
+    const std::size_t mask = uniformSlots.size() - 1;
+    std::size_t slot = static_cast<std::size_t>(hash) & mask;
+    while (uniformSlots[slot].hash != 0 && uniformSlots[slot].hash != hash) {
+        slot = (slot + 1) & mask;
+    }
+    if (uniformSlots[slot].hash == 0 && 2 * (uniformSlotCount + 1) > uniformSlots.size()) {
+        // Carga acima de 1/2: dobra e reinsere
+        std::vector<UniformSlot> old = std::move(uniformSlots);
+        uniformSlots.assign(old.size() * 2, UniformSlot{});
+        uniformSlotCount = 0;
+        for (const UniformSlot& entry : old) {
+            if (entry.hash != 0) insertUniform(entry.hash, entry.location);
+        }
+        insertUniform(hash, location);
+        return;
+    }
+    uniformSlotCount += uniformSlots[slot].hash == 0;
+    uniformSlots[slot] = UniformSlot{hash, location};
 }
 
-void Shader::setFloat(const std::string &name, float value) const {
-    glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
+UniformHandle Shader::uniform(UniformName name) const {
+    const std::uint64_t hash = name.hash != 0 ? name.hash : 1;
+    if (uniformSlots.empty()) {
+        return UniformHandle{};
+    }
+    const std::size_t mask = uniformSlots.size() - 1;
+    for (std::size_t slot = static_cast<std::size_t>(hash) & mask;; slot = (slot + 1) & mask) {
+        if (uniformSlots[slot].hash == hash) return UniformHandle{uniformSlots[slot].location};
+        if (uniformSlots[slot].hash == 0) return UniformHandle{};
+    }
 }
 
-void Shader::setVec3(const std::string &name, const alg::Vec3 &value) const {
-    glUniform3fv(glGetUniformLocation(ID, name.c_str()), 1, &value.x);
+void Shader::setBool(UniformHandle handle, bool value) const {
+    if (handle.isValid()) glUniform1i(handle.location, (int)value);
 }
 
-// Em Shader.cpp
-void Shader::setMat4(const std::string &name, const alg::Mat4 &mat) const {
-    // Pega a localização do uniform
-    int location = glGetUniformLocation(ID, name.c_str());
-
-    // --- LINHA DE DIAGNÓSTICO ---
-    // Se a localização for -1, significa que o shader não encontrou o uniform.
-    if (location == -1) {
-        static std::set<std::string> warned_uniforms;
-        if (warned_uniforms.find(name) == warned_uniforms.end()) {
-            std::cerr << "AVISO: Uniform '" << name << "' nao encontrado no shader!" << std::endl;
-            warned_uniforms.insert(name);
-        }
+void Shader::setInt(UniformHandle handle, int value) const {
+    if (handle.isValid()) glUniform1i(handle.location, value);
+}
+
+void Shader::setFloat(UniformHandle handle, float value) const {
+    if (handle.isValid()) glUniform1f(handle.location, value);
+}
+
+void Shader::setVec3(UniformHandle handle, const alg::Vec3 &value) const {
+    if (handle.isValid()) glUniform3fv(handle.location, 1, &value.x);
+}
+
+void Shader::setMat4(UniformHandle handle, const alg::Mat4 &mat) const {
+    if (handle.isValid()) glUniformMatrix4fv(handle.location, 1, GL_FALSE, mat.m);
+}
+
+void Shader::setMat4(UniformName name, const alg::Mat4 &mat) const {
+    const UniformHandle handle = uniform(name);
+
+    // --- DIAGNÓSTICO ---
+    // Se não há location, o shader não tem (ou não usa) esse uniform.
+    if (!handle.isValid() &&
+        std::find(warnedUniforms.begin(), warnedUniforms.end(), name.hash) == warnedUniforms.end()) {
+        std::cerr << "AVISO: Uniform '" << (name.text ? name.text : "?") << "' nao encontrado no shader!" << std::endl;
+        warnedUniforms.push_back(name.hash);
     }
 
-    // Envia os dados para a GPU
-    glUniformMatrix4fv(location, 1, GL_FALSE, mat.m);
+    setMat4(handle, mat);
 }
 
 void Shader::checkCompileErrors(unsigned int shader, std::string type) {
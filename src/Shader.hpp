@@ -1,10 +1,46 @@
 #ifndef SHADER_HPP
 #define SHADER_HPP
 
+#include <cstdint>
 #include <string>
-#include <set>
+#include <string_view>
+#include <vector>
 #include "algebra.hpp" // Para usar nossas classes Vec3 e Mat4
 
+// FNV-1a de 64 bits; continuável (hash de "ab" = hashAppend(hash de "a", "b"))
+constexpr std::uint64_t UNIFORM_HASH_SEED = 14695981039346656037ull;
+constexpr std::uint64_t hashAppend(std::uint64_t hash, std::string_view text) noexcept {
+    for (const char c : text) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// Nome de uniform já em hash. De um literal, o hash sai em tempo de
+// compilação (construtor consteval); de uma string montada em runtime, só
+// com UniformName::runtime().
+class UniformName {
+public:
+    consteval UniformName(const char* name) : hash(hashAppend(UNIFORM_HASH_SEED, name)), text(name) {}
+
+    static constexpr UniformName fromHash(std::uint64_t hash) { return UniformName(hash); }
+    static constexpr UniformName runtime(std::string_view name) { return fromHash(hashAppend(UNIFORM_HASH_SEED, name)); }
+
+    std::uint64_t hash;
+    const char* text; // Só para mensagens; nullptr se não veio de um literal
+
+private:
+    constexpr explicit UniformName(std::uint64_t hash) : hash(hash), text(nullptr) {}
+};
+
+// Location já resolvida; -1 se o uniform não existe (ou foi removido pelo
+// compilador por não ser usado), e aí os set() não fazem nada
+struct UniformHandle {
+    int location = -1;
+    bool isValid() const { return location >= 0; }
+};
+
 class Shader {
 public:
     // O ID do programa de shader
@@ -16,14 +52,40 @@ public:
     // Ativa o shader para uso
     void use() const;
 
+    // Location de um uniform ativo, de uma tabela montada uma vez depois
+    // do link (sem glGetUniformLocation nem strings). Para caminhos
+    // quentes, resolva uma vez e guarde o handle.
+    UniformHandle uniform(UniformName name) const;
+
     // Funções para definir uniforms (variáveis globais nos shaders)
-    void setBool(const std::string &name, bool value) const;
-    void setInt(const std::string &name, int value) const;
-    void setFloat(const std::string &name, float value) const;
-    void setVec3(const std::string &name, const alg::Vec3 &value) const;
-    void setMat4(const std::string &name, const alg::Mat4 &mat) const;
+    void setBool(UniformHandle handle, bool value) const;
+    void setInt(UniformHandle handle, int value) const;
+    void setFloat(UniformHandle handle, float value) const;
+    void setVec3(UniformHandle handle, const alg::Vec3 &value) const;
+    void setMat4(UniformHandle handle, const alg::Mat4 &mat) const;
+
+    // Pelo nome: uma busca na tabela por chamada
+    void setBool(UniformName name, bool value) const { setBool(uniform(name), value); }
+    void setInt(UniformName name, int value) const { setInt(uniform(name), value); }
+    void setFloat(UniformName name, float value) const { setFloat(uniform(name), value); }
+    void setVec3(UniformName name, const alg::Vec3 &value) const { setVec3(uniform(name), value); }
+    void setMat4(UniformName name, const alg::Mat4 &mat) const;
 
 private:
+    // Tabela hash aberta (sondagem linear) de hash do nome -> location;
+    // hash 0 marca slot vazio
+    struct UniformSlot {
+        std::uint64_t hash = 0;
+        int location = -1;
+    };
+    std::vector<UniformSlot> uniformSlots; // Tamanho potência de 2
+    std::size_t uniformSlotCount = 0;      // Slots ocupados
+    mutable std::vector<std::uint64_t> warnedUniforms; // Ausentes já avisados
+
+    // Lê os uniforms ativos do programa linkado
+    void reflectUniforms();
+    void insertUniform(std::uint64_t hash, int location);
+
     // Função utilitária para checar erros de compilação/linkagem
     void checkCompileErrors(unsigned int shader, std::string type);
 };
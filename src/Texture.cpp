@@ -7,7 +7,27 @@
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 
-Texture::Texture(const char* path) {
+Texture::Texture(const char* path) : Texture(decode(path)) {}
+
+void TextureImage::PixelDeleter::operator()(unsigned char* pixels) const {
+    stbi_image_free(pixels);
+}
+
+TextureImage Texture::decode(const char* path) {
+    TextureImage image;
+    image.path = path;
+
+    // Inverte a imagem no eixo Y durante o carregamento, pois o OpenGL espera as coordenadas de baixo para cima
+    // (flag por thread: a decodificação pode rodar nos workers)
+    stbi_set_flip_vertically_on_load_thread(true);
+
+    // Carrega a imagem do disco
+    image.pixels.reset(stbi_load(path, &image.width, &image.height, &image.channels, 0));
+    return image;
+}
+
+Texture::Texture(const TextureImage& image)
+    : m_width(image.width), m_height(image.height), m_nrChannels(image.channels) {
     // Gera e vincula o objeto de textura
     glGenTextures(1, &m_ID);
     glBindTexture(GL_TEXTURE_2D, m_ID);
@@ -18,29 +38,21 @@ Texture::Texture(const char* path) {
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-    // Inverte a imagem no eixo Y durante o carregamento, pois o OpenGL espera as coordenadas de baixo para cima
-    stbi_set_flip_vertically_on_load(true);
-
-    // Carrega a imagem do disco
-    unsigned char* data = stbi_load(path, &m_width, &m_height, &m_nrChannels, 0);
-    if (data) {
+    if (image.pixels) {
         // Determina o formato da imagem (RGB ou RGBA com transparência)
         GLenum format = GL_RGB;
         if (m_nrChannels == 4) {
             format = GL_RGBA;
         }
 
-        std::cout << "SUCESSO: Textura carregada - " << path << " (" << m_width << "x" << m_height << ", " << m_nrChannels << " canais)" << std::endl;
+        std::cout << "SUCESSO: Textura carregada - " << image.path << " (" << m_width << "x" << m_height << ", " << m_nrChannels << " canais)" << std::endl;
         
         // Envia os dados da imagem para a GPU
-        glTexImage2D(GL_TEXTURE_2D, 0, format, m_width, m_height, 0, format, GL_UNSIGNED_BYTE, data);
+        glTexImage2D(GL_TEXTURE_2D, 0, format, m_width, m_height, 0, format, GL_UNSIGNED_BYTE, image.pixels.get());
         glGenerateMipmap(GL_TEXTURE_2D);
     } else {
-        std::cerr << "ERRO: Falha ao carregar a textura no caminho: " << path << std::endl;
+        std::cerr << "ERRO: Falha ao carregar a textura no caminho: " << image.path << std::endl;
     }
-
-    // Libera a memória da imagem da CPU, pois ela já está na GPU
-    stbi_image_free(data);
 }
 
 Texture::Texture(unsigned int existingID)
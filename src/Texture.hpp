@@ -1,22 +1,44 @@
 #ifndef TEXTURE_HPP
 #define TEXTURE_HPP
 
+#include <memory>
 #include <string>
 
+// Imagem decodificada na CPU, ainda sem objeto GL. A decodificação pode
+// rodar em qualquer thread; o upload (construtor de Texture) precisa da
+// thread que tem o contexto GL.
+struct TextureImage {
+    struct PixelDeleter {
+        void operator()(unsigned char* pixels) const;
+    };
+
+    std::string path;
+    std::unique_ptr<unsigned char, PixelDeleter> pixels;
+    int width = 0, height = 0, channels = 0;
+};
+
 class Texture {
 public:
     // Construtor: carrega a imagem e cria o objeto de textura
     Texture(const char* path);
     Texture(unsigned int existingID);
+    // Envia uma imagem já decodificada (veja decode)
+    explicit Texture(const TextureImage& image);
     // Destrutor
     ~Texture();
 
+    // Lê e decodifica o arquivo (stb_image). Thread-safe; pixels fica
+    // vazio se falhar.
+    static TextureImage decode(const char* path);
+
     // Vincula (ativa) a textura para uso em renderização
     void bind(unsigned int slot = 0) const;
 
+    unsigned int getID() const { return m_ID; }
+
 private:
     unsigned int m_ID;
     int m_width, m_height, m_nrChannels;
 };
 
-#endif //TEXTURE_HPP
\ No newline at end of file
+#endif //TEXTURE_HPP
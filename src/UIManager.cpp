@@ -4,6 +4,7 @@
 #include "imgui_impl_glfw.h"
 #include "imgui_impl_opengl3.h"
 #include "glad/glad.h"
+#include <cstdio>
 #include <iostream>
 #include <memory>
 
@@ -52,6 +53,7 @@ void UIManager::renderUI(Scene& scene) {
 
     ImGui::Begin("Engine Control");
     ImGui::Text("FPS: %.1f", ImGui::GetIO().Framerate);
+    ImGui::Text("Visible: %zu / %zu", scene.getVisibleCount(), scene.getRenderableCount());
 
 
 
@@ -61,3 +63,68 @@ void UIManager::renderUI(Scene& scene) {
     scene.drawSceneUI();
 }
 
+void UIManager::renderJobStats(const JobSystem& jobs) {
+    const std::vector<float>& utilization = jobs.getUtilization();
+    const std::vector<std::uint32_t>& jobCounts = jobs.getJobCounts();
+
+    ImGui::Begin("Jobs");
+    ImGui::Text("Threads: %u", jobs.threadCount());
+    for (std::size_t i = 0; i < utilization.size(); ++i) {
+        char overlay[32];
+        std::snprintf(overlay, sizeof(overlay), "%.0f%% (%u jobs)", utilization[i] * 100.0f, jobCounts[i]);
+        if (i == 0) {
+            ImGui::Text("Main    ");
+        } else {
+            ImGui::Text("Worker %zu", i);
+        }
+        ImGui::SameLine();
+        ImGui::ProgressBar(utilization[i], ImVec2(-1.0f, 0.0f), overlay);
+    }
+    ImGui::End();
+}
+
+void UIManager::renderFrameStats(const FrameGraph& frameGraph, Renderer& renderer) {
+    const Renderer::Stats& renderStats = renderer.getStats();
+    ImGui::Begin("Frame");
+    if (renderer.supportsMultiDrawIndirect()) {
+        bool multiDraw = renderer.isMultiDrawIndirectEnabled();
+        if (ImGui::Checkbox("Multi-draw indirect", &multiDraw)) {
+            renderer.setMultiDrawIndirect(multiDraw);
+        }
+    } else {
+        ImGui::TextDisabled("Multi-draw indirect: not supported");
+    }
+    bool clustered = renderer.isClusteredLightingEnabled();
+    if (ImGui::Checkbox("Clustered lighting", &clustered)) {
+        renderer.setClusteredLighting(clustered);
+    }
+    ImGui::Text("Draws: %u (%u batches, %u instances)", renderStats.draws, renderStats.batches, renderStats.instances);
+    ImGui::Text("State changes: %u (shader %u, texture %u, mesh %u)", renderStats.stateChanges(),
+                renderStats.shaderBinds, renderStats.textureBinds, renderStats.meshBinds);
+    ImGui::Text("Unsorted would be: %u", renderStats.unsortedStateChanges);
+    ImGui::Text("Material uploads: %u", renderStats.materialUploads);
+    if (renderStats.clusterLights > 0) {
+        ImGui::Text("Clustered lights: %u (%u cluster entries)", renderStats.clusterLights, renderStats.clusterIndices);
+    }
+    ImGui::Separator();
+
+    if (ImGui::BeginTable("stages", 3)) {
+        ImGui::TableSetupColumn("Stage");
+        ImGui::TableSetupColumn("Start (ms)");
+        ImGui::TableSetupColumn("Time (ms)");
+        ImGui::TableHeadersRow();
+        for (FrameGraph::TaskId id = 0; id < frameGraph.taskCount(); ++id) {
+            const FrameGraph::TaskTiming& timing = frameGraph.taskTiming(id);
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(frameGraph.taskName(id).c_str());
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", timing.startMs);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", timing.durationMs);
+        }
+        ImGui::EndTable();
+    }
+    ImGui::End();
+}
+
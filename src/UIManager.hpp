@@ -2,6 +2,9 @@
 #define UIMANAGER_HPP
 
 #include "Scene.hpp"
+#include "JobSystem.hpp"
+#include "FrameGraph.hpp"
+#include "Renderer.hpp"
 
 struct GLFWwindow;
 
@@ -16,6 +19,13 @@ class UIManager {
 
     void renderUI(Scene& scene);
 
+    // Janela "Jobs": ocupação de cada thread do pool no último frame
+    void renderJobStats(const JobSystem& jobs);
+
+    // Janela "Frame": início e duração de cada etapa do grafo do frame e
+    // as trocas de estado da última submissão
+    void renderFrameStats(const FrameGraph& frameGraph, Renderer& renderer);
+
 private:
 };
 
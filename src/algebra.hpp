@@ -4,6 +4,9 @@
 #include <iostream>
 #include <cmath>
 #include <cstdio> // For sprintf in Mat4::operator<<
+#include <type_traits> // std::is_constant_evaluated
+#include "simd.hpp"
+#include "fast_math.hpp"
 
 /**
  * @namespace alg
@@ -25,6 +28,7 @@ namespace alg {
 
 // Forward declarations
 struct Vec3;
+struct Vec4;
 struct Mat4;
 struct Quat;
 
@@ -49,7 +53,7 @@ constexpr float PI = 3.14159265359f;
  * This conversion enables intuitive angle specification in degrees
  * while maintaining computational accuracy.
  */
-inline float degrees_to_radians(float degrees) noexcept {
+constexpr float degrees_to_radians(float degrees) noexcept {
     return degrees * PI / 180.0f;
 }
 
@@ -61,7 +65,7 @@ inline float degrees_to_radians(float degrees) noexcept {
  * Useful for human-readable angle representations and UI display
  * after mathematical operations in radians.
  */
-inline float radians_to_degrees(float radians) noexcept {
+constexpr float radians_to_degrees(float radians) noexcept {
     return radians * 180.0f / PI;
 }
 
@@ -79,7 +83,7 @@ inline float radians_to_degrees(float radians) noexcept {
 struct Vec2 {
     float x = 0.0f, y = 0.0f;
 
-    bool operator==(const Vec2& other) const {
+    constexpr bool operator==(const Vec2& other) const {
         return x == other.x && y == other.y;
     }
 
@@ -124,7 +128,7 @@ struct Vec3 {
      * @param other Vector to add
      * @return Reference to modified vector
      */
-    Vec3& operator+=(const Vec3& other) noexcept {
+    constexpr Vec3& operator+=(const Vec3& other) noexcept {
         x += other.x; y += other.y; z += other.z;
         return *this;
     }
@@ -134,7 +138,7 @@ struct Vec3 {
      * @param other Vector to subtract
      * @return Reference to modified vector
      */
-    Vec3& operator-=(const Vec3& other) noexcept {
+    constexpr Vec3& operator-=(const Vec3& other) noexcept {
         x -= other.x; y -= other.y; z -= other.z;
         return *this;
     }
@@ -144,7 +148,7 @@ struct Vec3 {
      * @param scalar Scaling factor
      * @return Reference to modified vector
      */
-    Vec3& operator*=(float scalar) noexcept {
+    constexpr Vec3& operator*=(float scalar) noexcept {
         x *= scalar; y *= scalar; z *= scalar;
         return *this;
     }
@@ -155,29 +159,29 @@ struct Vec3 {
      * @return Reference to modified vector
      * @warning Undefined behavior when scalar == 0
      */
-    Vec3& operator/=(float scalar) {
+    constexpr Vec3& operator/=(float scalar) {
         x /= scalar; y /= scalar; z /= scalar;
         return *this;
     }
 
     // --- Vector Arithmetic Operations (Immutable) ---
-    Vec3 operator+(const Vec3& other) const noexcept {
+    constexpr Vec3 operator+(const Vec3& other) const noexcept {
         return Vec3(x + other.x, y + other.y, z + other.z);
     }
-    Vec3 operator-(const Vec3& other) const noexcept {
+    constexpr Vec3 operator-(const Vec3& other) const noexcept {
         return Vec3(x - other.x, y - other.y, z - other.z);
     }
-    Vec3 operator*(float scalar) const noexcept {
+    constexpr Vec3 operator*(float scalar) const noexcept {
         return Vec3(x * scalar, y * scalar, z * scalar);
     }
-    Vec3 operator/(float scalar) const {
+    constexpr Vec3 operator/(float scalar) const {
         return Vec3(x / scalar, y / scalar, z / scalar);
     }
-    Vec3 operator-() const noexcept {
+    constexpr Vec3 operator-() const noexcept {
         return Vec3(-x, -y, -z);
     }
 
-    bool operator==(const Vec3& other) const {
+    constexpr bool operator==(const Vec3& other) const {
         return x == other.x && y == other.y && z == other.z;
     }
 
@@ -201,7 +205,7 @@ struct Vec3 {
      * Optimization for distance comparisons avoiding sqrt computation.
      * Essential for performance-critical collision detection.
      */
-    float magnitude_squared() const noexcept {
+    constexpr float magnitude_squared() const noexcept {
         return x*x + y*y + z*z;
     }
 
@@ -213,10 +217,7 @@ struct Vec3 {
      * Handles zero-vector case gracefully.
      */
     void normalize() {
-        const float mag = magnitude();
-        if (mag > 0.0f) {
-            *this /= mag;
-        }
+        *this = normalized();
     }
 
     /**
@@ -227,10 +228,18 @@ struct Vec3 {
      * when magnitude is zero to prevent NaN propagation.
      */
     Vec3 normalized() const {
+#if defined(ALG_FAST_MATH)
+        // Multiply by the approximate 1/|v| (see fast::rsqrt) instead of sqrt + divide
+        const float mag_sq = magnitude_squared();
+        if (mag_sq > 0.0f) {
+            return *this * fast::rsqrt(mag_sq);
+        }
+#else
         const float mag = magnitude();
         if (mag > 0.0f) {
             return *this / mag;
         }
+#endif
         return Vec3(0.0f, 0.0f, 0.0f);
     }
 };
@@ -243,7 +252,7 @@ struct Vec3 {
  * @param v Vector to scale
  * @return Scaled vector
  */
-inline Vec3 operator*(float scalar, const Vec3& v) noexcept {
+constexpr Vec3 operator*(float scalar, const Vec3& v) noexcept {
     return v * scalar;
 }
 
@@ -259,7 +268,7 @@ inline Vec3 operator*(float scalar, const Vec3& v) noexcept {
  * - Lighting equations (Lambertian reflectance)
  * - Orthogonality testing
  */
-inline float dot(const Vec3& a, const Vec3& b) noexcept {
+constexpr float dot(const Vec3& a, const Vec3& b) noexcept {
     return a.x * b.x + a.y * b.y + a.z * b.z;
 }
 
@@ -276,7 +285,7 @@ inline float dot(const Vec3& a, const Vec3& b) noexcept {
  * - Torque computation in physics
  * - Building orthonormal bases
  */
-inline Vec3 cross(const Vec3& a, const Vec3& b) noexcept {
+constexpr Vec3 cross(const Vec3& a, const Vec3& b) noexcept {
     return Vec3(
         a.y * b.z - a.z * b.y,
         a.z * b.x - a.x * b.z,
@@ -297,6 +306,51 @@ inline std::ostream& operator<<(std::ostream& os, const Vec3& v) {
     return os;
 }
 
+// =============================================================================
+// Vec4 Struct (Homogeneous 4D Vector)
+// =============================================================================
+
+/**
+ * @struct Vec4
+ * @brief 4-dimensional vector for homogeneous coordinates
+ *
+ * Used where the w-component matters, e.g. clip-space positions
+ * produced by projection matrices before the perspective divide.
+ * Aligned to 16 bytes so it maps onto a single SIMD register.
+ */
+struct alignas(16) Vec4 {
+    float x = 0.0f, y = 0.0f, z = 0.0f, w = 0.0f;
+
+    Vec4() = default;
+
+    constexpr Vec4(float x_in, float y_in, float z_in, float w_in) noexcept
+        : x(x_in), y(y_in), z(z_in), w(w_in) {}
+
+    /**
+     * @brief Extend a 3D vector with an explicit w-component
+     * @param v xyz components
+     * @param w_in Homogeneous coordinate (1 for points, 0 for directions)
+     */
+    constexpr Vec4(const Vec3& v, float w_in) noexcept
+        : x(v.x), y(v.y), z(v.z), w(w_in) {}
+
+    /**
+     * @brief Drop the w-component (no perspective divide)
+     */
+    constexpr Vec3 xyz() const noexcept {
+        return Vec3(x, y, z);
+    }
+
+    constexpr bool operator==(const Vec4& other) const {
+        return x == other.x && y == other.y && z == other.z && w == other.w;
+    }
+};
+
+inline std::ostream& operator<<(std::ostream& os, const Vec4& v) {
+    os << "(" << v.x << ", " << v.y << ", " << v.z << ", " << v.w << ")";
+    return os;
+}
+
 // =============================================================================
 // Mat4 Struct (4x4 Matrix)
 // =============================================================================
@@ -316,8 +370,10 @@ inline std::ostream& operator<<(std::ostream& os, const Vec3& v) {
  * Column-major storage enables direct memory compatibility with:
  * - OpenGL (glUniformMatrix4fv)
  * - Vulkan (with appropriate transpose flag)
+ *
+ * Aligned to 16 bytes so each column loads as one SSE register.
  */
-struct Mat4 {
+struct alignas(16) Mat4 {
     // Column-major storage: m[column * 4 + row]
     float m[16];
 
@@ -328,13 +384,64 @@ struct Mat4 {
      * Identity matrix serves as multiplicative identity
      * in transformation chains.
      */
-    Mat4() noexcept {
+    constexpr Mat4() noexcept
         // clang-format off
-        m[0]=1; m[4]=0; m[8]=0;  m[12]=0;
-        m[1]=0; m[5]=1; m[9]=0;  m[13]=0;
-        m[2]=0; m[6]=0; m[10]=1; m[14]=0;
-        m[3]=0; m[7]=0; m[11]=0; m[15]=1;
+        : m{1, 0, 0, 0,
+            0, 1, 0, 0,
+            0, 0, 1, 0,
+            0, 0, 0, 1} {}
         // clang-format on
+
+    /**
+     * @brief Identity matrix
+     *
+     * Same as Mat4(), spelled out for readability at call sites
+     * and in constant expressions.
+     */
+    static constexpr Mat4 identity() noexcept {
+        return Mat4();
+    }
+
+    /**
+     * @brief All-zero matrix
+     *
+     * Starting point for matrices that are not identity-based,
+     * such as projections (m[15] must be 0 there).
+     */
+    static constexpr Mat4 zero() noexcept {
+        Mat4 mat;
+        for (float& e : mat.m) {
+            e = 0.0f;
+        }
+        return mat;
+    }
+
+    /**
+     * @brief Build from four columns
+     * @param c0,c1,c2,c3 Columns in storage order
+     */
+    static constexpr Mat4 from_columns(const Vec4& c0, const Vec4& c1, const Vec4& c2, const Vec4& c3) noexcept {
+        Mat4 mat;
+        const Vec4 cols[4] = { c0, c1, c2, c3 };
+        for (int col = 0; col < 4; ++col) {
+            mat.m[col * 4 + 0] = cols[col].x;
+            mat.m[col * 4 + 1] = cols[col].y;
+            mat.m[col * 4 + 2] = cols[col].z;
+            mat.m[col * 4 + 3] = cols[col].w;
+        }
+        return mat;
+    }
+
+    /**
+     * @brief Exact element-wise comparison
+     */
+    constexpr bool operator==(const Mat4& other) const noexcept {
+        for (int i = 0; i < 16; ++i) {
+            if (m[i] != other.m[i]) {
+                return false;
+            }
+        }
+        return true;
     }
 
     // --- Transformation Factory Methods ---
@@ -350,7 +457,7 @@ struct Mat4 {
      * [0 0 1 Tz]
      * [0 0 0 1 ]
      */
-    static Mat4 create_translation(const Vec3& translation) noexcept;
+    static constexpr Mat4 create_translation(const Vec3& translation) noexcept;
 
     /**
      * @brief Create scaling matrix
@@ -363,7 +470,7 @@ struct Mat4 {
      * [0  0  Sz 0]
      * [0  0  0  1]
      */
-    static Mat4 create_scale(const Vec3& scale) noexcept;
+    static constexpr Mat4 create_scale(const Vec3& scale) noexcept;
 
     /**
      * @brief Create rotation matrix around X-axis
@@ -400,6 +507,21 @@ struct Mat4 {
      */
     static Mat4 create_rotation_xyz(const Vec3& angles_rad) noexcept;
 
+    /**
+     * @brief Compose translation * rotation * scale in one step
+     * @param translation Position
+     * @param rotation Unit quaternion orientation
+     * @param scale Scaling factors per axis
+     * @return Same matrix as T * R * S, without the products
+     *
+     * Writes the 12 affine terms directly: each rotation column is scaled
+     * by its axis factor, and the translation goes in column 3. Costs one
+     * quaternion-to-matrix conversion (no trig) and 9 multiplies, versus
+     * three sin/cos pairs and four 64-flop matrix products for
+     * create_translation * create_rotation_xyz * create_scale.
+     */
+    static constexpr Mat4 from_trs(const Vec3& translation, const Quat& rotation, const Vec3& scale) noexcept;
+
     /**
      * @brief Create view matrix for camera
      * @param eye Camera position in world space
@@ -444,24 +566,80 @@ struct Mat4 {
         float near_plane,
         float far_plane
     ) noexcept;
+
+    // --- Inversion ---
+
+    /**
+     * @brief Transposed copy of the matrix
+     * @return Mᵀ (rows become columns)
+     */
+    constexpr Mat4 transposed() const noexcept;
+
+    /**
+     * @brief General 4x4 inverse
+     * @return M⁻¹, or identity when M is singular (det == 0)
+     *
+     * Works for any invertible matrix, projections included. Uses the
+     * 2x2 block (Schur complement) formulation, which maps well onto
+     * SSE registers: roughly half the flops of cofactor expansion.
+     * Prefer affine_inverse() or rigid_inverse() when the matrix is
+     * known to be a model/view transform.
+     */
+    constexpr Mat4 inverse() const noexcept;
+
+    /**
+     * @brief Inverse of an affine transform
+     * @return M⁻¹ assuming the bottom row is [0 0 0 1]
+     *
+     * Inverts the upper 3x3 (via cross products of its columns) and
+     * applies it to the negated translation. Handles non-uniform scale
+     * and shear. Returns identity when the 3x3 part is singular.
+     */
+    constexpr Mat4 affine_inverse() const noexcept;
+
+    /**
+     * @brief Inverse of a rigid-body transform (rotation + translation)
+     * @return [Rᵀ | -Rᵀt]
+     *
+     * Cheapest inverse: a transpose and three dot products.
+     * @warning Only valid when the upper 3x3 is orthonormal (no scale);
+     *          use affine_inverse() otherwise.
+     */
+    constexpr Mat4 rigid_inverse() const noexcept;
+
+    /**
+     * @brief Normal matrix for transforming surface normals
+     * @return Inverse-transpose of the upper 3x3, embedded in a Mat4
+     *         with zero translation and w = 1
+     *
+     * Normals must be transformed by (M₃ₓ₃⁻¹)ᵀ to stay perpendicular to
+     * surfaces under non-uniform scale. Its columns are the cross
+     * products of M's columns divided by det(M₃ₓ₃), so no full inverse
+     * is needed. Upload it once per draw (or per instance) instead of
+     * computing inverse(model) per vertex on the GPU; in GLSL take
+     * mat3(normalMatrix).
+     */
+    constexpr Mat4 normal_matrix() const noexcept;
 };
 
 // --- Mat4 Operations ---
 
 /**
- * @brief Matrix multiplication
- * @param a Left matrix
- * @param b Right matrix
- * @return Matrix product a * b
+ * @namespace alg::scalar
+ * @brief Scalar reference kernels
  *
- * Implements standard matrix multiplication for 4x4 matrices.
- * Order matters: Applies transformation b first, then a.
+ * Plain C++ implementations kept as the ground truth for the SIMD paths.
+ * They are always compiled, whatever backend simd.hpp selected, so results
+ * can be compared side by side and benchmarked against each other.
+ */
+namespace scalar {
+
+/**
+ * @brief Reference matrix multiplication a * b
  *
- * Implementation notes:
- * - Column-major storage requires careful index calculation
- * - Optimized for clarity over absolute performance
+ * Triple loop over column-major storage, accumulating k = 0..3 in order.
  */
-inline Mat4 operator*(const Mat4& a, const Mat4& b) noexcept {
+constexpr Mat4 mul(const Mat4& a, const Mat4& b) noexcept {
     Mat4 result;
     for (int col = 0; col < 4; ++col) {
         for (int row = 0; row < 4; ++row) {
@@ -476,6 +654,394 @@ inline Mat4 operator*(const Mat4& a, const Mat4& b) noexcept {
     return result;
 }
 
+/**
+ * @brief Reference point transform (implicit w = 1, no divide)
+ */
+constexpr Vec3 transform_point(const Mat4& m, const Vec3& v) noexcept {
+    return Vec3(
+        m.m[0] * v.x + m.m[4] * v.y + m.m[8]  * v.z + m.m[12],
+        m.m[1] * v.x + m.m[5] * v.y + m.m[9]  * v.z + m.m[13],
+        m.m[2] * v.x + m.m[6] * v.y + m.m[10] * v.z + m.m[14]
+    );
+}
+
+/**
+ * @brief Reference homogeneous transform
+ */
+constexpr Vec4 transform(const Mat4& m, const Vec4& v) noexcept {
+    return Vec4(
+        m.m[0] * v.x + m.m[4] * v.y + m.m[8]  * v.z + m.m[12] * v.w,
+        m.m[1] * v.x + m.m[5] * v.y + m.m[9]  * v.z + m.m[13] * v.w,
+        m.m[2] * v.x + m.m[6] * v.y + m.m[10] * v.z + m.m[14] * v.w,
+        m.m[3] * v.x + m.m[7] * v.y + m.m[11] * v.z + m.m[15] * v.w
+    );
+}
+
+/**
+ * @brief Reference general inverse by cofactor expansion
+ *
+ * Storage-order agnostic: inverse(Mᵀ) = inverse(M)ᵀ, so the same code is
+ * valid for column- and row-major layouts.
+ */
+constexpr Mat4 inverse(const Mat4& mat) noexcept {
+    const float* m = mat.m;
+    float inv[16] = {};
+
+    inv[0]  =  m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15]
+             + m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10];
+    inv[4]  = -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15]
+             - m[8] * m[7] * m[14] - m[12] * m[6] * m[11] + m[12] * m[7] * m[10];
+    inv[8]  =  m[4] * m[9] * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15]
+             + m[8] * m[7] * m[13] + m[12] * m[5] * m[11] - m[12] * m[7] * m[9];
+    inv[12] = -m[4] * m[9] * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14]
+             - m[8] * m[6] * m[13] - m[12] * m[5] * m[10] + m[12] * m[6] * m[9];
+    inv[1]  = -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15]
+             - m[9] * m[3] * m[14] - m[13] * m[2] * m[11] + m[13] * m[3] * m[10];
+    inv[5]  =  m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15]
+             + m[8] * m[3] * m[14] + m[12] * m[2] * m[11] - m[12] * m[3] * m[10];
+    inv[9]  = -m[0] * m[9] * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15]
+             - m[8] * m[3] * m[13] - m[12] * m[1] * m[11] + m[12] * m[3] * m[9];
+    inv[13] =  m[0] * m[9] * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14]
+             + m[8] * m[2] * m[13] + m[12] * m[1] * m[10] - m[12] * m[2] * m[9];
+    inv[2]  =  m[1] * m[6] * m[15] - m[1] * m[7] * m[14] - m[5] * m[2] * m[15]
+             + m[5] * m[3] * m[14] + m[13] * m[2] * m[7] - m[13] * m[3] * m[6];
+    inv[6]  = -m[0] * m[6] * m[15] + m[0] * m[7] * m[14] + m[4] * m[2] * m[15]
+             - m[4] * m[3] * m[14] - m[12] * m[2] * m[7] + m[12] * m[3] * m[6];
+    inv[10] =  m[0] * m[5] * m[15] - m[0] * m[7] * m[13] - m[4] * m[1] * m[15]
+             + m[4] * m[3] * m[13] + m[12] * m[1] * m[7] - m[12] * m[3] * m[5];
+    inv[14] = -m[0] * m[5] * m[14] + m[0] * m[6] * m[13] + m[4] * m[1] * m[14]
+             - m[4] * m[2] * m[13] - m[12] * m[1] * m[6] + m[12] * m[2] * m[5];
+    inv[3]  = -m[1] * m[6] * m[11] + m[1] * m[7] * m[10] + m[5] * m[2] * m[11]
+             - m[5] * m[3] * m[10] - m[9] * m[2] * m[7] + m[9] * m[3] * m[6];
+    inv[7]  =  m[0] * m[6] * m[11] - m[0] * m[7] * m[10] - m[4] * m[2] * m[11]
+             + m[4] * m[3] * m[10] + m[8] * m[2] * m[7] - m[8] * m[3] * m[6];
+    inv[11] = -m[0] * m[5] * m[11] + m[0] * m[7] * m[9] + m[4] * m[1] * m[11]
+             - m[4] * m[3] * m[9] - m[8] * m[1] * m[7] + m[8] * m[3] * m[5];
+    inv[15] =  m[0] * m[5] * m[10] - m[0] * m[6] * m[9] - m[4] * m[1] * m[10]
+             + m[4] * m[2] * m[9] + m[8] * m[1] * m[6] - m[8] * m[2] * m[5];
+
+    const float det = m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12];
+    Mat4 result;
+    if (det == 0.0f) {
+        return result;
+    }
+    const float inv_det = 1.0f / det;
+    for (int i = 0; i < 16; ++i) {
+        result.m[i] = inv[i] * inv_det;
+    }
+    return result;
+}
+
+/**
+ * @brief Columns of the inverse-transpose of the upper 3x3
+ * @return false when the 3x3 part is singular
+ *
+ * Columns are c1×c2, c2×c0, c0×c1 divided by det = c0 · (c1×c2).
+ */
+constexpr bool inverse_transpose3(const Mat4& mat, Vec3 cols[3]) noexcept {
+    const Vec3 c0(mat.m[0], mat.m[1], mat.m[2]);
+    const Vec3 c1(mat.m[4], mat.m[5], mat.m[6]);
+    const Vec3 c2(mat.m[8], mat.m[9], mat.m[10]);
+    const Vec3 x12 = cross(c1, c2);
+    const float det = dot(c0, x12);
+    if (det == 0.0f) {
+        return false;
+    }
+    const float inv_det = 1.0f / det;
+    cols[0] = x12 * inv_det;
+    cols[1] = cross(c2, c0) * inv_det;
+    cols[2] = cross(c0, c1) * inv_det;
+    return true;
+}
+
+/**
+ * @brief Reference normal matrix (see Mat4::normal_matrix)
+ */
+constexpr Mat4 normal_matrix(const Mat4& mat) noexcept {
+    Mat4 result;
+    Vec3 cols[3];
+    if (inverse_transpose3(mat, cols)) {
+        for (int col = 0; col < 3; ++col) {
+            result.m[col * 4 + 0] = cols[col].x;
+            result.m[col * 4 + 1] = cols[col].y;
+            result.m[col * 4 + 2] = cols[col].z;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Reference affine inverse (see Mat4::affine_inverse)
+ */
+constexpr Mat4 affine_inverse(const Mat4& mat) noexcept {
+    Mat4 result;
+    Vec3 rows[3];
+    if (!inverse_transpose3(mat, rows)) {
+        return result;
+    }
+    // Columns of the inverse-transpose are the rows of the inverse
+    for (int row = 0; row < 3; ++row) {
+        result.m[0 + row] = rows[row].x;
+        result.m[4 + row] = rows[row].y;
+        result.m[8 + row] = rows[row].z;
+    }
+    const Vec3 t(mat.m[12], mat.m[13], mat.m[14]);
+    for (int row = 0; row < 3; ++row) {
+        result.m[12 + row] = -dot(rows[row], t);
+    }
+    return result;
+}
+
+} // namespace scalar
+
+#if defined(ALG_SIMD_SSE2)
+namespace simd {
+
+/**
+ * @brief Linear combination of the columns of a (a * [x y z w]ᵀ)
+ * @param a Matrix whose columns are combined
+ * @param v Coefficients, one per lane
+ *
+ * Building block for every Mat4 product. Terms are added in the same
+ * order as the scalar reference (col0, col1, col2, col3).
+ */
+inline __m128 combine_columns(const Mat4& a, __m128 v) noexcept {
+    __m128 r = _mm_mul_ps(_mm_load_ps(a.m + 0), splat<0>(v));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_load_ps(a.m + 4), splat<1>(v)));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_load_ps(a.m + 8), splat<2>(v)));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_load_ps(a.m + 12), splat<3>(v)));
+    return r;
+}
+
+/**
+ * @brief SIMD matrix multiplication a * b
+ *
+ * Column j of the result is a combined with column j of b.
+ * The AVX2 variant produces two result columns per iteration by
+ * broadcasting a's columns to both 128-bit halves.
+ */
+inline Mat4 mul(const Mat4& a, const Mat4& b) noexcept {
+    Mat4 result;
+#if defined(ALG_SIMD_AVX2)
+    const __m256 a0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a.m + 0));
+    const __m256 a1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a.m + 4));
+    const __m256 a2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a.m + 8));
+    const __m256 a3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a.m + 12));
+    for (int col = 0; col < 4; col += 2) {
+        // Two columns of b: lanes [b(col), b(col+1)]
+        const __m256 bc = _mm256_loadu_ps(b.m + col * 4);
+        __m256 r = _mm256_mul_ps(a0, _mm256_shuffle_ps(bc, bc, 0x00));
+        r = _mm256_add_ps(r, _mm256_mul_ps(a1, _mm256_shuffle_ps(bc, bc, 0x55)));
+        r = _mm256_add_ps(r, _mm256_mul_ps(a2, _mm256_shuffle_ps(bc, bc, 0xAA)));
+        r = _mm256_add_ps(r, _mm256_mul_ps(a3, _mm256_shuffle_ps(bc, bc, 0xFF)));
+        _mm256_storeu_ps(result.m + col * 4, r);
+    }
+#else
+    for (int col = 0; col < 4; ++col) {
+        _mm_store_ps(result.m + col * 4, combine_columns(a, _mm_load_ps(b.m + col * 4)));
+    }
+#endif
+    return result;
+}
+
+/**
+ * @brief SIMD point transform (implicit w = 1, no divide)
+ */
+inline Vec3 transform_point(const Mat4& m, const Vec3& v) noexcept {
+    __m128 r = _mm_mul_ps(_mm_load_ps(m.m + 0), _mm_set1_ps(v.x));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_load_ps(m.m + 4), _mm_set1_ps(v.y)));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_load_ps(m.m + 8), _mm_set1_ps(v.z)));
+    r = _mm_add_ps(r, _mm_load_ps(m.m + 12));
+    alignas(16) float out[4];
+    _mm_store_ps(out, r);
+    return Vec3(out[0], out[1], out[2]);
+}
+
+/**
+ * @brief SIMD homogeneous transform
+ */
+inline Vec4 transform(const Mat4& m, const Vec4& v) noexcept {
+    Vec4 result;
+    _mm_store_ps(&result.x, combine_columns(m, _mm_load_ps(&v.x)));
+    return result;
+}
+
+// 2x2 helpers for inverse(): a __m128 holds a row-major 2x2 block [a0 a1; a2 a3]
+
+/// A * B
+inline __m128 mat2_mul(__m128 a, __m128 b) noexcept {
+    return _mm_add_ps(_mm_mul_ps(a, swizzle<0, 3, 0, 3>(b)),
+                      _mm_mul_ps(swizzle<1, 0, 3, 2>(a), swizzle<2, 1, 2, 1>(b)));
+}
+
+/// adj(A) * B
+inline __m128 mat2_adj_mul(__m128 a, __m128 b) noexcept {
+    return _mm_sub_ps(_mm_mul_ps(swizzle<3, 3, 0, 0>(a), b),
+                      _mm_mul_ps(swizzle<1, 1, 2, 2>(a), swizzle<2, 3, 0, 1>(b)));
+}
+
+/// A * adj(B)
+inline __m128 mat2_mul_adj(__m128 a, __m128 b) noexcept {
+    return _mm_sub_ps(_mm_mul_ps(a, swizzle<3, 0, 3, 0>(b)),
+                      _mm_mul_ps(swizzle<1, 0, 3, 2>(a), swizzle<2, 1, 2, 1>(b)));
+}
+
+/**
+ * @brief SIMD general inverse via 2x2 blocks
+ *
+ * With M = [A B; C D] (2x2 blocks) the inverse is assembled from adjugates
+ * and determinants of the blocks, so everything stays in four registers.
+ * Written against rows; since inverse(Mᵀ) = inverse(M)ᵀ it applies to our
+ * column-major storage unchanged.
+ */
+inline Mat4 inverse(const Mat4& mat) noexcept {
+    const __m128 c0 = _mm_load_ps(mat.m + 0);
+    const __m128 c1 = _mm_load_ps(mat.m + 4);
+    const __m128 c2 = _mm_load_ps(mat.m + 8);
+    const __m128 c3 = _mm_load_ps(mat.m + 12);
+
+    // 2x2 sub-blocks
+    const __m128 A = _mm_movelh_ps(c0, c1);
+    const __m128 B = _mm_movehl_ps(c1, c0);
+    const __m128 C = _mm_movelh_ps(c2, c3);
+    const __m128 D = _mm_movehl_ps(c3, c2);
+
+    // Block determinants as (|A| |B| |C| |D|)
+    const __m128 det_sub = _mm_sub_ps(
+        _mm_mul_ps(_mm_shuffle_ps(c0, c2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(c1, c3, _MM_SHUFFLE(3, 1, 3, 1))),
+        _mm_mul_ps(_mm_shuffle_ps(c0, c2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(c1, c3, _MM_SHUFFLE(2, 0, 2, 0))));
+    const __m128 det_a = splat<0>(det_sub);
+    const __m128 det_b = splat<1>(det_sub);
+    const __m128 det_c = splat<2>(det_sub);
+    const __m128 det_d = splat<3>(det_sub);
+
+    const __m128 d_c = mat2_adj_mul(D, C);
+    const __m128 a_b = mat2_adj_mul(A, B);
+
+    // Adjugate blocks of the result (before the 1/|M| scale)
+    __m128 x = _mm_sub_ps(_mm_mul_ps(det_d, A), mat2_mul(B, d_c));
+    __m128 w = _mm_sub_ps(_mm_mul_ps(det_a, D), mat2_mul(C, a_b));
+    __m128 y = _mm_sub_ps(_mm_mul_ps(det_b, C), mat2_mul_adj(D, a_b));
+    __m128 z = _mm_sub_ps(_mm_mul_ps(det_c, B), mat2_mul_adj(A, d_c));
+
+    // |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+    __m128 det_m = _mm_add_ps(_mm_mul_ps(det_a, det_d), _mm_mul_ps(det_b, det_c));
+    det_m = _mm_sub_ps(det_m, hsum(_mm_mul_ps(a_b, swizzle<0, 2, 1, 3>(d_c))));
+
+    Mat4 result;
+    if (_mm_cvtss_f32(det_m) == 0.0f) {
+        return result;
+    }
+
+    const __m128 r_det = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), det_m);
+    x = _mm_mul_ps(x, r_det);
+    y = _mm_mul_ps(y, r_det);
+    z = _mm_mul_ps(z, r_det);
+    w = _mm_mul_ps(w, r_det);
+
+    // Adjugate shuffle combined with the store layout
+    _mm_store_ps(result.m + 0,  _mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3)));
+    _mm_store_ps(result.m + 4,  _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2)));
+    _mm_store_ps(result.m + 8,  _mm_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3)));
+    _mm_store_ps(result.m + 12, _mm_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2)));
+    return result;
+}
+
+/**
+ * @brief Columns of the inverse-transpose of the upper 3x3
+ * @return false when the 3x3 part is singular
+ *
+ * Shared by normal_matrix() and affine_inverse(); w lanes come out 0.
+ */
+inline bool inverse_transpose3(const Mat4& mat, __m128& n0, __m128& n1, __m128& n2) noexcept {
+    const __m128 w_mask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+    const __m128 c0 = _mm_and_ps(_mm_load_ps(mat.m + 0), w_mask);
+    const __m128 c1 = _mm_and_ps(_mm_load_ps(mat.m + 4), w_mask);
+    const __m128 c2 = _mm_and_ps(_mm_load_ps(mat.m + 8), w_mask);
+
+    const __m128 x12 = cross3(c1, c2);
+    const __m128 det = hsum(_mm_mul_ps(c0, x12));
+    if (_mm_cvtss_f32(det) == 0.0f) {
+        return false;
+    }
+    const __m128 inv_det = _mm_div_ps(_mm_set1_ps(1.0f), det);
+    n0 = _mm_mul_ps(x12, inv_det);
+    n1 = _mm_mul_ps(cross3(c2, c0), inv_det);
+    n2 = _mm_mul_ps(cross3(c0, c1), inv_det);
+    return true;
+}
+
+/**
+ * @brief SIMD normal matrix (see Mat4::normal_matrix)
+ */
+inline Mat4 normal_matrix(const Mat4& mat) noexcept {
+    Mat4 result;
+    __m128 n0, n1, n2;
+    if (inverse_transpose3(mat, n0, n1, n2)) {
+        _mm_store_ps(result.m + 0, n0);
+        _mm_store_ps(result.m + 4, n1);
+        _mm_store_ps(result.m + 8, n2);
+    }
+    return result;
+}
+
+/**
+ * @brief SIMD affine inverse (see Mat4::affine_inverse)
+ */
+inline Mat4 affine_inverse(const Mat4& mat) noexcept {
+    Mat4 result;
+    __m128 r0, r1, r2;
+    if (!inverse_transpose3(mat, r0, r1, r2)) {
+        return result;
+    }
+    // Transposing the inverse-transpose gives the inverse's columns
+    __m128 r3 = _mm_setzero_ps();
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+    // -R⁻¹t, with w = 1 restored afterwards
+    const __m128 t = _mm_load_ps(mat.m + 12);
+    __m128 tr = _mm_mul_ps(r0, splat<0>(t));
+    tr = _mm_add_ps(tr, _mm_mul_ps(r1, splat<1>(t)));
+    tr = _mm_add_ps(tr, _mm_mul_ps(r2, splat<2>(t)));
+    tr = _mm_sub_ps(_mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f), tr);
+
+    _mm_store_ps(result.m + 0, r0);
+    _mm_store_ps(result.m + 4, r1);
+    _mm_store_ps(result.m + 8, r2);
+    _mm_store_ps(result.m + 12, tr);
+    return result;
+}
+
+} // namespace simd
+#endif // ALG_SIMD_SSE2
+
+/**
+ * @brief Matrix multiplication
+ * @param a Left matrix
+ * @param b Right matrix
+ * @return Matrix product a * b
+ *
+ * Implements standard matrix multiplication for 4x4 matrices.
+ * Order matters: Applies transformation b first, then a.
+ *
+ * Dispatches at compile time to the SIMD kernel when one is available,
+ * otherwise to scalar::mul. Without FMA contraction the SSE2/AVX2 paths
+ * are bit-identical to the reference (same products, same summation
+ * order). When the compiler fuses multiply-adds (-mfma with
+ * -ffp-contract=fast), element (i, j) differs from scalar::mul by at
+ * most 4·FLT_EPSILON·Σ_k|a_ik·b_kj|: the bound is relative to the sum of
+ * term magnitudes, not to the element, which under cancellation can be
+ * many ULP of its own value away. tests/test_algebra.cpp enforces it.
+ */
+constexpr Mat4 operator*(const Mat4& a, const Mat4& b) noexcept {
+#if defined(ALG_SIMD_SSE2)
+    if (!std::is_constant_evaluated()) {
+        return simd::mul(a, b);
+    }
+#endif
+    return scalar::mul(a, b);
+}
+
 /**
  * @brief Transform 3D point with matrix
  * @param m Transformation matrix
@@ -490,13 +1056,34 @@ inline Mat4 operator*(const Mat4& a, const Mat4& b) noexcept {
  *
  * Returns only (x', y', z') components. For perspective
  * projections, divide by w-component is needed separately.
+ * Same error bound as Mat4 * Mat4, with the terms m_ik·v_k (and m_i3).
  */
-inline Vec3 operator*(const Mat4& m, const Vec3& v) noexcept {
-    return Vec3(
-        m.m[0] * v.x + m.m[4] * v.y + m.m[8]  * v.z + m.m[12],
-        m.m[1] * v.x + m.m[5] * v.y + m.m[9]  * v.z + m.m[13],
-        m.m[2] * v.x + m.m[6] * v.y + m.m[10] * v.z + m.m[14]
-    );
+constexpr Vec3 operator*(const Mat4& m, const Vec3& v) noexcept {
+#if defined(ALG_SIMD_SSE2)
+    if (!std::is_constant_evaluated()) {
+        return simd::transform_point(m, v);
+    }
+#endif
+    return scalar::transform_point(m, v);
+}
+
+/**
+ * @brief Transform homogeneous vector with matrix
+ * @param m Transformation matrix
+ * @param v Homogeneous vector
+ * @return m * v, all four components
+ *
+ * Use this instead of the Vec3 overload when the w-component is needed,
+ * e.g. for clip-space positions. Same error bound as Mat4 * Mat4, with
+ * the terms m_ik·v_k.
+ */
+constexpr Vec4 operator*(const Mat4& m, const Vec4& v) noexcept {
+#if defined(ALG_SIMD_SSE2)
+    if (!std::is_constant_evaluated()) {
+        return simd::transform(m, v);
+    }
+#endif
+    return scalar::transform(m, v);
 }
 
 /**
@@ -533,7 +1120,7 @@ inline std::ostream& operator<<(std::ostream& os, const Mat4& mat) {
 
 // --- Mat4 Method Implementations ---
 
-inline Mat4 Mat4::create_translation(const Vec3& t) noexcept {
+constexpr Mat4 Mat4::create_translation(const Vec3& t) noexcept {
     Mat4 mat;
     mat.m[12] = t.x;
     mat.m[13] = t.y;
@@ -541,7 +1128,7 @@ inline Mat4 Mat4::create_translation(const Vec3& t) noexcept {
     return mat;
 }
 
-inline Mat4 Mat4::create_scale(const Vec3& s) noexcept {
+constexpr Mat4 Mat4::create_scale(const Vec3& s) noexcept {
     Mat4 mat;
     mat.m[0] = s.x;
     mat.m[5] = s.y;
@@ -551,7 +1138,8 @@ inline Mat4 Mat4::create_scale(const Vec3& s) noexcept {
 
 inline Mat4 Mat4::create_rotation_x(float angle_rad) noexcept {
     Mat4 mat;
-    const float c = std::cos(angle_rad), s = std::sin(angle_rad);
+    float s, c;
+    hot::sincos(angle_rad, s, c);
     // Column 1 (affects y and z)
     mat.m[5] = c;  mat.m[9] = -s;
     mat.m[6] = s;  mat.m[10] = c;
@@ -560,7 +1148,8 @@ inline Mat4 Mat4::create_rotation_x(float angle_rad) noexcept {
 
 inline Mat4 Mat4::create_rotation_y(float angle_rad) noexcept {
     Mat4 mat;
-    const float c = std::cos(angle_rad), s = std::sin(angle_rad);
+    float s, c;
+    hot::sincos(angle_rad, s, c);
     // Column 0 (affects x and z)
     mat.m[0] = c;  mat.m[8] = s;
     mat.m[2] = -s; mat.m[10] = c;
@@ -569,7 +1158,8 @@ inline Mat4 Mat4::create_rotation_y(float angle_rad) noexcept {
 
 inline Mat4 Mat4::create_rotation_z(float angle_rad) noexcept {
     Mat4 mat;
-    const float c = std::cos(angle_rad), s = std::sin(angle_rad);
+    float s, c;
+    hot::sincos(angle_rad, s, c);
     // Column 0 (affects x and y)
     mat.m[0] = c;  mat.m[4] = -s;
     mat.m[1] = s;  mat.m[5] = c;
@@ -618,7 +1208,7 @@ inline Mat4 Mat4::lookAt(const Vec3 &eye, const Vec3 &target, const Vec3 &up) no
 }
 
 inline Mat4 Mat4::create_perspective(float fov_rad, float aspect_ratio, float near_plane, float far_plane) noexcept {
-    Mat4 mat{}; // Zero initialization
+    Mat4 mat = Mat4::zero(); // m[15] must be 0 for the perspective divide
     const float tan_half_fov = std::tan(fov_rad / 2.0f);
 
     // Perspective projection parameters
@@ -631,6 +1221,59 @@ inline Mat4 Mat4::create_perspective(float fov_rad, float aspect_ratio, float ne
     return mat;
 }
 
+constexpr Mat4 Mat4::transposed() const noexcept {
+    Mat4 result;
+    for (int col = 0; col < 4; ++col) {
+        for (int row = 0; row < 4; ++row) {
+            result.m[row * 4 + col] = m[col * 4 + row];
+        }
+    }
+    return result;
+}
+
+constexpr Mat4 Mat4::inverse() const noexcept {
+#if defined(ALG_SIMD_SSE2)
+    if (!std::is_constant_evaluated()) {
+        return simd::inverse(*this);
+    }
+#endif
+    return scalar::inverse(*this);
+}
+
+constexpr Mat4 Mat4::affine_inverse() const noexcept {
+#if defined(ALG_SIMD_SSE2)
+    if (!std::is_constant_evaluated()) {
+        return simd::affine_inverse(*this);
+    }
+#endif
+    return scalar::affine_inverse(*this);
+}
+
+constexpr Mat4 Mat4::rigid_inverse() const noexcept {
+    Mat4 result;
+    // Rotation part: transpose of the upper 3x3
+    for (int col = 0; col < 3; ++col) {
+        for (int row = 0; row < 3; ++row) {
+            result.m[col * 4 + row] = m[row * 4 + col];
+        }
+    }
+    // Translation part: -Rᵀt
+    const Vec3 t(m[12], m[13], m[14]);
+    result.m[12] = -(m[0] * t.x + m[1] * t.y + m[2]  * t.z);
+    result.m[13] = -(m[4] * t.x + m[5] * t.y + m[6]  * t.z);
+    result.m[14] = -(m[8] * t.x + m[9] * t.y + m[10] * t.z);
+    return result;
+}
+
+constexpr Mat4 Mat4::normal_matrix() const noexcept {
+#if defined(ALG_SIMD_SSE2)
+    if (!std::is_constant_evaluated()) {
+        return simd::normal_matrix(*this);
+    }
+#endif
+    return scalar::normal_matrix(*this);
+}
+
 // =============================================================================
 // Quat Struct (Quaternion)
 // =============================================================================
@@ -682,33 +1325,83 @@ struct Quat {
         return Quat(std::cos(half_angle), axis.x * s, axis.y * s, axis.z * s);
     }
 
+    /**
+     * @brief Create from Euler angles
+     * @param angles_rad Rotation angles (radians) for X,Y,Z axes
+     * @return Unit quaternion equal to create_rotation_xyz(angles_rad)
+     *
+     * Same Y (yaw) -> X (pitch) -> Z (roll) convention as
+     * Mat4::create_rotation_xyz: q = q_y ⊗ q_x ⊗ q_z, expanded so only
+     * three half-angle sin/cos pairs are evaluated.
+     */
+    static Quat from_euler(const Vec3& angles_rad) noexcept {
+        float sx, cx, sy, cy, sz, cz;
+        hot::sincos(angles_rad.x * 0.5f, sx, cx);
+        hot::sincos(angles_rad.y * 0.5f, sy, cy);
+        hot::sincos(angles_rad.z * 0.5f, sz, cz);
+        return Quat(
+            cy * cx * cz + sy * sx * sz,
+            cy * sx * cz + sy * cx * sz,
+            sy * cx * cz - cy * sx * sz,
+            cy * cx * sz - sy * sx * cz
+        );
+    }
+
+    /**
+     * @brief Convert back to Euler angles
+     * @return Angles (radians) for X,Y,Z in the from_euler convention
+     *
+     * Pitch is recovered from the rotation matrix term -2(yz - wx) and
+     * clamped to [-π/2, π/2]. At gimbal lock (pitch within ~0.1° of ±90°)
+     * roll is folded into yaw and reported as zero.
+     */
+    Vec3 to_euler() const noexcept {
+        const float sin_pitch = -2.0f * (y * z - w * x);
+        if (std::fabs(sin_pitch) >= 0.999999f) {
+            return Vec3(
+                std::copysign(PI / 2.0f, sin_pitch),
+                std::atan2(-2.0f * (x * z - w * y), 1.0f - 2.0f * (y * y + z * z)),
+                0.0f
+            );
+        }
+        return Vec3(
+            std::asin(sin_pitch),
+            std::atan2(2.0f * (x * z + w * y), 1.0f - 2.0f * (x * x + y * y)),
+            std::atan2(2.0f * (x * y + w * z), 1.0f - 2.0f * (x * x + z * z))
+        );
+    }
+
     // --- Quaternion Arithmetic ---
-    Quat& operator+=(const Quat& other) noexcept {
+    constexpr Quat& operator+=(const Quat& other) noexcept {
         w += other.w; x += other.x; y += other.y; z += other.z;
         return *this;
     }
-    Quat& operator-=(const Quat& other) noexcept {
+    constexpr Quat& operator-=(const Quat& other) noexcept {
         w -= other.w; x -= other.x; y -= other.y; z -= other.z;
         return *this;
     }
-    Quat& operator*=(float scalar) noexcept {
+    constexpr Quat& operator*=(float scalar) noexcept {
         w *= scalar; x *= scalar; y *= scalar; z *= scalar;
         return *this;
     }
 
-    Quat operator+(const Quat& other) const noexcept {
+    constexpr Quat operator+(const Quat& other) const noexcept {
         return Quat(w + other.w, x + other.x, y + other.y, z + other.z);
     }
-    Quat operator-(const Quat& other) const noexcept {
+    constexpr Quat operator-(const Quat& other) const noexcept {
         return Quat(w - other.w, x - other.x, y - other.y, z - other.z);
     }
-    Quat operator*(float scalar) const noexcept {
+    constexpr Quat operator*(float scalar) const noexcept {
         return Quat(w * scalar, x * scalar, y * scalar, z * scalar);
     }
-    Quat operator-() const noexcept {
+    constexpr Quat operator-() const noexcept {
         return Quat(-w, -x, -y, -z);
     }
 
+    constexpr bool operator==(const Quat& other) const {
+        return w == other.w && x == other.x && y == other.y && z == other.z;
+    }
+
     // --- Quaternion Operations ---
 
     /**
@@ -749,7 +1442,7 @@ struct Quat {
      * For unit quaternions, conjugate is equivalent to inverse.
      * Represents reverse rotation.
      */
-    Quat conjugate() const noexcept {
+    constexpr Quat conjugate() const noexcept {
         return Quat(w, -x, -y, -z);
     }
 
@@ -771,7 +1464,7 @@ struct Quat {
      * Matrix form derived from quaternion components.
      * Assumes quaternion is normalized.
      */
-    Mat4 to_rotation_matrix() const noexcept {
+    constexpr Mat4 to_rotation_matrix() const noexcept {
         Mat4 mat;
         const float xx = x * x, yy = y * y, zz = z * z;
         const float xy = x * y, xz = x * z, yz = y * z;
@@ -806,7 +1499,7 @@ struct Quat {
  * @param q Quaternion to scale
  * @return Scaled quaternion
  */
-inline Quat operator*(float scalar, const Quat& q) noexcept {
+constexpr Quat operator*(float scalar, const Quat& q) noexcept {
     return q * scalar;
 }
 
@@ -821,7 +1514,7 @@ inline Quat operator*(float scalar, const Quat& q) noexcept {
  *
  * Follows right-hand rule for rotation composition.
  */
-inline Quat operator*(const Quat& q1, const Quat& q2) noexcept {
+constexpr Quat operator*(const Quat& q1, const Quat& q2) noexcept {
     return Quat(
         q1.w * q2.w - q1.x * q2.x - q1.y * q2.y - q1.z * q2.z, // w
         q1.w * q2.x + q1.x * q2.w + q1.y * q2.z - q1.z * q2.y, // x
@@ -841,6 +1534,33 @@ inline std::ostream& operator<<(std::ostream& os, const Quat& q) {
     return os;
 }
 
+// --- Mat4 methods that depend on Quat ---
+
+constexpr Mat4 Mat4::from_trs(const Vec3& t, const Quat& q, const Vec3& s) noexcept {
+    const float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+    const float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+    const float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+    Mat4 mat;
+    // Column 0: rotated X axis * scale.x
+    mat.m[0] = (1.0f - 2.0f * (yy + zz)) * s.x;
+    mat.m[1] = 2.0f * (xy + wz) * s.x;
+    mat.m[2] = 2.0f * (xz - wy) * s.x;
+    // Column 1: rotated Y axis * scale.y
+    mat.m[4] = 2.0f * (xy - wz) * s.y;
+    mat.m[5] = (1.0f - 2.0f * (xx + zz)) * s.y;
+    mat.m[6] = 2.0f * (yz + wx) * s.y;
+    // Column 2: rotated Z axis * scale.z
+    mat.m[8] = 2.0f * (xz + wy) * s.z;
+    mat.m[9] = 2.0f * (yz - wx) * s.z;
+    mat.m[10] = (1.0f - 2.0f * (xx + yy)) * s.z;
+    // Column 3: translation (row 3 stays [0 0 0 1] from identity)
+    mat.m[12] = t.x;
+    mat.m[13] = t.y;
+    mat.m[14] = t.z;
+    return mat;
+}
+
 /**
  * @brief Spherical Linear Interpolation (SLERP)
  * @param q0 Start rotation (normalized)
@@ -884,5 +1604,49 @@ inline Quat slerp(Quat q0, Quat q1, float t) noexcept {
     return (s0 * q0) + (s1 * q1);
 }
 
+// =============================================================================
+// Compile-Time Constants
+// =============================================================================
+
+/**
+ * @brief Identity transform as a named constant
+ */
+inline constexpr Mat4 MAT4_IDENTITY = Mat4::identity();
+
+/**
+ * @brief Convert Z-up assets (Blender, 3ds Max) to the engine's Y-up frame
+ *
+ * -90° about X: (x, y, z) -> (x, z, -y). Both handedness-preserving.
+ */
+inline constexpr Mat4 Z_UP_TO_Y_UP = Mat4::from_columns(
+    Vec4(1.0f,  0.0f, 0.0f, 0.0f),
+    Vec4(0.0f,  0.0f, -1.0f, 0.0f),
+    Vec4(0.0f,  1.0f, 0.0f, 0.0f),
+    Vec4(0.0f,  0.0f, 0.0f, 1.0f)
+);
+
+/**
+ * @brief Inverse of Z_UP_TO_Y_UP: (x, y, z) -> (x, -z, y)
+ */
+inline constexpr Mat4 Y_UP_TO_Z_UP = Z_UP_TO_Y_UP.transposed();
+
+/**
+ * @brief Mirror Z to switch between right- and left-handed conventions
+ */
+inline constexpr Mat4 FLIP_Z = Mat4::create_scale(Vec3(1.0f, 1.0f, -1.0f));
+
+/**
+ * @brief Corners of the unit cube centred at the origin ([-0.5, 0.5]³)
+ *
+ * Index bits select the max side per axis: bit 0 = x, bit 1 = y, bit 2 = z.
+ * Matches the cube mesh built in main.cpp.
+ */
+inline constexpr Vec3 UNIT_CUBE_CORNERS[8] = {
+    Vec3(-0.5f, -0.5f, -0.5f), Vec3( 0.5f, -0.5f, -0.5f),
+    Vec3(-0.5f,  0.5f, -0.5f), Vec3( 0.5f,  0.5f, -0.5f),
+    Vec3(-0.5f, -0.5f,  0.5f), Vec3( 0.5f, -0.5f,  0.5f),
+    Vec3(-0.5f,  0.5f,  0.5f), Vec3( 0.5f,  0.5f,  0.5f),
+};
+
 } // namespace alg
-#endif // ALGEBRA_HPP
\ No newline at end of file
+#endif // ALGEBRA_HPP
@@ -0,0 +1,299 @@
+#ifndef ALGEBRA_BATCH_HPP
+#define ALGEBRA_BATCH_HPP
+
+#include <cstddef>
+#include <span>
+#include "algebra.hpp"
+
+/**
+ * @namespace alg::batch
+ * @brief Transform kernels over contiguous arrays
+ *
+ * Single-value operators in algebra.hpp pay per call for loading the matrix,
+ * shuffling a 12-byte Vec3 in and out of a register and storing the result.
+ * These entry points amortize that over whole arrays, which is what culling,
+ * skinning and bounds computation actually need.
+ *
+ * Vec3 kernels convert four packed Vec3 (three registers of AoS data) into
+ * SoA x/y/z registers, do the math lane-parallel with the matrix terms
+ * broadcast once per call, and convert back. Tails shorter than four
+ * elements fall back to the scalar reference code.
+ *
+ * Every kernel performs the same operations in the same order as the
+ * single-value code, so results are bit-identical to a scalar loop unless
+ * the compiler contracts multiply-adds into FMA. In-place use (out
+ * aliasing in) is allowed.
+ *
+ * @warning Output spans must hold at least as many elements as the input.
+ */
+namespace alg::batch {
+
+static_assert(sizeof(Vec3) == 3 * sizeof(float), "batch kernels assume packed Vec3 arrays");
+
+#if defined(ALG_SIMD_SSE2)
+namespace detail {
+
+/**
+ * @brief Transpose four packed Vec3 (12 floats) into SoA registers
+ * @param p Pointer to x0 y0 z0 x1 y1 z1 x2 y2 z2 x3 y3 z3
+ */
+inline void load_soa(const float* p, __m128& x, __m128& y, __m128& z) noexcept {
+    const __m128 a = _mm_loadu_ps(p + 0); // x0 y0 z0 x1
+    const __m128 b = _mm_loadu_ps(p + 4); // y1 z1 x2 y2
+    const __m128 c = _mm_loadu_ps(p + 8); // z2 x3 y3 z3
+
+    const __m128 t = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2)); // x2 y2 x3 y3
+    const __m128 u = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)); // y0 y0 y1 y1
+    const __m128 v = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)); // z0 z0 z1 z1
+
+    x = _mm_shuffle_ps(a, t, _MM_SHUFFLE(2, 0, 3, 0));
+    y = _mm_shuffle_ps(u, t, _MM_SHUFFLE(3, 1, 2, 0));
+    z = _mm_shuffle_ps(v, c, _MM_SHUFFLE(3, 0, 2, 0));
+}
+
+/**
+ * @brief Inverse of load_soa: write four Vec3 back as packed AoS
+ */
+inline void store_soa(float* p, __m128 x, __m128 y, __m128 z) noexcept {
+    const __m128 a = _mm_shuffle_ps(
+        _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)),  // x0 x0 y0 y0
+        _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)),  // z0 z0 x1 x1
+        _MM_SHUFFLE(2, 0, 2, 0));
+    const __m128 b = _mm_shuffle_ps(
+        _mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)),  // y1 y1 z1 z1
+        _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)),  // x2 x2 y2 y2
+        _MM_SHUFFLE(2, 0, 2, 0));
+    const __m128 c = _mm_shuffle_ps(
+        _mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)),  // z2 z2 x3 x3
+        _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)),  // y3 y3 z3 z3
+        _MM_SHUFFLE(2, 0, 2, 0));
+    _mm_storeu_ps(p + 0, a);
+    _mm_storeu_ps(p + 4, b);
+    _mm_storeu_ps(p + 8, c);
+}
+
+/**
+ * @brief Upper 3x4 of a matrix with every element broadcast to a register
+ *
+ * Loaded once per batch call so the inner loop does only mul/add.
+ */
+struct BroadcastMat {
+    __m128 e[12]; // column-major, rows 0..2 of columns 0..3
+
+    explicit BroadcastMat(const Mat4& m) noexcept {
+        for (int col = 0; col < 4; ++col) {
+            for (int row = 0; row < 3; ++row) {
+                e[col * 3 + row] = _mm_set1_ps(m.m[col * 4 + row]);
+            }
+        }
+    }
+
+    /// Row `row` of the linear part applied to SoA x/y/z
+    __m128 linear(int row, __m128 x, __m128 y, __m128 z) const noexcept {
+        __m128 r = _mm_mul_ps(e[0 + row], x);
+        r = _mm_add_ps(r, _mm_mul_ps(e[3 + row], y));
+        return _mm_add_ps(r, _mm_mul_ps(e[6 + row], z));
+    }
+
+    /// Translation term for row `row`
+    __m128 translation(int row) const noexcept {
+        return e[9 + row];
+    }
+};
+
+/**
+ * @brief Scale SoA x/y/z to unit length; zero-length lanes become zero
+ *
+ * Uses the same arithmetic as Vec3::normalized, lane for lane: sqrt +
+ * divide by default, fast::rsqrt4 (the vector form of fast::rsqrt) under
+ * ALG_FAST_MATH. The SIMD body and the scalar tail therefore agree bit for
+ * bit, unless FMA contraction fuses the two differently (a few ulp).
+ */
+inline void normalize_soa(__m128& x, __m128& y, __m128& z) noexcept {
+    const __m128 len2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+    const __m128 nonzero = _mm_cmpgt_ps(len2, _mm_setzero_ps());
+#if defined(ALG_FAST_MATH)
+    const __m128 inv = fast::rsqrt4(len2);
+    x = _mm_and_ps(_mm_mul_ps(x, inv), nonzero);
+    y = _mm_and_ps(_mm_mul_ps(y, inv), nonzero);
+    z = _mm_and_ps(_mm_mul_ps(z, inv), nonzero);
+#else
+    const __m128 mag = _mm_sqrt_ps(len2);
+    x = _mm_and_ps(_mm_div_ps(x, mag), nonzero);
+    y = _mm_and_ps(_mm_div_ps(y, mag), nonzero);
+    z = _mm_and_ps(_mm_div_ps(z, mag), nonzero);
+#endif
+}
+
+} // namespace detail
+#endif // ALG_SIMD_SSE2
+
+/**
+ * @brief Multiply N matrices by one matrix from the left
+ * @param lhs Common left factor (e.g. projection * view)
+ * @param in Right factors (e.g. model matrices)
+ * @param out Receives lhs * in[i]
+ *
+ * The columns of lhs stay in registers for the whole batch, so each
+ * product costs 16 broadcasts and 16 multiply-adds with no reloads.
+ */
+inline void mul(const Mat4& lhs, std::span<const Mat4> in, std::span<Mat4> out) noexcept {
+    const std::size_t n = in.size();
+#if defined(ALG_SIMD_AVX2)
+    const __m256 a0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs.m + 0));
+    const __m256 a1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs.m + 4));
+    const __m256 a2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs.m + 8));
+    const __m256 a3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs.m + 12));
+    for (std::size_t i = 0; i < n; ++i) {
+        const __m256 b01 = _mm256_loadu_ps(in[i].m + 0);
+        const __m256 b23 = _mm256_loadu_ps(in[i].m + 8);
+        __m256 r01 = _mm256_mul_ps(a0, _mm256_shuffle_ps(b01, b01, 0x00));
+        __m256 r23 = _mm256_mul_ps(a0, _mm256_shuffle_ps(b23, b23, 0x00));
+        r01 = _mm256_add_ps(r01, _mm256_mul_ps(a1, _mm256_shuffle_ps(b01, b01, 0x55)));
+        r23 = _mm256_add_ps(r23, _mm256_mul_ps(a1, _mm256_shuffle_ps(b23, b23, 0x55)));
+        r01 = _mm256_add_ps(r01, _mm256_mul_ps(a2, _mm256_shuffle_ps(b01, b01, 0xAA)));
+        r23 = _mm256_add_ps(r23, _mm256_mul_ps(a2, _mm256_shuffle_ps(b23, b23, 0xAA)));
+        r01 = _mm256_add_ps(r01, _mm256_mul_ps(a3, _mm256_shuffle_ps(b01, b01, 0xFF)));
+        r23 = _mm256_add_ps(r23, _mm256_mul_ps(a3, _mm256_shuffle_ps(b23, b23, 0xFF)));
+        _mm256_storeu_ps(out[i].m + 0, r01);
+        _mm256_storeu_ps(out[i].m + 8, r23);
+    }
+#elif defined(ALG_SIMD_SSE2)
+    for (std::size_t i = 0; i < n; ++i) {
+        // Load all of in[i] before storing so in-place use is safe
+        const __m128 b0 = _mm_load_ps(in[i].m + 0);
+        const __m128 b1 = _mm_load_ps(in[i].m + 4);
+        const __m128 b2 = _mm_load_ps(in[i].m + 8);
+        const __m128 b3 = _mm_load_ps(in[i].m + 12);
+        _mm_store_ps(out[i].m + 0, simd::combine_columns(lhs, b0));
+        _mm_store_ps(out[i].m + 4, simd::combine_columns(lhs, b1));
+        _mm_store_ps(out[i].m + 8, simd::combine_columns(lhs, b2));
+        _mm_store_ps(out[i].m + 12, simd::combine_columns(lhs, b3));
+    }
+#else
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = scalar::mul(lhs, in[i]);
+    }
+#endif
+}
+
+/**
+ * @brief Transform N points by one matrix (implicit w = 1, no divide)
+ * @param m Transformation matrix
+ * @param in Source points
+ * @param out Receives m * in[i]
+ */
+inline void transform_points(const Mat4& m, std::span<const Vec3> in, std::span<Vec3> out) noexcept {
+    const std::size_t n = in.size();
+    std::size_t i = 0;
+#if defined(ALG_SIMD_SSE2)
+    const float* src = reinterpret_cast<const float*>(in.data());
+    float* dst = reinterpret_cast<float*>(out.data());
+    const detail::BroadcastMat bm(m);
+    for (; i + 4 <= n; i += 4) {
+        __m128 x, y, z;
+        detail::load_soa(src + i * 3, x, y, z);
+        const __m128 rx = _mm_add_ps(bm.linear(0, x, y, z), bm.translation(0));
+        const __m128 ry = _mm_add_ps(bm.linear(1, x, y, z), bm.translation(1));
+        const __m128 rz = _mm_add_ps(bm.linear(2, x, y, z), bm.translation(2));
+        detail::store_soa(dst + i * 3, rx, ry, rz);
+    }
+#endif
+    for (; i < n; ++i) {
+        out[i] = scalar::transform_point(m, in[i]);
+    }
+}
+
+/**
+ * @brief Transform N direction vectors by one matrix (implicit w = 0)
+ * @param m Transformation matrix; only the upper 3x3 is used
+ * @param in Source directions
+ * @param out Receives the linear part of m applied to in[i]
+ *
+ * Translation is ignored. Lengths are not preserved under scaling;
+ * see transform_normals for surface normals.
+ */
+inline void transform_vectors(const Mat4& m, std::span<const Vec3> in, std::span<Vec3> out) noexcept {
+    const std::size_t n = in.size();
+    std::size_t i = 0;
+#if defined(ALG_SIMD_SSE2)
+    const detail::BroadcastMat bm(m);
+    const float* src = reinterpret_cast<const float*>(in.data());
+    float* dst = reinterpret_cast<float*>(out.data());
+    for (; i + 4 <= n; i += 4) {
+        __m128 x, y, z;
+        detail::load_soa(src + i * 3, x, y, z);
+        detail::store_soa(dst + i * 3, bm.linear(0, x, y, z), bm.linear(1, x, y, z), bm.linear(2, x, y, z));
+    }
+#endif
+    for (; i < n; ++i) {
+        const Vec3& v = in[i];
+        out[i] = Vec3(
+            m.m[0] * v.x + m.m[4] * v.y + m.m[8]  * v.z,
+            m.m[1] * v.x + m.m[5] * v.y + m.m[9]  * v.z,
+            m.m[2] * v.x + m.m[6] * v.y + m.m[10] * v.z
+        );
+    }
+}
+
+/**
+ * @brief Transform N surface normals and renormalize them
+ * @param normal_matrix Inverse-transpose of the model matrix (upper 3x3 used)
+ * @param in Source normals
+ * @param out Receives unit-length transformed normals
+ *
+ * Passing the model matrix itself is only correct for rotations and
+ * uniform scales; non-uniform scales need the inverse-transpose.
+ */
+inline void transform_normals(const Mat4& normal_matrix, std::span<const Vec3> in, std::span<Vec3> out) noexcept {
+    const std::size_t n = in.size();
+    std::size_t i = 0;
+#if defined(ALG_SIMD_SSE2)
+    const detail::BroadcastMat bm(normal_matrix);
+    const float* src = reinterpret_cast<const float*>(in.data());
+    float* dst = reinterpret_cast<float*>(out.data());
+    for (; i + 4 <= n; i += 4) {
+        __m128 x, y, z;
+        detail::load_soa(src + i * 3, x, y, z);
+        __m128 rx = bm.linear(0, x, y, z);
+        __m128 ry = bm.linear(1, x, y, z);
+        __m128 rz = bm.linear(2, x, y, z);
+        detail::normalize_soa(rx, ry, rz);
+        detail::store_soa(dst + i * 3, rx, ry, rz);
+    }
+#endif
+    const Mat4& m = normal_matrix;
+    for (; i < n; ++i) {
+        const Vec3& v = in[i];
+        out[i] = Vec3(
+            m.m[0] * v.x + m.m[4] * v.y + m.m[8]  * v.z,
+            m.m[1] * v.x + m.m[5] * v.y + m.m[9]  * v.z,
+            m.m[2] * v.x + m.m[6] * v.y + m.m[10] * v.z
+        ).normalized();
+    }
+}
+
+/**
+ * @brief Normalize N vectors in place
+ * @param v Vectors to normalize; zero vectors stay zero
+ */
+inline void normalize(std::span<Vec3> v) noexcept {
+    const std::size_t n = v.size();
+    std::size_t i = 0;
+#if defined(ALG_SIMD_SSE2)
+    float* p = reinterpret_cast<float*>(v.data());
+    for (; i + 4 <= n; i += 4) {
+        __m128 x, y, z;
+        detail::load_soa(p + i * 3, x, y, z);
+        detail::normalize_soa(x, y, z);
+        detail::store_soa(p + i * 3, x, y, z);
+    }
+#endif
+    for (; i < n; ++i) {
+        v[i] = v[i].normalized();
+    }
+}
+
+} // namespace alg::batch
+
+#endif // ALGEBRA_BATCH_HPP
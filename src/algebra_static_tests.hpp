@@ -0,0 +1,63 @@
+#ifndef ALGEBRA_STATIC_TESTS_HPP
+#define ALGEBRA_STATIC_TESTS_HPP
+
+#include "algebra.hpp"
+
+/**
+ * @file algebra_static_tests.hpp
+ * @brief Compile-time checks for the constexpr parts of algebra.hpp
+ *
+ * Included by a single translation unit (tests/test_algebra.cpp), so the
+ * checks cost nothing elsewhere: if one of the factories stops being
+ * constexpr, or its result changes, that target fails to build. Inputs
+ * are chosen so every result is exactly representable and can be
+ * compared with ==.
+ */
+namespace alg::static_checks {
+
+constexpr Vec3 T(1.0f, 2.0f, 3.0f);
+constexpr Vec3 S(2.0f, 4.0f, 8.0f);
+
+// Vec3 arithmetic
+static_assert(dot(Vec3(1.0f, 0.0f, 0.0f), Vec3(0.0f, 1.0f, 0.0f)) == 0.0f);
+static_assert(cross(Vec3(1.0f, 0.0f, 0.0f), Vec3(0.0f, 1.0f, 0.0f)) == Vec3(0.0f, 0.0f, 1.0f));
+static_assert(T + S == Vec3(3.0f, 6.0f, 11.0f) && 2.0f * T == Vec3(2.0f, 4.0f, 6.0f));
+static_assert(T.magnitude_squared() == 14.0f);
+
+// Factories and products
+static_assert(MAT4_IDENTITY * MAT4_IDENTITY == MAT4_IDENTITY);
+static_assert(Mat4::create_translation(T) * Vec3(0.0f, 0.0f, 0.0f) == T);
+static_assert(Mat4::create_scale(S) * Vec3(1.0f, 1.0f, 1.0f) == S);
+static_assert((Mat4::create_translation(T) * Mat4::create_scale(S)) * Vec3(1.0f, 1.0f, 1.0f) == Vec3(3.0f, 6.0f, 11.0f));
+static_assert(Mat4::create_translation(T) * Vec4(T, 0.0f) == Vec4(T, 0.0f)); // directions ignore translation
+static_assert(Mat4::zero().m[0] == 0.0f && Mat4::zero().m[15] == 0.0f);
+
+// Inverses
+static_assert(Mat4::create_translation(T).rigid_inverse() == Mat4::create_translation(-T));
+static_assert(Mat4::create_scale(S).affine_inverse() == Mat4::create_scale(Vec3(0.5f, 0.25f, 0.125f)));
+static_assert(Mat4::create_scale(S).inverse() == Mat4::create_scale(Vec3(0.5f, 0.25f, 0.125f)));
+static_assert(Mat4::create_scale(S).normal_matrix() == Mat4::create_scale(Vec3(0.5f, 0.25f, 0.125f)));
+static_assert((Mat4::create_translation(T) * Mat4::create_scale(S)).affine_inverse()
+              == Mat4::create_scale(Vec3(0.5f, 0.25f, 0.125f)) * Mat4::create_translation(-T));
+
+// Axis-swap constants
+static_assert(Z_UP_TO_Y_UP * Vec3(0.0f, 0.0f, 1.0f) == Vec3(0.0f, 1.0f, 0.0f));
+static_assert(Z_UP_TO_Y_UP * Vec3(0.0f, 1.0f, 0.0f) == Vec3(0.0f, 0.0f, -1.0f));
+static_assert(Y_UP_TO_Z_UP * Z_UP_TO_Y_UP == MAT4_IDENTITY);
+static_assert(FLIP_Z * FLIP_Z == MAT4_IDENTITY);
+
+// Unit cube: opposite corners sum to zero, indices follow the bit layout
+static_assert(UNIT_CUBE_CORNERS[0] + UNIT_CUBE_CORNERS[7] == Vec3(0.0f, 0.0f, 0.0f));
+static_assert(UNIT_CUBE_CORNERS[5] == Vec3(0.5f, -0.5f, 0.5f));
+
+// Quaternions: 180° about Z (w = 0, z = 1) maps X to -X
+static_assert(Quat(0.0f, 0.0f, 0.0f, 1.0f).to_rotation_matrix() * Vec3(1.0f, 0.0f, 0.0f) == Vec3(-1.0f, 0.0f, 0.0f));
+static_assert(Quat(0.0f, 0.0f, 0.0f, 1.0f) * Quat(0.0f, 0.0f, 0.0f, 1.0f) == Quat(-1.0f, 0.0f, 0.0f, 0.0f));
+
+// TRS composition matches the matrix product
+static_assert(Mat4::from_trs(T, Quat(0.0f, 0.0f, 0.0f, 1.0f), S)
+              == Mat4::create_translation(T) * Quat(0.0f, 0.0f, 0.0f, 1.0f).to_rotation_matrix() * Mat4::create_scale(S));
+
+} // namespace alg::static_checks
+
+#endif // ALGEBRA_STATIC_TESTS_HPP
@@ -0,0 +1,723 @@
+#ifndef BVH_HPP
+#define BVH_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+#include "algebra.hpp"
+#include "geometry.hpp"
+
+/**
+ * @file bvh.hpp
+ * @brief Bounding volume hierarchy over a set of boxes
+ *
+ * Items are the indices of the box array passed to build(); the tree never
+ * looks at anything but their boxes, so callers map items back to their
+ * own objects. Nodes are stored depth-first in one array (a parent always
+ * comes before its children, and every subtree covers a contiguous range
+ * of the leaf item array).
+ *
+ * Moving objects do not require a rebuild: update() replaces an item's box
+ * and marks the path to the root, and refit() recomputes only the marked
+ * nodes. Refitting keeps the topology, so quality degrades as objects move
+ * far from where they were at build time; cost() vs build_cost() tells
+ * when a rebuild pays off.
+ */
+namespace alg {
+
+/**
+ * @class Bvh
+ * @brief Binned-SAH BVH with incremental refit and spatial queries
+ */
+class Bvh {
+public:
+    static constexpr std::uint32_t NONE = std::numeric_limits<std::uint32_t>::max();
+    static constexpr std::uint32_t MAX_LEAF_ITEMS = 4;
+    static constexpr int SAH_BINS = 12;
+
+    /**
+     * @struct Node
+     * @brief 32 bytes: box plus either two children or a range of items
+     */
+    struct Node {
+        AABB box;
+        std::uint32_t first = 0; ///< Interior: left child (right is first + 1). Leaf: first item slot
+        std::uint32_t count = 0; ///< Number of items; 0 for interior nodes
+
+        constexpr bool is_leaf() const noexcept { return count != 0; }
+    };
+
+    /**
+     * @struct RayHit
+     * @brief Result of a first-hit ray query
+     */
+    struct RayHit {
+        std::uint32_t item = NONE;
+        float t = std::numeric_limits<float>::infinity();
+    };
+
+    /**
+     * @brief Build the tree from scratch, top-down with binned SAH
+     * @param boxes One box per item; item i is boxes[i]
+     *
+     * O(n log n). Nodes are split until they hold at most MAX_LEAF_ITEMS
+     * items; SAH picks where.
+     */
+    void build(std::span<const AABB> boxes) {
+        const std::uint32_t n = static_cast<std::uint32_t>(boxes.size());
+        nodes_.clear();
+        parents_.clear();
+        items_.resize(n);
+        item_boxes_.resize(n);
+        slot_of_.resize(n);
+        leaf_of_.resize(n);
+        dirty_.clear();
+        dirty_list_.clear();
+        area_sum_ = 0.0f;
+        build_cost_ = 0.0f;
+        if (n == 0) {
+            return;
+        }
+
+        // Build in place over item_boxes_/centroids (partitioned together with
+        // items_), so the binning passes read memory sequentially
+        std::vector<Vec3> centroids(n);
+        for (std::uint32_t i = 0; i < n; ++i) {
+            items_[i] = i;
+            item_boxes_[i] = boxes[i];
+            // Empty boxes (no geometry) get a finite centroid so binning stays defined
+            centroids[i] = boxes[i].is_empty() ? Vec3(0.0f, 0.0f, 0.0f) : boxes[i].center();
+        }
+
+        nodes_.reserve(2 * n);
+        parents_.reserve(2 * n);
+        nodes_.push_back(Node{AABB(), 0, n});
+        parents_.push_back(NONE);
+
+        std::vector<std::uint32_t> stack{0};
+        while (!stack.empty()) {
+            const std::uint32_t index = stack.back();
+            stack.pop_back();
+            const std::uint32_t first = nodes_[index].first;
+            const std::uint32_t count = nodes_[index].count;
+
+            AABB box;
+            AABB centroid_box;
+            for (std::uint32_t s = first; s < first + count; ++s) {
+                box.expand(item_boxes_[s]);
+                centroid_box.expand(centroids[s]);
+            }
+            nodes_[index].box = box;
+            if (count <= MAX_LEAF_ITEMS) {
+                continue;
+            }
+
+            const std::uint32_t mid = partition(centroids, centroid_box, first, count);
+            const std::uint32_t left = static_cast<std::uint32_t>(nodes_.size());
+            nodes_.push_back(Node{AABB(), first, mid - first});
+            nodes_.push_back(Node{AABB(), mid, first + count - mid});
+            parents_.push_back(index);
+            parents_.push_back(index);
+            nodes_[index].first = left;
+            nodes_[index].count = 0;
+            stack.push_back(left + 1);
+            stack.push_back(left);
+        }
+
+        dirty_.assign(nodes_.size(), 0);
+        for (std::uint32_t i = 0; i < nodes_.size(); ++i) {
+            const Node& node = nodes_[i];
+            area_sum_ += node_weight(node) * node.box.surface_area();
+            if (node.is_leaf()) {
+                for (std::uint32_t s = node.first; s < node.first + node.count; ++s) {
+                    slot_of_[items_[s]] = s;
+                    leaf_of_[items_[s]] = i;
+                }
+            }
+        }
+        build_cost_ = cost();
+    }
+
+    /**
+     * @brief Replace the box of one item; takes effect on the next refit()
+     */
+    void update(std::uint32_t item, const AABB& box) {
+        assert(item < slot_of_.size());
+        item_boxes_[slot_of_[item]] = box;
+        for (std::uint32_t node = leaf_of_[item]; node != NONE && !dirty_[node]; node = parents_[node]) {
+            dirty_[node] = 1;
+            dirty_list_.push_back(node);
+        }
+    }
+
+    /**
+     * @brief Recompute the boxes of the nodes touched by update()
+     *
+     * O(m log m) for m touched nodes; does nothing when nothing moved.
+     */
+    void refit() {
+        if (dirty_list_.empty()) {
+            return;
+        }
+        // Depth-first layout: children have larger indices than their parent
+        std::sort(dirty_list_.begin(), dirty_list_.end(), std::greater<>());
+        for (const std::uint32_t index : dirty_list_) {
+            Node& node = nodes_[index];
+            const float old_area = node.box.surface_area();
+            AABB box;
+            if (node.is_leaf()) {
+                for (std::uint32_t s = node.first; s < node.first + node.count; ++s) {
+                    box.expand(item_boxes_[s]);
+                }
+            } else {
+                box = merge(nodes_[node.first].box, nodes_[node.first + 1].box);
+            }
+            node.box = box;
+            area_sum_ += node_weight(node) * (box.surface_area() - old_area);
+            dirty_[index] = 0;
+        }
+        dirty_list_.clear();
+    }
+
+    /**
+     * @brief SAH cost of the current tree (expected box tests per query, relative)
+     */
+    float cost() const noexcept {
+        if (nodes_.empty()) {
+            return 0.0f;
+        }
+        const float root_area = nodes_[0].box.surface_area();
+        return root_area > 0.0f ? area_sum_ / root_area : 0.0f;
+    }
+
+    /**
+     * @brief cost() right after the last build()
+     */
+    float build_cost() const noexcept { return build_cost_; }
+
+    std::size_t size() const noexcept { return items_.size(); }
+    bool empty() const noexcept { return items_.empty(); }
+    const std::vector<Node>& nodes() const noexcept { return nodes_; }
+    const AABB& item_box(std::uint32_t item) const noexcept { return item_boxes_[slot_of_[item]]; }
+    std::uint32_t item_at(std::uint32_t slot) const noexcept { return items_[slot]; }
+
+    /**
+     * @brief Visit every item whose box intersects the frustum
+     * @param fn Called as fn(item)
+     *
+     * Planes a node is fully inside of are not tested again below it, and
+     * subtrees fully inside all planes are emitted without further plane
+     * tests. Items with empty boxes are never visited, as in
+     * intersects(Frustum, AABB).
+     */
+    template <class Fn>
+    void query_frustum(const Frustum& frustum, Fn&& fn) const {
+        if (nodes_.empty()) {
+            return;
+        }
+        constexpr std::uint8_t ALL_PLANES = (1u << Frustum::SIDE_COUNT) - 1;
+        struct Entry {
+            std::uint32_t node;
+            std::uint8_t planes;
+        };
+        TraversalStack<Entry> stack;
+        stack.push_back({0, ALL_PLANES});
+        while (!stack.empty()) {
+            const Entry entry = stack.back();
+            stack.pop_back();
+            const Node& node = nodes_[entry.node];
+
+            std::uint8_t planes = entry.planes;
+            if (!classify(frustum, node.box, planes)) {
+                continue;
+            }
+            if (planes == 0) {
+                const std::uint32_t end = subtree_end(entry.node);
+                for (std::uint32_t s = subtree_begin(entry.node); s < end; ++s) {
+                    if (!item_boxes_[s].is_empty()) {
+                        fn(items_[s]);
+                    }
+                }
+                continue;
+            }
+            if (node.is_leaf()) {
+                for (std::uint32_t s = node.first; s < node.first + node.count; ++s) {
+                    if (intersects(frustum, item_boxes_[s])) {
+                        fn(items_[s]);
+                    }
+                }
+                continue;
+            }
+            stack.push_back({node.first + 1, planes});
+            stack.push_back({node.first, planes});
+        }
+    }
+
+    /**
+     * @brief Visit every item whose box the ray enters within [0, t_max]
+     * @param fn Called as fn(item, t_entry), in no particular order
+     */
+    template <class Fn>
+    void query_ray(const Ray& ray, float t_max, Fn&& fn) const {
+        if (nodes_.empty()) {
+            return;
+        }
+        TraversalStack<std::uint32_t> stack;
+        stack.push_back(0);
+        while (!stack.empty()) {
+            const Node& node = nodes_[stack.back()];
+            stack.pop_back();
+            float t;
+            if (!intersect(ray, node.box, t) || t > t_max) {
+                continue;
+            }
+            if (node.is_leaf()) {
+                for (std::uint32_t s = node.first; s < node.first + node.count; ++s) {
+                    if (intersect(ray, item_boxes_[s], t) && t <= t_max) {
+                        fn(items_[s], t);
+                    }
+                }
+                continue;
+            }
+            stack.push_back(node.first + 1);
+            stack.push_back(node.first);
+        }
+    }
+
+    /**
+     * @brief Closest hit along the ray, using a caller-supplied exact test
+     * @param hit_item Called as hit_item(item) -> t of the hit, or +inf on a
+     *        miss. Only called for items whose box is entered before the
+     *        best hit found so far.
+     * @return Closest hit within [0, t_max]; item is NONE on a miss
+     */
+    template <class Fn>
+    RayHit raycast(const Ray& ray, float t_max, Fn&& hit_item) const {
+        return raycast_leaves(ray, t_max, [&](std::uint32_t first, std::uint32_t count, RayHit& best) {
+            for (std::uint32_t s = first; s < first + count; ++s) {
+                float t_box;
+                if (!intersect(ray, item_boxes_[s], t_box) || t_box > best.t) {
+                    continue;
+                }
+                const float t = hit_item(items_[s]);
+                if (t <= best.t && std::isfinite(t)) {
+                    best.t = t;
+                    best.item = items_[s];
+                }
+            }
+        });
+    }
+
+    /**
+     * @brief Closest hit along the ray, testing whole leaves at once
+     * @param hit_leaf Called as hit_leaf(first_slot, count, best) for each
+     *        leaf the ray enters before best.t; it tests the items in slots
+     *        [first_slot, first_slot + count) (see item_at) and lowers
+     *        best.t / sets best.item on a closer hit. Slots are contiguous,
+     *        so callers can keep per-item data in slot order and test a
+     *        leaf with one SIMD pass.
+     * @return Closest hit within [0, t_max]; item is NONE on a miss
+     *
+     * Children are visited near-first, so most far subtrees are pruned.
+     */
+    template <class Fn>
+    RayHit raycast_leaves(const Ray& ray, float t_max, Fn&& hit_leaf) const {
+        RayHit best;
+        best.t = t_max;
+        float t_root;
+        if (nodes_.empty() || !intersect(ray, nodes_[0].box, t_root) || t_root > t_max) {
+            return RayHit{};
+        }
+        struct Entry {
+            std::uint32_t node;
+            float t;
+        };
+        TraversalStack<Entry> stack;
+        stack.push_back({0, t_root});
+        while (!stack.empty()) {
+            const Entry entry = stack.back();
+            stack.pop_back();
+            if (entry.t > best.t) {
+                continue;
+            }
+            const Node& node = nodes_[entry.node];
+            if (node.is_leaf()) {
+                hit_leaf(node.first, node.count, best);
+                continue;
+            }
+
+            float t_left, t_right;
+            const bool hit_left = intersect(ray, nodes_[node.first].box, t_left) && t_left <= best.t;
+            const bool hit_right = intersect(ray, nodes_[node.first + 1].box, t_right) && t_right <= best.t;
+            if (hit_left && hit_right) {
+                // Far child first so the near one is popped next
+                if (t_left <= t_right) {
+                    stack.push_back({node.first + 1, t_right});
+                    stack.push_back({node.first, t_left});
+                } else {
+                    stack.push_back({node.first, t_left});
+                    stack.push_back({node.first + 1, t_right});
+                }
+            } else if (hit_left) {
+                stack.push_back({node.first, t_left});
+            } else if (hit_right) {
+                stack.push_back({node.first + 1, t_right});
+            }
+        }
+        if (best.item == NONE) {
+            return RayHit{};
+        }
+        return best;
+    }
+
+    /**
+     * @brief Closest item box along the ray (box-level picking)
+     */
+    RayHit raycast(const Ray& ray, float t_max = std::numeric_limits<float>::infinity()) const {
+        return raycast(ray, t_max, [&](std::uint32_t item) {
+            float t;
+            return intersect(ray, item_box(item), t) ? t : std::numeric_limits<float>::infinity();
+        });
+    }
+
+    /**
+     * @brief Visit every item whose box overlaps the sphere
+     * @param fn Called as fn(item)
+     */
+    template <class Fn>
+    void query_sphere(const Sphere& sphere, Fn&& fn) const {
+        if (nodes_.empty()) {
+            return;
+        }
+        TraversalStack<std::uint32_t> stack;
+        stack.push_back(0);
+        while (!stack.empty()) {
+            const Node& node = nodes_[stack.back()];
+            stack.pop_back();
+            if (!intersects(sphere, node.box)) {
+                continue;
+            }
+            if (node.is_leaf()) {
+                for (std::uint32_t s = node.first; s < node.first + node.count; ++s) {
+                    if (intersects(sphere, item_boxes_[s])) {
+                        fn(items_[s]);
+                    }
+                }
+                continue;
+            }
+            stack.push_back(node.first + 1);
+            stack.push_back(node.first);
+        }
+    }
+
+    /**
+     * @brief The k items whose boxes are closest to a point
+     * @param out Receives up to k items, nearest first (distance to the box,
+     *        0 for boxes containing the point)
+     *
+     * Best-first search: nodes are expanded in order of distance and the
+     * search stops once no remaining node can beat the k-th result.
+     */
+    void nearest(const Vec3& point, std::size_t k, std::vector<std::uint32_t>& out) const {
+        out.clear();
+        if (nodes_.empty() || k == 0) {
+            return;
+        }
+        struct Entry {
+            float d2;
+            std::uint32_t index;
+        };
+        const auto farther = [](const Entry& a, const Entry& b) { return a.d2 > b.d2; };
+        const auto closer = [](const Entry& a, const Entry& b) { return a.d2 < b.d2; };
+
+        std::vector<Entry> open;    // Min-heap of nodes
+        std::vector<Entry> results; // Max-heap of the best k items
+        open.push_back({distance_squared(nodes_[0].box, point), 0});
+        while (!open.empty()) {
+            std::pop_heap(open.begin(), open.end(), farther);
+            const Entry entry = open.back();
+            open.pop_back();
+            if (results.size() == k && entry.d2 >= results.front().d2) {
+                break;
+            }
+            const Node& node = nodes_[entry.index];
+            if (!node.is_leaf()) {
+                for (std::uint32_t c = node.first; c < node.first + 2; ++c) {
+                    open.push_back({distance_squared(nodes_[c].box, point), c});
+                    std::push_heap(open.begin(), open.end(), farther);
+                }
+                continue;
+            }
+            for (std::uint32_t s = node.first; s < node.first + node.count; ++s) {
+                const float d2 = distance_squared(item_boxes_[s], point);
+                if (results.size() < k) {
+                    results.push_back({d2, items_[s]});
+                    std::push_heap(results.begin(), results.end(), closer);
+                } else if (d2 < results.front().d2) {
+                    std::pop_heap(results.begin(), results.end(), closer);
+                    results.back() = {d2, items_[s]};
+                    std::push_heap(results.begin(), results.end(), closer);
+                }
+            }
+        }
+
+        std::sort_heap(results.begin(), results.end(), closer);
+        out.reserve(results.size());
+        for (const Entry& r : results) {
+            out.push_back(r.index);
+        }
+    }
+
+private:
+    /**
+     * @brief Depth-first traversal stack that lives on the call stack
+     *
+     * A depth-first walk holds at most one pending sibling per level, so
+     * INLINE entries cover trees up to that depth without touching the
+     * heap; queries run once per draw or per object, often from many
+     * workers at once. Deeper (degenerate) trees spill to a vector.
+     */
+    template <class T>
+    class TraversalStack {
+    public:
+        bool empty() const noexcept { return size_ == 0; }
+
+        void push_back(const T& value) {
+            if (size_ < INLINE) {
+                inline_[size_] = value;
+            } else {
+                overflow_.push_back(value);
+            }
+            ++size_;
+        }
+
+        const T& back() const noexcept {
+            return size_ <= INLINE ? inline_[size_ - 1] : overflow_.back();
+        }
+
+        void pop_back() noexcept {
+            if (size_ > INLINE) {
+                overflow_.pop_back();
+            }
+            --size_;
+        }
+
+    private:
+        static constexpr std::size_t INLINE = 64;
+        T inline_[INLINE];
+        std::vector<T> overflow_; // Entries past INLINE
+        std::size_t size_ = 0;
+    };
+
+    static float component(const Vec3& v, int axis) noexcept {
+        return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+    }
+
+    // SAH weights: one box test per interior node, one per item in a leaf
+    static float node_weight(const Node& node) noexcept {
+        return node.is_leaf() ? static_cast<float>(node.count) : 1.0f;
+    }
+
+    /**
+     * @brief Binned SAH split of slots [first, first + count)
+     * @return First slot of the right-hand child (never first or first + count)
+     *
+     * Evaluates SAH_BINS - 1 candidate planes on each axis and reorders
+     * items_, item_boxes_ and centroids so the left child comes first.
+     */
+    std::uint32_t partition(std::vector<Vec3>& centroids, const AABB& centroid_box,
+                            std::uint32_t first, std::uint32_t count) {
+        struct Bin {
+            AABB box;
+            std::uint32_t count = 0;
+        };
+        float best_cost = std::numeric_limits<float>::infinity();
+        int best_axis = -1;
+        int best_split = 0;
+
+        for (int axis = 0; axis < 3; ++axis) {
+            const float lo = component(centroid_box.min, axis);
+            const float extent = component(centroid_box.max, axis) - lo;
+            if (!(extent > 0.0f)) {
+                continue;
+            }
+            const float scale = SAH_BINS / extent;
+
+            Bin bins[SAH_BINS];
+            for (std::uint32_t s = first; s < first + count; ++s) {
+                const int b = std::min(SAH_BINS - 1, static_cast<int>((component(centroids[s], axis) - lo) * scale));
+                bins[b].box.expand(item_boxes_[s]);
+                ++bins[b].count;
+            }
+
+            // Sweep from the right, then from the left, to get both halves of each split
+            float right_area[SAH_BINS];
+            std::uint32_t right_count[SAH_BINS];
+            AABB acc;
+            std::uint32_t acc_count = 0;
+            for (int b = SAH_BINS - 1; b > 0; --b) {
+                acc.expand(bins[b].box);
+                acc_count += bins[b].count;
+                right_area[b] = acc_count ? acc.surface_area() : 0.0f;
+                right_count[b] = acc_count;
+            }
+            acc = AABB();
+            acc_count = 0;
+            for (int b = 0; b < SAH_BINS - 1; ++b) {
+                acc.expand(bins[b].box);
+                acc_count += bins[b].count;
+                if (acc_count == 0 || right_count[b + 1] == 0) {
+                    continue;
+                }
+                const float c = acc.surface_area() * acc_count + right_area[b + 1] * right_count[b + 1];
+                if (c < best_cost) {
+                    best_cost = c;
+                    best_axis = axis;
+                    best_split = b + 1;
+                }
+            }
+        }
+
+        if (best_axis < 0) {
+            // All centroids coincide: no spatial split exists, halve by count
+            return first + count / 2;
+        }
+
+        const float lo = component(centroid_box.min, best_axis);
+        const float scale = SAH_BINS / (component(centroid_box.max, best_axis) - lo);
+        const auto goes_left = [&](std::uint32_t s) {
+            return std::min(SAH_BINS - 1, static_cast<int>((component(centroids[s], best_axis) - lo) * scale)) < best_split;
+        };
+        std::uint32_t i = first;
+        std::uint32_t j = first + count;
+        while (i < j) {
+            if (goes_left(i)) {
+                ++i;
+                continue;
+            }
+            --j;
+            std::swap(items_[i], items_[j]);
+            std::swap(item_boxes_[i], item_boxes_[j]);
+            std::swap(centroids[i], centroids[j]);
+        }
+        return i;
+    }
+
+    /**
+     * @brief Frustum/box classification that skips planes already passed
+     * @param planes In: planes to test. Out: planes the box straddles
+     * @return false when the box is outside one of the planes, or empty
+     */
+    static bool classify(const Frustum& frustum, const AABB& box, std::uint8_t& planes) noexcept {
+        if (box.is_empty()) {
+            return false;
+        }
+        const Vec3 c = box.center();
+        const Vec3 e = box.extents();
+        for (int i = 0; i < Frustum::SIDE_COUNT; ++i) {
+            const std::uint8_t bit = static_cast<std::uint8_t>(1u << i);
+            if (!(planes & bit)) {
+                continue;
+            }
+            const Plane& p = frustum.planes[i];
+            const float r = std::fabs(p.normal.x) * e.x + std::fabs(p.normal.y) * e.y + std::fabs(p.normal.z) * e.z;
+            const float d = p.distance(c);
+            if (d + r < 0.0f) {
+                return false;
+            }
+            if (d - r >= 0.0f) {
+                planes &= static_cast<std::uint8_t>(~bit);
+            }
+        }
+        return true;
+    }
+
+    // Subtrees cover contiguous item slots: from the leftmost leaf to the rightmost
+    std::uint32_t subtree_begin(std::uint32_t index) const noexcept {
+        while (!nodes_[index].is_leaf()) {
+            index = nodes_[index].first;
+        }
+        return nodes_[index].first;
+    }
+
+    std::uint32_t subtree_end(std::uint32_t index) const noexcept {
+        while (!nodes_[index].is_leaf()) {
+            index = nodes_[index].first + 1;
+        }
+        return nodes_[index].first + nodes_[index].count;
+    }
+
+    std::vector<Node> nodes_;
+    std::vector<std::uint32_t> parents_;     // Parallel to nodes_
+    std::vector<std::uint32_t> items_;       // Item ids in leaf order
+    std::vector<AABB> item_boxes_;           // Parallel to items_
+    std::vector<std::uint32_t> slot_of_;     // Item id -> position in items_
+    std::vector<std::uint32_t> leaf_of_;     // Item id -> leaf node
+    std::vector<std::uint8_t> dirty_;        // Parallel to nodes_
+    std::vector<std::uint32_t> dirty_list_;
+    float area_sum_ = 0.0f;
+    float build_cost_ = 0.0f;
+};
+
+/**
+ * @class TriangleBvh
+ * @brief Bvh over the triangles of an indexed mesh, for exact CPU ray picking
+ *
+ * Triangles are copied into a TriangleSoA in the tree's leaf order, so each
+ * leaf (at most Bvh::MAX_LEAF_ITEMS triangles) is tested with a single
+ * batch::raycast_triangles pass and no per-item box tests.
+ */
+class TriangleBvh {
+public:
+    /**
+     * @brief Build from an indexed triangle list (3 indices per triangle)
+     */
+    void build(std::span<const Vec3> positions, std::span<const unsigned int> indices) {
+        const std::size_t n = indices.size() / 3;
+        std::vector<AABB> boxes(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            AABB& box = boxes[i];
+            box.expand(positions[indices[3 * i]]);
+            box.expand(positions[indices[3 * i + 1]]);
+            box.expand(positions[indices[3 * i + 2]]);
+        }
+        bvh_.build(boxes);
+
+        triangles_.resize(n);
+        for (std::uint32_t slot = 0; slot < n; ++slot) {
+            const std::size_t tri = bvh_.item_at(slot);
+            triangles_.set(slot, positions[indices[3 * tri]], positions[indices[3 * tri + 1]],
+                           positions[indices[3 * tri + 2]]);
+        }
+    }
+
+    /**
+     * @brief Closest triangle hit within [0, t_max]
+     * @return item is the triangle index (its indices start at 3 * item), NONE on a miss
+     */
+    Bvh::RayHit raycast(const Ray& ray, float t_max = std::numeric_limits<float>::infinity()) const {
+        return bvh_.raycast_leaves(ray, t_max, [&](std::uint32_t first, std::uint32_t count, Bvh::RayHit& best) {
+            const std::size_t slot = batch::raycast_triangles(ray, triangles_, first, count, best.t);
+            if (slot != SIZE_MAX) {
+                best.item = bvh_.item_at(static_cast<std::uint32_t>(slot));
+            }
+        });
+    }
+
+    std::size_t size() const noexcept { return bvh_.size(); }
+    bool empty() const noexcept { return bvh_.empty(); }
+
+private:
+    Bvh bvh_;
+    TriangleSoA triangles_; // In leaf slot order
+};
+
+} // namespace alg
+
+#endif // BVH_HPP
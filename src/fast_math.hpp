@@ -0,0 +1,413 @@
+#ifndef FAST_MATH_HPP
+#define FAST_MATH_HPP
+
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include "simd.hpp"
+
+/**
+ * @namespace alg::fast
+ * @brief Reduced-precision replacements for <cmath> functions
+ *
+ * Polynomial approximations that trade a few ULP for speed and, more
+ * importantly, vectorize: each function has a scalar form, a 4-lane SSE2
+ * form (suffix 4) and a span form that runs the 4-lane kernel over arrays.
+ * All three evaluate the same polynomial with the same operation order, so
+ * scalar and batch results agree unless the compiler contracts them to FMA.
+ *
+ * Error bounds below were measured with dense sweeps (not exhaustive)
+ * against the double precision <cmath> result over the stated domain:
+ *
+ * | Function | Domain          | Max error            |
+ * |----------|-----------------|----------------------|
+ * | sin/cos  | |x| <= 8192     | 1.0e-7 absolute      |
+ * | rsqrt    | x > 0 (normal)  | 3.0e-7 relative      |
+ * | atan     | all finite      | 2.0e-6 rad absolute  |
+ * | atan2    | all finite      | 2.0e-6 rad absolute  |
+ * | acos     | [-1, 1]         | 5.0e-7 rad absolute  |
+ *
+ * Nothing here handles NaN/inf inputs specially; callers on hot paths are
+ * expected to feed finite values.
+ *
+ * The rest of the library keeps using <cmath> unless ALG_FAST_MATH is
+ * defined (configure with -DALG_ENABLE_FAST_MATH=ON); see alg::hot.
+ */
+namespace alg::fast {
+
+namespace detail {
+
+// pi/2 split in three parts (Cody-Waite) so k * pi/2 is exact for |k| < 2^12
+inline constexpr float PIO2_HI = 1.5703125f;
+inline constexpr float PIO2_MID = 4.837512969970703125e-4f;
+inline constexpr float PIO2_LO = 7.54978995489188216e-8f;
+inline constexpr float TWO_OVER_PI = 0.636619772367581343f;
+inline constexpr float HALF_PI = 1.57079632679489662f;
+inline constexpr float PI_F = 3.14159265358979324f;
+
+// Minimax polynomials on [-pi/4, pi/4] (Cephes sinf/cosf)
+inline constexpr float SIN_C1 = -1.6666654611e-1f;
+inline constexpr float SIN_C2 = 8.3321608736e-3f;
+inline constexpr float SIN_C3 = -1.9515295891e-4f;
+inline constexpr float COS_C1 = 4.166664568298827e-2f;
+inline constexpr float COS_C2 = -1.388731625493765e-3f;
+inline constexpr float COS_C3 = 2.443315711809948e-5f;
+
+// atan(z) for |z| <= 1, odd polynomial of degree 11
+inline constexpr float ATAN_C0 = 0.99997726f;
+inline constexpr float ATAN_C1 = -0.33262347f;
+inline constexpr float ATAN_C2 = 0.19354346f;
+inline constexpr float ATAN_C3 = -0.11643287f;
+inline constexpr float ATAN_C4 = 0.05265332f;
+inline constexpr float ATAN_C5 = -0.01172120f;
+
+// acos(x) = sqrt(1 - x) * P(x) for x in [0, 1] (Abramowitz & Stegun 4.4.46)
+inline constexpr float ACOS_C0 = 1.5707963050f;
+inline constexpr float ACOS_C1 = -0.2145988016f;
+inline constexpr float ACOS_C2 = 0.0889789874f;
+inline constexpr float ACOS_C3 = -0.0501743046f;
+inline constexpr float ACOS_C4 = 0.0308918810f;
+inline constexpr float ACOS_C5 = -0.0170881256f;
+inline constexpr float ACOS_C6 = 0.0066700901f;
+inline constexpr float ACOS_C7 = -0.0012624911f;
+
+inline float atan_poly(float z) noexcept {
+    const float z2 = z * z;
+    return z * (ATAN_C0 + z2 * (ATAN_C1 + z2 * (ATAN_C2 + z2 * (ATAN_C3 + z2 * (ATAN_C4 + z2 * ATAN_C5)))));
+}
+
+} // namespace detail
+
+// =============================================================================
+// Scalar
+// =============================================================================
+
+/**
+ * @brief Sine and cosine of one angle
+ * @param x Angle in radians, |x| <= 8192 for the documented error
+ * @param s Receives sin(x)
+ * @param c Receives cos(x)
+ *
+ * Reduces x to r in [-pi/4, pi/4] with x = r + k * pi/2, evaluates both
+ * polynomials on r and picks/negates them by quadrant k mod 4.
+ */
+inline void sincos(float x, float& s, float& c) noexcept {
+    using namespace detail;
+#if defined(ALG_SIMD_SSE2)
+    // cvtss2si rounds to nearest even, without the libm call nearbyint costs
+    const int k = _mm_cvtss_si32(_mm_set_ss(x * TWO_OVER_PI));
+#else
+    const int k = static_cast<int>(std::nearbyint(x * TWO_OVER_PI));
+#endif
+    const float kf = static_cast<float>(k);
+    const float r = ((x - kf * PIO2_HI) - kf * PIO2_MID) - kf * PIO2_LO;
+    const float r2 = r * r;
+
+    const float ps = r + r * r2 * (SIN_C1 + r2 * (SIN_C2 + r2 * SIN_C3));
+    const float pc = 1.0f - 0.5f * r2 + r2 * r2 * (COS_C1 + r2 * (COS_C2 + r2 * COS_C3));
+
+    // Branchless quadrant fix-up: the quadrant of random angles is unpredictable
+    const float poly[2] = {ps, pc};
+    const std::uint32_t s_sign = static_cast<std::uint32_t>(k & 2) << 30;
+    const std::uint32_t c_sign = static_cast<std::uint32_t>((k + 1) & 2) << 30;
+    s = std::bit_cast<float>(std::bit_cast<std::uint32_t>(poly[k & 1]) ^ s_sign);
+    c = std::bit_cast<float>(std::bit_cast<std::uint32_t>(poly[(k & 1) ^ 1]) ^ c_sign);
+}
+
+inline float sin(float x) noexcept {
+    float s, c;
+    sincos(x, s, c);
+    return s;
+}
+
+inline float cos(float x) noexcept {
+    float s, c;
+    sincos(x, s, c);
+    return c;
+}
+
+/**
+ * @brief Reciprocal square root 1/sqrt(x)
+ * @param x Positive normal float
+ *
+ * Hardware estimate (12 bits) refined by one Newton-Raphson step. Without
+ * SSE2 this is the exact 1.0f / std::sqrt(x).
+ */
+inline float rsqrt(float x) noexcept {
+#if defined(ALG_SIMD_SSE2)
+    const __m128 v = _mm_set_ss(x);
+    const __m128 y = _mm_rsqrt_ss(v);
+    // y * (1.5 - 0.5 * x * y * y)
+    const __m128 yy = _mm_mul_ss(_mm_mul_ss(_mm_mul_ss(_mm_set_ss(0.5f), v), y), y);
+    return _mm_cvtss_f32(_mm_mul_ss(y, _mm_sub_ss(_mm_set_ss(1.5f), yy)));
+#else
+    return 1.0f / std::sqrt(x);
+#endif
+}
+
+/**
+ * @brief Arc tangent in [-pi/2, pi/2]
+ */
+inline float atan(float x) noexcept {
+    using namespace detail;
+    const float ax = std::fabs(x);
+    const float r = ax > 1.0f ? HALF_PI - atan_poly(1.0f / ax) : atan_poly(ax);
+    return x < 0.0f ? -r : r;
+}
+
+/**
+ * @brief Four-quadrant arc tangent in [-pi, pi]
+ * @return 0 when both arguments are zero
+ */
+inline float atan2(float y, float x) noexcept {
+    using namespace detail;
+    const float ax = std::fabs(x), ay = std::fabs(y);
+    const float mx = ax > ay ? ax : ay;
+    const float mn = ax > ay ? ay : ax;
+    if (mx == 0.0f) {
+        return 0.0f;
+    }
+    float r = atan_poly(mn / mx);
+    if (ay > ax) r = HALF_PI - r;
+    if (x < 0.0f) r = PI_F - r;
+    return y < 0.0f ? -r : r;
+}
+
+/**
+ * @brief Arc cosine in [0, pi]
+ * @param x Cosine, clamped to [-1, 1]
+ */
+inline float acos(float x) noexcept {
+    using namespace detail;
+    const float ax = std::fmin(std::fabs(x), 1.0f);
+    const float p = ACOS_C0 + ax * (ACOS_C1 + ax * (ACOS_C2 + ax * (ACOS_C3 +
+                    ax * (ACOS_C4 + ax * (ACOS_C5 + ax * (ACOS_C6 + ax * ACOS_C7))))));
+    const float r = std::sqrt(1.0f - ax) * p;
+    return x < 0.0f ? PI_F - r : r;
+}
+
+// =============================================================================
+// SIMD (4 lanes)
+// =============================================================================
+
+#if defined(ALG_SIMD_SSE2)
+
+/**
+ * @brief Lane-wise sincos; same reduction and polynomials as the scalar form
+ */
+inline void sincos4(__m128 x, __m128& s, __m128& c) noexcept {
+    using namespace detail;
+    // cvtps rounds to nearest even under the default MXCSR, like nearbyint
+    const __m128i k = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(TWO_OVER_PI)));
+    const __m128 kf = _mm_cvtepi32_ps(k);
+    __m128 r = _mm_sub_ps(x, _mm_mul_ps(kf, _mm_set1_ps(PIO2_HI)));
+    r = _mm_sub_ps(r, _mm_mul_ps(kf, _mm_set1_ps(PIO2_MID)));
+    r = _mm_sub_ps(r, _mm_mul_ps(kf, _mm_set1_ps(PIO2_LO)));
+    const __m128 r2 = _mm_mul_ps(r, r);
+
+    __m128 ps = _mm_add_ps(_mm_set1_ps(SIN_C2), _mm_mul_ps(r2, _mm_set1_ps(SIN_C3)));
+    ps = _mm_add_ps(_mm_set1_ps(SIN_C1), _mm_mul_ps(r2, ps));
+    ps = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r, r2), ps));
+
+    __m128 pc = _mm_add_ps(_mm_set1_ps(COS_C2), _mm_mul_ps(r2, _mm_set1_ps(COS_C3)));
+    pc = _mm_add_ps(_mm_set1_ps(COS_C1), _mm_mul_ps(r2, pc));
+    pc = _mm_add_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(_mm_set1_ps(0.5f), r2)),
+                    _mm_mul_ps(_mm_mul_ps(r2, r2), pc));
+
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i two = _mm_set1_epi32(2);
+    const __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(k, one), one));
+    const __m128 sv = _mm_or_ps(_mm_and_ps(swap, pc), _mm_andnot_ps(swap, ps));
+    const __m128 cv = _mm_or_ps(_mm_and_ps(swap, ps), _mm_andnot_ps(swap, pc));
+    // Sign flips: bit 1 of k for sin, bit 1 of k + 1 for cos, moved to the float sign bit
+    const __m128 s_sign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(k, two), 30));
+    const __m128 c_sign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(k, one), two), 30));
+    s = _mm_xor_ps(sv, s_sign);
+    c = _mm_xor_ps(cv, c_sign);
+}
+
+/**
+ * @brief Lane-wise 1/sqrt(x) with one Newton-Raphson step
+ */
+inline __m128 rsqrt4(__m128 x) noexcept {
+    const __m128 y = _mm_rsqrt_ps(x);
+    const __m128 yy = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), x), y), y);
+    return _mm_mul_ps(y, _mm_sub_ps(_mm_set1_ps(1.5f), yy));
+}
+
+namespace detail {
+
+inline __m128 atan_poly4(__m128 z) noexcept {
+    const __m128 z2 = _mm_mul_ps(z, z);
+    __m128 p = _mm_add_ps(_mm_set1_ps(ATAN_C4), _mm_mul_ps(z2, _mm_set1_ps(ATAN_C5)));
+    p = _mm_add_ps(_mm_set1_ps(ATAN_C3), _mm_mul_ps(z2, p));
+    p = _mm_add_ps(_mm_set1_ps(ATAN_C2), _mm_mul_ps(z2, p));
+    p = _mm_add_ps(_mm_set1_ps(ATAN_C1), _mm_mul_ps(z2, p));
+    p = _mm_add_ps(_mm_set1_ps(ATAN_C0), _mm_mul_ps(z2, p));
+    return _mm_mul_ps(z, p);
+}
+
+inline __m128 select4(__m128 mask, __m128 a, __m128 b) noexcept {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+inline __m128 abs4(__m128 v) noexcept {
+    return _mm_andnot_ps(_mm_set1_ps(-0.0f), v);
+}
+
+} // namespace detail
+
+/**
+ * @brief Lane-wise four-quadrant arc tangent
+ */
+inline __m128 atan2_4(__m128 y, __m128 x) noexcept {
+    using namespace detail;
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 ax = abs4(x), ay = abs4(y);
+    const __m128 mx = _mm_max_ps(ax, ay);
+    const __m128 mn = _mm_min_ps(ax, ay);
+    const __m128 valid = _mm_cmpgt_ps(mx, zero);
+    // Division by a safe denominator; lanes with mx == 0 are masked to 0 below
+    const __m128 z = _mm_div_ps(mn, select4(valid, mx, _mm_set1_ps(1.0f)));
+    __m128 r = atan_poly4(z);
+    r = select4(_mm_cmpgt_ps(ay, ax), _mm_sub_ps(_mm_set1_ps(HALF_PI), r), r);
+    r = select4(_mm_cmplt_ps(x, zero), _mm_sub_ps(_mm_set1_ps(PI_F), r), r);
+    r = select4(_mm_cmplt_ps(y, zero), _mm_sub_ps(zero, r), r);
+    return _mm_and_ps(valid, r);
+}
+
+/**
+ * @brief Lane-wise arc cosine (inputs clamped to [-1, 1])
+ */
+inline __m128 acos4(__m128 x) noexcept {
+    using namespace detail;
+    const __m128 ax = _mm_min_ps(abs4(x), _mm_set1_ps(1.0f));
+    __m128 p = _mm_add_ps(_mm_set1_ps(ACOS_C6), _mm_mul_ps(ax, _mm_set1_ps(ACOS_C7)));
+    p = _mm_add_ps(_mm_set1_ps(ACOS_C5), _mm_mul_ps(ax, p));
+    p = _mm_add_ps(_mm_set1_ps(ACOS_C4), _mm_mul_ps(ax, p));
+    p = _mm_add_ps(_mm_set1_ps(ACOS_C3), _mm_mul_ps(ax, p));
+    p = _mm_add_ps(_mm_set1_ps(ACOS_C2), _mm_mul_ps(ax, p));
+    p = _mm_add_ps(_mm_set1_ps(ACOS_C1), _mm_mul_ps(ax, p));
+    p = _mm_add_ps(_mm_set1_ps(ACOS_C0), _mm_mul_ps(ax, p));
+    const __m128 r = _mm_mul_ps(_mm_sqrt_ps(_mm_sub_ps(_mm_set1_ps(1.0f), ax)), p);
+    return select4(_mm_cmplt_ps(x, _mm_setzero_ps()), _mm_sub_ps(_mm_set1_ps(PI_F), r), r);
+}
+
+#endif // ALG_SIMD_SSE2
+
+// =============================================================================
+// Batch (spans)
+// =============================================================================
+
+/**
+ * @brief sincos over an array of angles
+ * @param x Angles in radians
+ * @param s Receives sin(x[i]); at least x.size() elements
+ * @param c Receives cos(x[i]); at least x.size() elements
+ */
+inline void sincos(std::span<const float> x, std::span<float> s, std::span<float> c) noexcept {
+    const std::size_t n = x.size();
+    std::size_t i = 0;
+#if defined(ALG_SIMD_SSE2)
+    for (; i + 4 <= n; i += 4) {
+        __m128 vs, vc;
+        sincos4(_mm_loadu_ps(x.data() + i), vs, vc);
+        _mm_storeu_ps(s.data() + i, vs);
+        _mm_storeu_ps(c.data() + i, vc);
+    }
+#endif
+    for (; i < n; ++i) {
+        sincos(x[i], s[i], c[i]);
+    }
+}
+
+/**
+ * @brief 1/sqrt over an array (out may alias x)
+ */
+inline void rsqrt(std::span<const float> x, std::span<float> out) noexcept {
+    const std::size_t n = x.size();
+    std::size_t i = 0;
+#if defined(ALG_SIMD_SSE2)
+    for (; i + 4 <= n; i += 4) {
+        _mm_storeu_ps(out.data() + i, rsqrt4(_mm_loadu_ps(x.data() + i)));
+    }
+#endif
+    for (; i < n; ++i) {
+        out[i] = rsqrt(x[i]);
+    }
+}
+
+/**
+ * @brief atan2 over paired arrays (out may alias y or x)
+ */
+inline void atan2(std::span<const float> y, std::span<const float> x, std::span<float> out) noexcept {
+    const std::size_t n = y.size();
+    std::size_t i = 0;
+#if defined(ALG_SIMD_SSE2)
+    for (; i + 4 <= n; i += 4) {
+        _mm_storeu_ps(out.data() + i, atan2_4(_mm_loadu_ps(y.data() + i), _mm_loadu_ps(x.data() + i)));
+    }
+#endif
+    for (; i < n; ++i) {
+        out[i] = atan2(y[i], x[i]);
+    }
+}
+
+/**
+ * @brief acos over an array (out may alias x)
+ */
+inline void acos(std::span<const float> x, std::span<float> out) noexcept {
+    const std::size_t n = x.size();
+    std::size_t i = 0;
+#if defined(ALG_SIMD_SSE2)
+    for (; i + 4 <= n; i += 4) {
+        _mm_storeu_ps(out.data() + i, acos4(_mm_loadu_ps(x.data() + i)));
+    }
+#endif
+    for (; i < n; ++i) {
+        out[i] = acos(x[i]);
+    }
+}
+
+} // namespace alg::fast
+
+/**
+ * @namespace alg::hot
+ * @brief Math entry points for hot paths, selected at compile time
+ *
+ * Forward to alg::fast when ALG_FAST_MATH is defined and to <cmath>
+ * otherwise, so call sites (camera vectors, light directions, rotation
+ * matrices) opt in once instead of repeating the #if.
+ */
+namespace alg::hot {
+
+inline void sincos(float x, float& s, float& c) noexcept {
+#if defined(ALG_FAST_MATH)
+    fast::sincos(x, s, c);
+#else
+    s = std::sin(x);
+    c = std::cos(x);
+#endif
+}
+
+inline float sin(float x) noexcept {
+#if defined(ALG_FAST_MATH)
+    return fast::sin(x);
+#else
+    return std::sin(x);
+#endif
+}
+
+inline float cos(float x) noexcept {
+#if defined(ALG_FAST_MATH)
+    return fast::cos(x);
+#else
+    return std::cos(x);
+#endif
+}
+
+} // namespace alg::hot
+
+#endif // FAST_MATH_HPP
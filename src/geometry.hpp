@@ -0,0 +1,819 @@
+#ifndef GEOMETRY_HPP
+#define GEOMETRY_HPP
+
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+#include "algebra.hpp"
+#include "algebra_batch.hpp"
+
+/**
+ * @file geometry.hpp
+ * @brief Bounding volumes and intersection tests
+ *
+ * Value types for visibility and picking: axis-aligned boxes, spheres,
+ * planes, rays and view frustums. Single-object tests are plain inline
+ * functions; alg::batch adds SIMD versions that test one frustum or ray
+ * against whole arrays of volumes (4 per iteration with SSE2, 8 with AVX2).
+ *
+ * Conventions:
+ * - Planes are n·p + d = 0 with n pointing to the inside (kept) half-space
+ * - Rays are origin + t * direction, t >= 0
+ */
+namespace alg {
+
+// =============================================================================
+// AABB (Axis-Aligned Bounding Box)
+// =============================================================================
+
+/**
+ * @struct AABB
+ * @brief Axis-aligned box stored as min/max corners
+ *
+ * Default-constructed boxes are empty (min = +inf, max = -inf) so that
+ * expanding by the first point yields that point.
+ */
+struct AABB {
+    Vec3 min = Vec3(std::numeric_limits<float>::infinity(),
+                    std::numeric_limits<float>::infinity(),
+                    std::numeric_limits<float>::infinity());
+    Vec3 max = Vec3(-std::numeric_limits<float>::infinity(),
+                    -std::numeric_limits<float>::infinity(),
+                    -std::numeric_limits<float>::infinity());
+
+    AABB() = default;
+    constexpr AABB(const Vec3& min_in, const Vec3& max_in) noexcept : min(min_in), max(max_in) {}
+
+    /**
+     * @brief Box from center and half-size
+     */
+    static constexpr AABB from_center_extents(const Vec3& center, const Vec3& extents) noexcept {
+        return AABB(center - extents, center + extents);
+    }
+
+    /**
+     * @brief Tightest box around a point set
+     * @return Empty box when points is empty
+     */
+    static AABB from_points(std::span<const Vec3> points) noexcept {
+        AABB box;
+        for (const Vec3& p : points) {
+            box.expand(p);
+        }
+        return box;
+    }
+
+    constexpr bool is_empty() const noexcept {
+        return min.x > max.x || min.y > max.y || min.z > max.z;
+    }
+
+    constexpr Vec3 center() const noexcept {
+        return (min + max) * 0.5f;
+    }
+
+    constexpr Vec3 extents() const noexcept {
+        return (max - min) * 0.5f;
+    }
+
+    /**
+     * @brief Total surface area (used as the SAH cost metric)
+     */
+    constexpr float surface_area() const noexcept {
+        const Vec3 d = max - min;
+        return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+    }
+
+    /**
+     * @brief Grow to include a point
+     */
+    void expand(const Vec3& p) noexcept {
+        min = Vec3(min_component(min.x, p.x), min_component(min.y, p.y), min_component(min.z, p.z));
+        max = Vec3(max_component(max.x, p.x), max_component(max.y, p.y), max_component(max.z, p.z));
+    }
+
+    /**
+     * @brief Grow to include another box
+     */
+    void expand(const AABB& other) noexcept {
+        min = Vec3(min_component(min.x, other.min.x), min_component(min.y, other.min.y), min_component(min.z, other.min.z));
+        max = Vec3(max_component(max.x, other.max.x), max_component(max.y, other.max.y), max_component(max.z, other.max.z));
+    }
+
+    /**
+     * @brief min/max used by expand()
+     *
+     * By value and written so the compiler emits minss/maxss: std::fmin/fmax
+     * are library calls without -ffast-math, and std::min/max on references
+     * often become compare-and-branch, which mispredicts on scattered data.
+     * Both dominated BVH builds.
+     */
+    static constexpr float min_component(float a, float b) noexcept { return b < a ? b : a; }
+    static constexpr float max_component(float a, float b) noexcept { return a < b ? b : a; }
+
+    constexpr bool contains(const Vec3& p) const noexcept {
+        return p.x >= min.x && p.x <= max.x &&
+               p.y >= min.y && p.y <= max.y &&
+               p.z >= min.z && p.z <= max.z;
+    }
+
+    constexpr bool contains(const AABB& other) const noexcept {
+        return contains(other.min) && contains(other.max);
+    }
+
+    constexpr bool overlaps(const AABB& other) const noexcept {
+        return min.x <= other.max.x && max.x >= other.min.x &&
+               min.y <= other.max.y && max.y >= other.min.y &&
+               min.z <= other.max.z && max.z >= other.min.z;
+    }
+
+    /**
+     * @brief Bounds of this box after an affine transform
+     * @param m Affine transform (projections are not supported)
+     * @return Tightest AABB enclosing the transformed box
+     *
+     * Arvo's method in center/extent form: the center is transformed as a
+     * point and the new half-size is |M₃ₓ₃| · extents, which is the same
+     * result as transforming all 8 corners at a fraction of the cost.
+     */
+    AABB transformed(const Mat4& m) const noexcept {
+        const Vec3 c = m * center();
+        const Vec3 e = extents();
+        const Vec3 new_e(
+            std::fabs(m.m[0]) * e.x + std::fabs(m.m[4]) * e.y + std::fabs(m.m[8])  * e.z,
+            std::fabs(m.m[1]) * e.x + std::fabs(m.m[5]) * e.y + std::fabs(m.m[9])  * e.z,
+            std::fabs(m.m[2]) * e.x + std::fabs(m.m[6]) * e.y + std::fabs(m.m[10]) * e.z
+        );
+        return AABB(c - new_e, c + new_e);
+    }
+
+    constexpr bool operator==(const AABB& other) const {
+        return min == other.min && max == other.max;
+    }
+};
+
+/**
+ * @brief Union of two boxes
+ */
+inline AABB merge(const AABB& a, const AABB& b) noexcept {
+    AABB r = a;
+    r.expand(b);
+    return r;
+}
+
+// =============================================================================
+// Sphere
+// =============================================================================
+
+/**
+ * @struct Sphere
+ * @brief Bounding sphere (16 bytes: fits one SIMD register)
+ */
+struct Sphere {
+    Vec3 center;
+    float radius = 0.0f;
+
+    Sphere() = default;
+    constexpr Sphere(const Vec3& c, float r) noexcept : center(c), radius(r) {}
+
+    /**
+     * @brief Sphere enclosing a box (not the tightest for the point set)
+     */
+    static Sphere from_aabb(const AABB& box) noexcept {
+        return Sphere(box.center(), box.extents().magnitude());
+    }
+
+    constexpr bool contains(const Vec3& p) const noexcept {
+        return (p - center).magnitude_squared() <= radius * radius;
+    }
+};
+
+// =============================================================================
+// Plane
+// =============================================================================
+
+/**
+ * @struct Plane
+ * @brief Plane n·p + d = 0; positive side is "inside"
+ */
+struct Plane {
+    Vec3 normal = Vec3(0.0f, 1.0f, 0.0f);
+    float d = 0.0f;
+
+    Plane() = default;
+    constexpr Plane(const Vec3& n, float d_in) noexcept : normal(n), d(d_in) {}
+
+    /**
+     * @brief Plane through a point with the given normal
+     */
+    static constexpr Plane from_point_normal(const Vec3& p, const Vec3& n) noexcept {
+        return Plane(n, -dot(n, p));
+    }
+
+    /**
+     * @brief Signed distance (exact only when normal is unit length)
+     */
+    constexpr float distance(const Vec3& p) const noexcept {
+        return dot(normal, p) + d;
+    }
+
+    /**
+     * @brief Scale so the normal has unit length
+     */
+    Plane normalized() const noexcept {
+        const float mag = normal.magnitude();
+        if (mag > 0.0f) {
+            return Plane(normal / mag, d / mag);
+        }
+        return *this;
+    }
+};
+
+// =============================================================================
+// Ray
+// =============================================================================
+
+/**
+ * @struct Ray
+ * @brief Half-line origin + t * direction
+ *
+ * inv_direction is cached for the slab tests; build rays through the
+ * constructor so it stays consistent with direction.
+ */
+struct Ray {
+    Vec3 origin;
+    Vec3 direction = Vec3(0.0f, 0.0f, -1.0f);
+    Vec3 inv_direction = Vec3(std::numeric_limits<float>::infinity(),
+                              std::numeric_limits<float>::infinity(), -1.0f);
+
+    Ray() = default;
+    Ray(const Vec3& o, const Vec3& dir) noexcept
+        : origin(o), direction(dir), inv_direction(1.0f / dir.x, 1.0f / dir.y, 1.0f / dir.z) {}
+
+    constexpr Vec3 at(float t) const noexcept {
+        return origin + direction * t;
+    }
+};
+
+// =============================================================================
+// Frustum
+// =============================================================================
+
+/**
+ * @struct Frustum
+ * @brief Six inward-facing planes of a view volume
+ */
+struct Frustum {
+    // SIDE_ prefix: NEAR/FAR are macros in <windows.h>, LEFT/RIGHT are Camera_Movement values
+    enum Side { SIDE_LEFT = 0, SIDE_RIGHT, SIDE_BOTTOM, SIDE_TOP, SIDE_NEAR, SIDE_FAR, SIDE_COUNT };
+
+    Plane planes[SIDE_COUNT];
+
+    /**
+     * @brief Extract planes from a combined view-projection matrix
+     * @param view_proj projection * view (world space planes), or
+     *        projection alone (view space planes)
+     *
+     * Gribb-Hartmann: in clip space a point is inside when -w <= x,y,z <= w,
+     * so each plane is row 3 ± row i of the matrix. Planes are normalized
+     * so distance() returns true distances.
+     */
+    static Frustum from_matrix(const Mat4& view_proj) noexcept {
+        const float* m = view_proj.m;
+        auto row = [m](int r) { return Vec4(m[r], m[4 + r], m[8 + r], m[12 + r]); };
+        const Vec4 r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+        auto plane = [](const Vec4& a, const Vec4& b, float sign) {
+            return Plane(Vec3(a.x + sign * b.x, a.y + sign * b.y, a.z + sign * b.z), a.w + sign * b.w).normalized();
+        };
+
+        Frustum f;
+        f.planes[SIDE_LEFT]   = plane(r3, r0,  1.0f);
+        f.planes[SIDE_RIGHT]  = plane(r3, r0, -1.0f);
+        f.planes[SIDE_BOTTOM] = plane(r3, r1,  1.0f);
+        f.planes[SIDE_TOP]    = plane(r3, r1, -1.0f);
+        f.planes[SIDE_NEAR]   = plane(r3, r2,  1.0f);
+        f.planes[SIDE_FAR]    = plane(r3, r2, -1.0f);
+        return f;
+    }
+};
+
+// =============================================================================
+// Triangles
+// =============================================================================
+
+/**
+ * @struct TriangleSoA
+ * @brief Triangles stored as one vertex plus two edges, structure-of-arrays
+ *
+ * The layout batch::raycast_triangles reads four lanes at a time from any
+ * start index. Arrays are padded with 3 degenerate triangles (zero edges,
+ * never hit) so a 4-wide load at the last triangle stays in bounds.
+ */
+struct TriangleSoA {
+    std::vector<float> v0x, v0y, v0z;
+    std::vector<float> e1x, e1y, e1z;
+    std::vector<float> e2x, e2y, e2z;
+
+    void resize(std::size_t n) {
+        for (std::vector<float>* a : {&v0x, &v0y, &v0z, &e1x, &e1y, &e1z, &e2x, &e2y, &e2z}) {
+            a->assign(n + 3, 0.0f);
+        }
+    }
+
+    std::size_t size() const noexcept { return v0x.empty() ? 0 : v0x.size() - 3; }
+
+    void set(std::size_t i, const Vec3& a, const Vec3& b, const Vec3& c) noexcept {
+        const Vec3 e1 = b - a;
+        const Vec3 e2 = c - a;
+        v0x[i] = a.x; v0y[i] = a.y; v0z[i] = a.z;
+        e1x[i] = e1.x; e1y[i] = e1.y; e1z[i] = e1.z;
+        e2x[i] = e2.x; e2y[i] = e2.y; e2z[i] = e2.z;
+    }
+};
+
+// =============================================================================
+// Single-Object Tests
+// =============================================================================
+
+/**
+ * @brief Conservative frustum/box test
+ * @return false when the box is entirely outside one plane, or empty
+ *
+ * Boxes near frustum corners may be reported visible although they are
+ * outside; that is the usual trade-off for culling. Empty boxes (e.g. a
+ * default AABB, whose center is NaN) are always culled.
+ */
+inline bool intersects(const Frustum& f, const AABB& box) noexcept {
+    if (box.is_empty()) {
+        return false;
+    }
+    const Vec3 c = box.center();
+    const Vec3 e = box.extents();
+    for (const Plane& p : f.planes) {
+        const float r = std::fabs(p.normal.x) * e.x + std::fabs(p.normal.y) * e.y + std::fabs(p.normal.z) * e.z;
+        if (p.distance(c) + r < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Conservative frustum/sphere test
+ */
+inline bool intersects(const Frustum& f, const Sphere& s) noexcept {
+    for (const Plane& p : f.planes) {
+        if (p.distance(s.center) + s.radius < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Squared distance from a point to the closest point of a box
+ * @return 0 when the point is inside
+ */
+inline float distance_squared(const AABB& box, const Vec3& p) noexcept {
+    const float dx = std::fmax(std::fmax(box.min.x - p.x, p.x - box.max.x), 0.0f);
+    const float dy = std::fmax(std::fmax(box.min.y - p.y, p.y - box.max.y), 0.0f);
+    const float dz = std::fmax(std::fmax(box.min.z - p.z, p.z - box.max.z), 0.0f);
+    return dx * dx + dy * dy + dz * dz;
+}
+
+/**
+ * @brief Exact sphere/box overlap test
+ */
+inline bool intersects(const Sphere& s, const AABB& box) noexcept {
+    return distance_squared(box, s.center) <= s.radius * s.radius;
+}
+
+/**
+ * @brief Ray/box slab test
+ * @param ray Ray with cached inverse direction
+ * @param box Box to test
+ * @param t_hit Receives the entry distance (0 when the origin is inside)
+ * @return true when the ray hits the box at t >= 0
+ */
+inline bool intersect(const Ray& ray, const AABB& box, float& t_hit) noexcept {
+    const float tx1 = (box.min.x - ray.origin.x) * ray.inv_direction.x;
+    const float tx2 = (box.max.x - ray.origin.x) * ray.inv_direction.x;
+    const float ty1 = (box.min.y - ray.origin.y) * ray.inv_direction.y;
+    const float ty2 = (box.max.y - ray.origin.y) * ray.inv_direction.y;
+    const float tz1 = (box.min.z - ray.origin.z) * ray.inv_direction.z;
+    const float tz2 = (box.max.z - ray.origin.z) * ray.inv_direction.z;
+
+    const float t_near = std::fmax(std::fmax(std::fmin(tx1, tx2), std::fmin(ty1, ty2)), std::fmin(tz1, tz2));
+    const float t_far = std::fmin(std::fmin(std::fmax(tx1, tx2), std::fmax(ty1, ty2)), std::fmax(tz1, tz2));
+
+    if (t_far < 0.0f || t_near > t_far) {
+        return false;
+    }
+    t_hit = t_near > 0.0f ? t_near : 0.0f;
+    return true;
+}
+
+/**
+ * @brief Ray/sphere test
+ * @param t_hit Receives the entry distance (0 when the origin is inside)
+ */
+inline bool intersect(const Ray& ray, const Sphere& s, float& t_hit) noexcept {
+    const Vec3 oc = ray.origin - s.center;
+    const float a = dot(ray.direction, ray.direction);
+    const float b = dot(oc, ray.direction);
+    const float c = dot(oc, oc) - s.radius * s.radius;
+    const float disc = b * b - a * c;
+    if (disc < 0.0f || a == 0.0f) {
+        return false;
+    }
+    const float sq = std::sqrt(disc);
+    const float t0 = (-b - sq) / a;
+    const float t1 = (-b + sq) / a;
+    if (t1 < 0.0f) {
+        return false;
+    }
+    t_hit = t0 > 0.0f ? t0 : 0.0f;
+    return true;
+}
+
+/**
+ * @brief Ray/triangle test (Möller-Trumbore, double-sided)
+ * @param t_hit Receives the hit distance
+ * @return true when the ray hits the triangle at t >= 0
+ */
+inline bool intersect(const Ray& ray, const Vec3& a, const Vec3& b, const Vec3& c, float& t_hit) noexcept {
+    constexpr float EPSILON = 1e-12f;
+    const Vec3 e1 = b - a;
+    const Vec3 e2 = c - a;
+    const Vec3 p = cross(ray.direction, e2);
+    const float det = dot(e1, p);
+    if (std::fabs(det) < EPSILON) {
+        return false; // Parallel to the plane, or degenerate
+    }
+    const float inv_det = 1.0f / det;
+    const Vec3 s = ray.origin - a;
+    const float u = dot(s, p) * inv_det;
+    if (u < 0.0f || u > 1.0f) {
+        return false;
+    }
+    const Vec3 q = cross(s, e1);
+    const float v = dot(ray.direction, q) * inv_det;
+    if (v < 0.0f || u + v > 1.0f) {
+        return false;
+    }
+    const float t = dot(e2, q) * inv_det;
+    if (t < 0.0f) {
+        return false;
+    }
+    t_hit = t;
+    return true;
+}
+
+// =============================================================================
+// Batched Tests
+// =============================================================================
+
+namespace batch {
+
+static_assert(sizeof(AABB) == 6 * sizeof(float), "batch tests assume packed AABB arrays");
+static_assert(sizeof(Sphere) == 4 * sizeof(float), "batch tests assume packed Sphere arrays");
+
+#if defined(ALG_SIMD_SSE2)
+namespace detail {
+
+/**
+ * @brief Load four AABBs as SoA center/extents registers
+ *
+ * A packed AABB array is a Vec3 array alternating min, max; two Vec3
+ * transposes give (min0 max0 min1 max1) and (min2 max2 min3 max3) per
+ * axis, which are then split into mins and maxes. `nonempty` is the lane
+ * mask of !AABB::is_empty().
+ */
+struct Boxes4 {
+    __m128 cx, cy, cz, ex, ey, ez;
+    __m128 nonempty = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+    explicit Boxes4(const AABB* boxes) noexcept {
+        const float* p = &boxes->min.x;
+        __m128 ax, ay, az, bx, by, bz;
+        load_soa(p, ax, ay, az);
+        load_soa(p + 12, bx, by, bz);
+        const __m128 half = _mm_set1_ps(0.5f);
+        auto split = [&](__m128 a, __m128 b, __m128& c, __m128& e) {
+            const __m128 mn = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+            const __m128 mx = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+            c = _mm_mul_ps(_mm_add_ps(mn, mx), half);
+            e = _mm_mul_ps(_mm_sub_ps(mx, mn), half);
+            nonempty = _mm_and_ps(nonempty, _mm_cmpngt_ps(mn, mx));
+        };
+        split(ax, bx, cx, ex);
+        split(ay, by, cy, ey);
+        split(az, bz, cz, ez);
+    }
+};
+
+/**
+ * @brief Frustum planes broadcast to registers, with |n| precomputed
+ */
+struct FrustumPlanes4 {
+    __m128 nx[6], ny[6], nz[6], ax[6], ay[6], az[6], d[6];
+
+    explicit FrustumPlanes4(const Frustum& f) noexcept {
+        for (int i = 0; i < 6; ++i) {
+            const Plane& p = f.planes[i];
+            nx[i] = _mm_set1_ps(p.normal.x);
+            ny[i] = _mm_set1_ps(p.normal.y);
+            nz[i] = _mm_set1_ps(p.normal.z);
+            ax[i] = _mm_set1_ps(std::fabs(p.normal.x));
+            ay[i] = _mm_set1_ps(std::fabs(p.normal.y));
+            az[i] = _mm_set1_ps(std::fabs(p.normal.z));
+            d[i]  = _mm_set1_ps(p.d);
+        }
+    }
+
+    /// Lane mask: all bits set where the box is non-empty and not outside any plane
+    __m128 test(const Boxes4& b) const noexcept {
+        __m128 inside = b.nonempty;
+        for (int i = 0; i < 6; ++i) {
+            __m128 dist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx[i], b.cx), _mm_mul_ps(ny[i], b.cy)),
+                                     _mm_add_ps(_mm_mul_ps(nz[i], b.cz), d[i]));
+            __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax[i], b.ex), _mm_mul_ps(ay[i], b.ey)),
+                                  _mm_mul_ps(az[i], b.ez));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(dist, r), _mm_setzero_ps()));
+        }
+        return inside;
+    }
+};
+
+/**
+ * @brief Lane-wise std::fmin: a NaN operand is dropped (NaN only if both are)
+ *
+ * _mm_min_ps returns its second operand whenever either is NaN, so the
+ * lanes where b is NaN take a instead.
+ */
+inline __m128 fmin_ps(__m128 a, __m128 b) noexcept {
+    const __m128 b_nan = _mm_cmpunord_ps(b, b);
+    return _mm_or_ps(_mm_and_ps(b_nan, a), _mm_andnot_ps(b_nan, _mm_min_ps(a, b)));
+}
+
+/**
+ * @brief Lane-wise std::fmax, same NaN handling as fmin_ps
+ */
+inline __m128 fmax_ps(__m128 a, __m128 b) noexcept {
+    const __m128 b_nan = _mm_cmpunord_ps(b, b);
+    return _mm_or_ps(_mm_and_ps(b_nan, a), _mm_andnot_ps(b_nan, _mm_max_ps(a, b)));
+}
+
+} // namespace detail
+#endif // ALG_SIMD_SSE2
+
+/**
+ * @brief Frustum-cull N boxes
+ * @param frustum View frustum (e.g. Frustum::from_matrix(projection * view))
+ * @param boxes World-space bounds
+ * @param visible Receives 1 for boxes that may be visible, 0 otherwise
+ * @return Number of visible boxes
+ *
+ * Same conservative test as intersects(Frustum, AABB), empty boxes
+ * included (always culled). Four boxes per
+ * iteration with SSE2; AVX2 builds run two 4-box groups per iteration
+ * to keep both halves of the pipeline busy.
+ */
+inline std::size_t cull_aabbs(const Frustum& frustum, std::span<const AABB> boxes, std::span<std::uint8_t> visible) noexcept {
+    const std::size_t n = boxes.size();
+    std::size_t count = 0;
+    std::size_t i = 0;
+#if defined(ALG_SIMD_SSE2)
+    const detail::FrustumPlanes4 planes(frustum);
+#if defined(ALG_SIMD_AVX2)
+    for (; i + 8 <= n; i += 8) {
+        const int m0 = _mm_movemask_ps(planes.test(detail::Boxes4(boxes.data() + i)));
+        const int m1 = _mm_movemask_ps(planes.test(detail::Boxes4(boxes.data() + i + 4)));
+        const int mask = m0 | (m1 << 4);
+        for (int k = 0; k < 8; ++k) {
+            visible[i + k] = static_cast<std::uint8_t>((mask >> k) & 1);
+        }
+        count += static_cast<std::size_t>(std::popcount(static_cast<unsigned>(mask)));
+    }
+#endif
+    for (; i + 4 <= n; i += 4) {
+        const int mask = _mm_movemask_ps(planes.test(detail::Boxes4(boxes.data() + i)));
+        for (int k = 0; k < 4; ++k) {
+            const std::uint8_t v = static_cast<std::uint8_t>((mask >> k) & 1);
+            visible[i + k] = v;
+            count += v;
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        const std::uint8_t v = intersects(frustum, boxes[i]) ? 1 : 0;
+        visible[i] = v;
+        count += v;
+    }
+    return count;
+}
+
+/**
+ * @brief Frustum-cull N spheres
+ * @return Number of visible spheres; visible[i] is 1 or 0
+ *
+ * Spheres are 16 bytes, so four of them transpose straight into
+ * x/y/z/radius registers.
+ */
+inline std::size_t cull_spheres(const Frustum& frustum, std::span<const Sphere> spheres, std::span<std::uint8_t> visible) noexcept {
+    const std::size_t n = spheres.size();
+    std::size_t count = 0;
+    std::size_t i = 0;
+#if defined(ALG_SIMD_SSE2)
+    const detail::FrustumPlanes4 planes(frustum);
+    for (; i + 4 <= n; i += 4) {
+        const float* p = &spheres[i].center.x;
+        __m128 x = _mm_loadu_ps(p + 0);
+        __m128 y = _mm_loadu_ps(p + 4);
+        __m128 z = _mm_loadu_ps(p + 8);
+        __m128 r = _mm_loadu_ps(p + 12);
+        _MM_TRANSPOSE4_PS(x, y, z, r);
+
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (int k = 0; k < 6; ++k) {
+            const __m128 dist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(planes.nx[k], x), _mm_mul_ps(planes.ny[k], y)),
+                                           _mm_add_ps(_mm_mul_ps(planes.nz[k], z), planes.d[k]));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(dist, r), _mm_setzero_ps()));
+        }
+        const int mask = _mm_movemask_ps(inside);
+        for (int k = 0; k < 4; ++k) {
+            const std::uint8_t v = static_cast<std::uint8_t>((mask >> k) & 1);
+            visible[i + k] = v;
+            count += v;
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        const std::uint8_t v = intersects(frustum, spheres[i]) ? 1 : 0;
+        visible[i] = v;
+        count += v;
+    }
+    return count;
+}
+
+/**
+ * @brief Cast one ray against N boxes
+ * @param ray Ray with cached inverse direction
+ * @param boxes Boxes to test
+ * @param t_hit Receives the entry distance per box, +inf on a miss
+ * @return Number of boxes hit
+ *
+ * Slab test four boxes at a time. Axis-parallel rays whose origin lies
+ * exactly on a slab boundary produce 0 * inf = NaN; the min/max steps drop
+ * it like the std::fmin/std::fmax of the scalar intersect(), so every box
+ * gets the same hit/miss and t as intersect() would give it.
+ */
+inline std::size_t raycast_aabbs(const Ray& ray, std::span<const AABB> boxes, std::span<float> t_hit) noexcept {
+    const std::size_t n = boxes.size();
+    constexpr float INF = std::numeric_limits<float>::infinity();
+    std::size_t count = 0;
+    std::size_t i = 0;
+#if defined(ALG_SIMD_SSE2)
+    const __m128 ox = _mm_set1_ps(ray.origin.x), oy = _mm_set1_ps(ray.origin.y), oz = _mm_set1_ps(ray.origin.z);
+    const __m128 ix = _mm_set1_ps(ray.inv_direction.x), iy = _mm_set1_ps(ray.inv_direction.y), iz = _mm_set1_ps(ray.inv_direction.z);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 inf = _mm_set1_ps(INF);
+    for (; i + 4 <= n; i += 4) {
+        const float* p = &boxes[i].min.x;
+        __m128 ax, ay, az, bx, by, bz;
+        detail::load_soa(p, ax, ay, az);
+        detail::load_soa(p + 12, bx, by, bz);
+
+        auto slab = [](__m128 a, __m128 b, __m128 o, __m128 inv, __m128& lo, __m128& hi) {
+            const __m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)), o), inv);
+            const __m128 t2 = _mm_mul_ps(_mm_sub_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)), o), inv);
+            lo = detail::fmin_ps(t1, t2);
+            hi = detail::fmax_ps(t1, t2);
+        };
+        __m128 lx, hx, ly, hy, lz, hz;
+        slab(ax, bx, ox, ix, lx, hx);
+        slab(ay, by, oy, iy, ly, hy);
+        slab(az, bz, oz, iz, lz, hz);
+
+        const __m128 t_near = detail::fmax_ps(detail::fmax_ps(lx, ly), lz);
+        const __m128 t_far = detail::fmin_ps(detail::fmin_ps(hx, hy), hz);
+        // Hit unless t_far < 0 or t_near > t_far, as in intersect() (a NaN
+        // left over, from a box flat on the origin's plane, rejects nothing)
+        const __m128 hit = _mm_and_ps(_mm_cmpnlt_ps(t_far, zero), _mm_cmpngt_ps(t_near, t_far));
+        // t_near > 0 ? t_near : 0 (max_ps returns the zero for NaN lanes)
+        const __m128 t = _mm_max_ps(t_near, zero);
+        _mm_storeu_ps(t_hit.data() + i, _mm_or_ps(_mm_and_ps(hit, t), _mm_andnot_ps(hit, inf)));
+        const int mask = _mm_movemask_ps(hit);
+        count += static_cast<std::size_t>(std::popcount(static_cast<unsigned>(mask)));
+    }
+#endif
+    for (; i < n; ++i) {
+        float t;
+        if (intersect(ray, boxes[i], t)) {
+            t_hit[i] = t;
+            ++count;
+        } else {
+            t_hit[i] = INF;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Closest hit among triangles [first, first + count)
+ * @param t_best In: only hits closer than this count. Out: the closest hit
+ * @return Index of the closest triangle hit, or SIZE_MAX when none beats t_best
+ *
+ * Same test as the scalar intersect(), four triangles per iteration.
+ */
+inline std::size_t raycast_triangles(const Ray& ray, const TriangleSoA& tris,
+                                     std::size_t first, std::size_t count, float& t_best) noexcept {
+    std::size_t best = SIZE_MAX;
+    const std::size_t end = first + count;
+    std::size_t i = first;
+#if defined(ALG_SIMD_SSE2)
+    const __m128 dx = _mm_set1_ps(ray.direction.x), dy = _mm_set1_ps(ray.direction.y), dz = _mm_set1_ps(ray.direction.z);
+    const __m128 ox = _mm_set1_ps(ray.origin.x), oy = _mm_set1_ps(ray.origin.y), oz = _mm_set1_ps(ray.origin.z);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 epsilon = _mm_set1_ps(1e-12f);
+    const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    const __m128i lane = _mm_set_epi32(3, 2, 1, 0);
+    for (; i < end; i += 4) {
+        const __m128 e1x = _mm_loadu_ps(&tris.e1x[i]), e1y = _mm_loadu_ps(&tris.e1y[i]), e1z = _mm_loadu_ps(&tris.e1z[i]);
+        const __m128 e2x = _mm_loadu_ps(&tris.e2x[i]), e2y = _mm_loadu_ps(&tris.e2y[i]), e2z = _mm_loadu_ps(&tris.e2z[i]);
+
+        // p = d x e2, det = e1 . p
+        const __m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+        const __m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+        const __m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+        const __m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+        const __m128 inv_det = _mm_div_ps(one, det);
+
+        // s = o - v0, u = (s . p) / det
+        const __m128 sx = _mm_sub_ps(ox, _mm_loadu_ps(&tris.v0x[i]));
+        const __m128 sy = _mm_sub_ps(oy, _mm_loadu_ps(&tris.v0y[i]));
+        const __m128 sz = _mm_sub_ps(oz, _mm_loadu_ps(&tris.v0z[i]));
+        const __m128 u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, px), _mm_mul_ps(sy, py)), _mm_mul_ps(sz, pz)), inv_det);
+
+        // q = s x e1, v = (d . q) / det, t = (e2 . q) / det
+        const __m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+        const __m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+        const __m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+        const __m128 v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)), inv_det);
+        const __m128 t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), inv_det);
+
+        // Lanes past the range are masked off; degenerate padding fails the det test
+        const __m128 in_range = _mm_castsi128_ps(_mm_cmplt_epi32(lane, _mm_set1_epi32(static_cast<int>(end - i))));
+        __m128 hit = _mm_and_ps(in_range, _mm_cmpge_ps(_mm_and_ps(det, abs_mask), epsilon));
+        hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmpge_ps(u, zero), _mm_cmpge_ps(v, zero)));
+        hit = _mm_and_ps(hit, _mm_cmple_ps(_mm_add_ps(u, v), one));
+        hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmpge_ps(t, zero), _mm_cmplt_ps(t, _mm_set1_ps(t_best))));
+
+        int mask = _mm_movemask_ps(hit);
+        if (mask == 0) {
+            continue;
+        }
+        alignas(16) float ts[4];
+        _mm_store_ps(ts, t);
+        while (mask) {
+            const int k = std::countr_zero(static_cast<unsigned>(mask));
+            mask &= mask - 1;
+            if (ts[k] < t_best) {
+                t_best = ts[k];
+                best = i + static_cast<std::size_t>(k);
+            }
+        }
+    }
+#else
+    for (; i < end; ++i) {
+        const Vec3 a(tris.v0x[i], tris.v0y[i], tris.v0z[i]);
+        const Vec3 b = a + Vec3(tris.e1x[i], tris.e1y[i], tris.e1z[i]);
+        const Vec3 c = a + Vec3(tris.e2x[i], tris.e2y[i], tris.e2z[i]);
+        float t;
+        if (intersect(ray, a, b, c, t) && t < t_best) {
+            t_best = t;
+            best = i;
+        }
+    }
+#endif
+    return best;
+}
+
+/**
+ * @brief Transform N boxes by one matrix (see AABB::transformed)
+ */
+inline void transform_aabbs(const Mat4& m, std::span<const AABB> in, std::span<AABB> out) noexcept {
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        out[i] = in[i].transformed(m);
+    }
+}
+
+} // namespace batch
+
+} // namespace alg
+
+#endif // GEOMETRY_HPP
@@ -15,9 +15,17 @@
 
 #include "UIManager.hpp"
 #include "ResourceManager.hpp"
+#include "JobSystem.hpp"
+#include "FrameGraph.hpp"
+#include "FrameData.hpp"
+#include "Renderer.hpp"
+#include "LightSelection.hpp"
 
 const unsigned int SCR_WIDTH = 1920;
 const unsigned int SCR_HEIGHT = 1080;
+// Planos da projeção (também limitam as fatias dos clusters de luz)
+const float NEAR_PLANE = 0.1f;
+const float FAR_PLANE = 100.0f;
 // --- Câmera ---
 // Instancia a câmera com uma posição inicial mais afastada
 Camera camera(alg::Vec3(0.0f, 0.0f, 5.0f));
@@ -26,6 +34,12 @@ float lastY = SCR_HEIGHT / 2.0f;
 bool firstMouse = true;
 bool cameraActive = false;
 
+// --- Picking ---
+// O callback só registra o clique; o raio é montado no loop, onde as
+// matrizes de câmera do frame já existem
+bool pickRequested = false;
+double pickX = 0.0, pickY = 0.0;
+
 // --- Timing ---
 // Garante que o movimento seja o mesmo independente do poder do computador
 float deltaTime = 0.0f;
@@ -87,172 +101,229 @@ int main() {
 
 
 
-    Scene scene;
-    UIManager uiManager(window);
-    ResourceManager resourceManager;
-
-    // Geometria completa do cubo com posições, normais e coordenadas de textura
-    std::vector<Vertex> vertices = {
-        // Posição                // Normal(não usada ainda) // TexCoords
-        { {-0.5f, -0.5f, -0.5f}, { 0.0f,  0.0f, -1.0f}, {0.0f, 0.0f} },
-        { { 0.5f, -0.5f, -0.5f}, { 0.0f,  0.0f, -1.0f}, {1.0f, 0.0f} },
-        { { 0.5f,  0.5f, -0.5f}, { 0.0f,  0.0f, -1.0f}, {1.0f, 1.0f} },
-        { {-0.5f,  0.5f, -0.5f}, { 0.0f,  0.0f, -1.0f}, {0.0f, 1.0f} },
-
-        { {-0.5f, -0.5f,  0.5f}, { 0.0f,  0.0f,  1.0f}, {0.0f, 0.0f} },
-        { { 0.5f, -0.5f,  0.5f}, { 0.0f,  0.0f,  1.0f}, {1.0f, 0.0f} },
-        { { 0.5f,  0.5f,  0.5f}, { 0.0f,  0.0f,  1.0f}, {1.0f, 1.0f} },
-        { {-0.5f,  0.5f,  0.5f}, { 0.0f,  0.0f,  1.0f}, {0.0f, 1.0f} },
-
-        { {-0.5f,  0.5f,  0.5f}, {-1.0f,  0.0f,  0.0f}, {1.0f, 0.0f} },
-        { {-0.5f,  0.5f, -0.5f}, {-1.0f,  0.0f,  0.0f}, {1.0f, 1.0f} },
-        { {-0.5f, -0.5f, -0.5f}, {-1.0f,  0.0f,  0.0f}, {0.0f, 1.0f} },
-        { {-0.5f, -0.5f,  0.5f}, {-1.0f,  0.0f,  0.0f}, {0.0f, 0.0f} },
-
-        { { 0.5f,  0.5f,  0.5f}, { 1.0f,  0.0f,  0.0f}, {1.0f, 0.0f} },
-        { { 0.5f,  0.5f, -0.5f}, { 1.0f,  0.0f,  0.0f}, {1.0f, 1.0f} },
-        { { 0.5f, -0.5f, -0.5f}, { 1.0f,  0.0f,  0.0f}, {0.0f, 1.0f} },
-        { { 0.5f, -0.5f,  0.5f}, { 1.0f,  0.0f,  0.0f}, {0.0f, 0.0f} },
-
-        { {-0.5f, -0.5f, -0.5f}, { 0.0f, -1.0f,  0.0f}, {0.0f, 1.0f} },
-        { { 0.5f, -0.5f, -0.5f}, { 0.0f, -1.0f,  0.0f}, {1.0f, 1.0f} },
-        { { 0.5f, -0.5f,  0.5f}, { 0.0f, -1.0f,  0.0f}, {1.0f, 0.0f} },
-        { {-0.5f, -0.5f,  0.5f}, { 0.0f, -1.0f,  0.0f}, {0.0f, 0.0f} },
-
-        { {-0.5f,  0.5f, -0.5f}, { 0.0f,  1.0f,  0.0f}, {0.0f, 1.0f} },
-        { { 0.5f,  0.5f, -0.5f}, { 0.0f,  1.0f,  0.0f}, {1.0f, 1.0f} },
-        { { 0.5f,  0.5f,  0.5f}, { 0.0f,  1.0f,  0.0f}, {1.0f, 0.0f} },
-        { {-0.5f,  0.5f,  0.5f}, { 0.0f,  1.0f,  0.0f}, {0.0f, 0.0f} }
-    };
-    std::vector<unsigned int> indices = {
-        0, 1, 2,   2, 3, 0,    4, 5, 6,   6, 7, 4,
-        8, 9, 10,  10, 11, 8,  12, 13, 14, 14, 15, 12,
-        16, 17, 18, 18, 19, 16, 20, 21, 22, 22, 23, 20
-    };
-
-    // Create shared_ptr for Shader first (don't create stack-allocated ourShader)
-    auto shaderPtr = std::make_shared<Shader>("shaders/basic.vert", "shaders/basic.frag");
-    std::cout << "Shader criado com ID: " << shaderPtr->ID << std::endl;
-
-
-    auto texturePtr = createWhiteTexture();  // We'll make this a function
-
-    // Create mesh
-    auto meshPtr = std::make_shared<Mesh>(vertices, indices);
-
-    // Create entity
-    auto cubeEntity = std::make_shared<ModelEntity>(
-    meshPtr,
-    texturePtr,  // Texture comes before Shader
-    shaderPtr
-);
-    scene.addEntity(cubeEntity);
-
-    auto sunLight = std::make_shared<Light>("Sun");
-    sunLight->type = Light::Type::DIRECTIONAL;
-    sunLight->setRotation(alg::Vec3(45.0f, -30.0f, 0.0f)); // Ângulos em graus
-    sunLight->color = alg::Vec3(1.0f, 0.95f, 0.9f);
-    sunLight->intensity = 0.8f;
-    scene.addLight(sunLight);
-
-    // --- 2. Criação dos Objetos da Engine ---
-    std::cout << "\n=== INICIALIZANDO OBJETOS DA ENGINE ===" << std::endl;
-    //Shader ourShader("shaders/basic.vert", "shaders/basic.frag");
-    std::cout << "Shader criado \n";
-
-    std::cout << "Mesh criado com " << vertices.size() << " vertices e " << indices.size() << " indices" << std::endl;
+    // Tudo que tem objetos GL (cena, UI, recursos, Renderer) vive neste
+    // bloco: os destrutores chamam glDelete* e precisam do contexto, que
+    // o glfwTerminate() destrói
+    {
+        // Pool de threads (esta thread é a 0 e ajuda enquanto espera)
+        JobSystem jobs;
+
+        Scene scene;
+        UIManager uiManager(window);
+        ResourceManager resourceManager;
+
+        // Geometria completa do cubo com posições, normais e coordenadas de textura
+        std::vector<Vertex> vertices = {
+            // Posição                // Normal(não usada ainda) // TexCoords
+            { {-0.5f, -0.5f, -0.5f}, { 0.0f,  0.0f, -1.0f}, {0.0f, 0.0f} },
+            { { 0.5f, -0.5f, -0.5f}, { 0.0f,  0.0f, -1.0f}, {1.0f, 0.0f} },
+            { { 0.5f,  0.5f, -0.5f}, { 0.0f,  0.0f, -1.0f}, {1.0f, 1.0f} },
+            { {-0.5f,  0.5f, -0.5f}, { 0.0f,  0.0f, -1.0f}, {0.0f, 1.0f} },
+
+            { {-0.5f, -0.5f,  0.5f}, { 0.0f,  0.0f,  1.0f}, {0.0f, 0.0f} },
+            { { 0.5f, -0.5f,  0.5f}, { 0.0f,  0.0f,  1.0f}, {1.0f, 0.0f} },
+            { { 0.5f,  0.5f,  0.5f}, { 0.0f,  0.0f,  1.0f}, {1.0f, 1.0f} },
+            { {-0.5f,  0.5f,  0.5f}, { 0.0f,  0.0f,  1.0f}, {0.0f, 1.0f} },
+
+            { {-0.5f,  0.5f,  0.5f}, {-1.0f,  0.0f,  0.0f}, {1.0f, 0.0f} },
+            { {-0.5f,  0.5f, -0.5f}, {-1.0f,  0.0f,  0.0f}, {1.0f, 1.0f} },
+            { {-0.5f, -0.5f, -0.5f}, {-1.0f,  0.0f,  0.0f}, {0.0f, 1.0f} },
+            { {-0.5f, -0.5f,  0.5f}, {-1.0f,  0.0f,  0.0f}, {0.0f, 0.0f} },
+
+            { { 0.5f,  0.5f,  0.5f}, { 1.0f,  0.0f,  0.0f}, {1.0f, 0.0f} },
+            { { 0.5f,  0.5f, -0.5f}, { 1.0f,  0.0f,  0.0f}, {1.0f, 1.0f} },
+            { { 0.5f, -0.5f, -0.5f}, { 1.0f,  0.0f,  0.0f}, {0.0f, 1.0f} },
+            { { 0.5f, -0.5f,  0.5f}, { 1.0f,  0.0f,  0.0f}, {0.0f, 0.0f} },
+
+            { {-0.5f, -0.5f, -0.5f}, { 0.0f, -1.0f,  0.0f}, {0.0f, 1.0f} },
+            { { 0.5f, -0.5f, -0.5f}, { 0.0f, -1.0f,  0.0f}, {1.0f, 1.0f} },
+            { { 0.5f, -0.5f,  0.5f}, { 0.0f, -1.0f,  0.0f}, {1.0f, 0.0f} },
+            { {-0.5f, -0.5f,  0.5f}, { 0.0f, -1.0f,  0.0f}, {0.0f, 0.0f} },
+
+            { {-0.5f,  0.5f, -0.5f}, { 0.0f,  1.0f,  0.0f}, {0.0f, 1.0f} },
+            { { 0.5f,  0.5f, -0.5f}, { 0.0f,  1.0f,  0.0f}, {1.0f, 1.0f} },
+            { { 0.5f,  0.5f,  0.5f}, { 0.0f,  1.0f,  0.0f}, {1.0f, 0.0f} },
+            { {-0.5f,  0.5f,  0.5f}, { 0.0f,  1.0f,  0.0f}, {0.0f, 0.0f} }
+        };
+        std::vector<unsigned int> indices = {
+            0, 1, 2,   2, 3, 0,    4, 5, 6,   6, 7, 4,
+            8, 9, 10,  10, 11, 8,  12, 13, 14, 14, 15, 12,
+            16, 17, 18, 18, 19, 16, 20, 21, 22, 22, 23, 20
+        };
+
+        // Create shared_ptr for Shader first (don't create stack-allocated ourShader)
+        auto shaderPtr = std::make_shared<Shader>("shaders/basic.vert", "shaders/basic.frag");
+        std::cout << "Shader criado com ID: " << shaderPtr->ID << std::endl;
+
+
+        auto texturePtr = createWhiteTexture();  // We'll make this a function
+
+        // Create mesh
+        auto meshPtr = std::make_shared<Mesh>(vertices, indices);
+
+        // Create entity
+        auto cubeEntity = scene.create<ModelEntity>(
+        meshPtr,
+        texturePtr,  // Texture comes before Shader
+        shaderPtr
+    );
+
+        auto sunLight = scene.create<Light>("Sun");
+        sunLight->light().type = Light::Type::DIRECTIONAL;
+        sunLight->setRotation(alg::Vec3(45.0f, -30.0f, 0.0f)); // Ângulos em graus
+        sunLight->light().color = alg::Vec3(1.0f, 0.95f, 0.9f);
+        sunLight->light().intensity = 0.8f;
+
+        // --- 2. Criação dos Objetos da Engine ---
+        std::cout << "\n=== INICIALIZANDO OBJETOS DA ENGINE ===" << std::endl;
+        //Shader ourShader("shaders/basic.vert", "shaders/basic.frag");
+        std::cout << "Shader criado \n";
+
+        std::cout << "Mesh criado com " << vertices.size() << " vertices e " << indices.size() << " indices" << std::endl;
     
-    Texture cubeTexture("textures/container.jpg");
-    std::cout << "=== INICIALIZAÇÃO COMPLETA ===\n" << std::endl;
-
-    // --- 3. Loop de Renderização ---
-    std::cout << "Iniciando loop de renderização..." << std::endl;
-    std::cout << "Posição inicial da câmera: (" << camera.Position.x << ", " << camera.Position.y << ", " << camera.Position.z << ")" << std::endl;
-    std::cout << "Yaw: " << camera.Yaw << ", Pitch: " << camera.Pitch << std::endl;
-    int frameCount = 0;
-while (!glfwWindowShouldClose(window)) {
-
-
-    // --- Timing ---
-    float currentFrame = static_cast<float>(glfwGetTime());
-    deltaTime = currentFrame - lastFrame;
-    lastFrame = currentFrame;
-
-    // --- Input Processing ---
-    processInput(window);
-
-    if (scene.activeCamera) {
-        scene.activeCamera->updateCamera();
-        camera = scene.activeCamera->camera;
-    }
-
-    uiManager.beginFrame();
-
-    // --- Clear Screen ---
-    glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-    // --- ImGui Rendering ---
-    uiManager.renderUI(scene);
-
-    // --- 3D Rendering ---
-    for (auto& entity : scene.entities) {
-        if (auto modelEntity = std::dynamic_pointer_cast<ModelEntity>(entity)) {
-            // Use o shader do modelEntity
-            Shader& currentShader = *modelEntity->shader;
-            currentShader.use();
-
-
-
-            // Matrizes de transformação
-            alg::Mat4 projection = alg::Mat4::create_perspective(
+        // Decodificadas em paralelo; o upload fica nesta thread (contexto GL)
+        const std::vector<std::shared_ptr<Texture>> loadedTextures =
+            ResourceManager::loadTextures({"textures/container.jpg"}, jobs);
+        std::cout << "=== INICIALIZAÇÃO COMPLETA ===\n" << std::endl;
+
+        // --- 3. Loop de Renderização ---
+        std::cout << "Iniciando loop de renderização..." << std::endl;
+        std::cout << "Posição inicial da câmera: (" << camera.Position.x << ", " << camera.Position.y << ", " << camera.Position.z << ")" << std::endl;
+        std::cout << "Yaw: " << camera.Yaw << ", Pitch: " << camera.Pitch << std::endl;
+        // --- Grafo do frame ---
+        // Input, UI e picking rodam na thread principal (GLFW/ImGui); a partir
+        // daí a preparação do frame vai para os workers, escrevendo no
+        // FrameData "preparing", enquanto a thread principal submete o
+        // FrameData do frame anterior. Custo: o 3D mostra a cena com um frame
+        // de atraso em relação à UI.
+        FrameData frames[2];
+        FrameData* preparing = &frames[0];
+
+        FrameGraph frameGraph;
+        const FrameGraph::TaskId transformsTask = frameGraph.addTask("Transforms", [&] {
+            scene.updateTransforms(&jobs);
+        });
+        // Depois de Transforms: o arrangeLike de lá move os materiais no pool
+        frameGraph.addTask("Materials", [&] {
+            scene.collectMaterialUpdates(preparing->materialUpdates, preparing->materialCount);
+        }, {transformsTask});
+        const FrameGraph::TaskId lightsTask = frameGraph.addTask("Lights", [&] {
+            scene.collectLights(preparing->lights);
+        }, {transformsTask});
+        frameGraph.addTask("Light clusters", [&] {
+            LightClusters::Params params;
+            params.view = preparing->view;
+            params.projection = preparing->projection;
+            params.nearPlane = preparing->nearPlane;
+            params.farPlane = preparing->farPlane;
+            params.viewportWidth = preparing->viewportWidth;
+            params.viewportHeight = preparing->viewportHeight;
+            params.assignClusters = preparing->clusteredLighting;
+            preparing->clusters.build(preparing->lights, params, &jobs);
+        }, {lightsTask});
+        const FrameGraph::TaskId cullTask = frameGraph.addTask("Cull (main view)", [&] {
+            scene.cullRenderables(preparing->frustum);
+        }, {transformsTask});
+        const FrameGraph::TaskId renderListTask = frameGraph.addTask("Render list", [&] {
+            scene.buildRenderList(preparing->draws, &jobs);
+        }, {cullTask});
+        // Sem clusters, cada draw leva as suas luzes mais relevantes
+        LightSelection lightSelection;
+        const FrameGraph::TaskId lightSelectionTask = frameGraph.addTask("Light selection", [&] {
+            if (!preparing->clusteredLighting) {
+                lightSelection.select(preparing->lights, preparing->frustum, preparing->draws, &jobs);
+            }
+        }, {lightsTask, renderListTask});
+        frameGraph.addTask("Sort + batches", [&] {
+            Renderer::prepareQueue(*preparing, &jobs);
+        }, {lightSelectionTask});
+
+        Renderer renderer;
+        renderer.loadExtensions((Renderer::ProcLoader)glfwGetProcAddress);
+        std::cout << "Multi-draw indirect: " << (renderer.supportsMultiDrawIndirect() ? "sim" : "não (GL 3.3, draws instanciados)") << std::endl;
+
+        std::uint64_t frameIndex = 0;
+        while (!glfwWindowShouldClose(window)) {
+
+            // --- Timing ---
+            float currentFrame = static_cast<float>(glfwGetTime());
+            deltaTime = currentFrame - lastFrame;
+            lastFrame = currentFrame;
+
+            // --- Input Processing ---
+            processInput(window);
+
+            if (scene.activeCamera) {
+                scene.activeCamera->updateCamera();
+                camera = scene.activeCamera->camera();
+            }
+
+            uiManager.beginFrame();
+
+            // --- ImGui Rendering (pode mexer na cena: nada está rodando nos workers) ---
+            jobs.sampleUtilization();
+            uiManager.renderUI(scene);
+            uiManager.renderJobStats(jobs);
+            uiManager.renderFrameStats(frameGraph, renderer);
+
+            // Matrizes de câmera (iguais para todos os objetos)
+            const alg::Mat4 projection = alg::Mat4::create_perspective(
                 alg::degrees_to_radians(camera.Zoom),
                 (float)SCR_WIDTH / (float)SCR_HEIGHT,
-                0.1f,
-                100.0f
+                NEAR_PLANE,
+                FAR_PLANE
             );
-            alg::Mat4 view = camera.getViewMatrix();
-
-            modelEntity->shader->use();
-
-            // Configura as matrizes essenciais
-            modelEntity->shader->setMat4("projection", projection);
-            modelEntity->shader->setMat4("view", view);
-            modelEntity->shader->setMat4("model", modelEntity->getTransformMatrix());
-
-            // Configura o material
-            modelEntity->shader->setVec3("material.ambient", modelEntity->material.ambient);
-            modelEntity->shader->setVec3("material.diffuseColor", modelEntity->material.diffuse);
-            modelEntity->shader->setVec3("material.specular", modelEntity->material.specular);
-            modelEntity->shader->setFloat("material.shininess", modelEntity->material.shininess);
-
-            // Configura a view position
-            modelEntity->shader->setVec3("viewPos", camera.Position);
-
-            // Configura a textura
-            modelEntity->shader->setInt("material.diffuse", 0);
-
-            // Configura as luzes
-            scene.setupLightsInShader(*modelEntity->shader);
-
-            // Configura a textura
-            currentShader.setInt("ourTexture", 0);
-
-            // Renderiza
-            modelEntity->mesh->draw(currentShader);
+            const alg::Mat4 view = camera.getViewMatrix();
+
+            // --- Picking (clique esquerdo no viewport) ---
+            if (pickRequested) {
+                pickRequested = false;
+                int width, height;
+                glfwGetWindowSize(window, &width, &height);
+                if (width > 0 && height > 0) {
+                    const float ndcX = 2.0f * static_cast<float>(pickX) / width - 1.0f;
+                    const float ndcY = 1.0f - 2.0f * static_cast<float>(pickY) / height;
+                    scene.selectEntity(scene.pick(camera.screenRay(ndcX, ndcY, projection)).get());
+                }
+            }
+
+            // Remoções pedidas durante a UI (ex.: botão Delete) antes de preparar
+            scene.flushDestroyed();
+
+            // --- Preparação do frame N nos workers ---
+            FrameData& submitting = frames[(frameIndex + 1) & 1];
+            preparing = &frames[frameIndex & 1];
+            preparing->frameIndex = frameIndex;
+            preparing->projection = projection;
+            preparing->view = view;
+            preparing->viewPos = camera.Position;
+            preparing->frustum = alg::Frustum::from_matrix(projection * view);
+            preparing->nearPlane = NEAR_PLANE;
+            preparing->farPlane = FAR_PLANE;
+            preparing->clusteredLighting = renderer.isClusteredLightingEnabled();
+            glfwGetFramebufferSize(window, &preparing->viewportWidth, &preparing->viewportHeight);
+            frameGraph.launch(jobs);
+
+            // --- Submissão GL do frame N-1, ao mesmo tempo ---
+            glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            if (submitting.ready) {
+                renderer.submit(submitting);
+            }
+
+            uiManager.endFrame();
+
+            // --- Buffer Swap and Events ---
+            glfwSwapBuffers(window);
+            glfwPollEvents();
+
+            // A thread principal ajuda a terminar a preparação
+            frameGraph.wait(jobs);
+            preparing->ready = true;
+            ++frameIndex;
         }
     }
 
-    uiManager.endFrame();
-
-
-
-
-    // --- Buffer Swap and Events ---
-    glfwSwapBuffers(window);
-    glfwPollEvents();
-}
-
     // --- 4. Limpeza ---
     glfwTerminate();
     return 0;
@@ -306,6 +377,14 @@ void mouse_callback(GLFWwindow* window, double xposIn, double yposIn) {
 }
 
 void mouse_button_callback(GLFWwindow *window, int button, int action, int mods) {
+    if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_PRESS) {
+        ImGuiIO& io = ImGui::GetIO();
+        if (!io.WantCaptureMouse && !cameraActive) {
+            glfwGetCursorPos(window, &pickX, &pickY);
+            pickRequested = true;
+        }
+    }
+
     if (button == GLFW_MOUSE_BUTTON_RIGHT) {
         ImGuiIO& io = ImGui::GetIO();
         if (io.WantCaptureMouse) {
@@ -0,0 +1,103 @@
+#ifndef SIMD_HPP
+#define SIMD_HPP
+
+/**
+ * @file simd.hpp
+ * @brief Compile-time SIMD backend selection for the alg library
+ *
+ * The backend is picked from the target flags the compiler was invoked with,
+ * so there is no runtime dispatch on the hot paths:
+ * - ALG_SIMD_AVX2: 256-bit kernels (-mavx2 / /arch:AVX2)
+ * - ALG_SIMD_SSE2: 128-bit kernels (baseline on every x86-64 compiler)
+ * - neither: scalar reference implementation
+ *
+ * Define ALG_NO_SIMD before including any algebra header (or configure with
+ * -DALG_FORCE_SCALAR=ON) to force the scalar reference path, e.g. to compare
+ * results or to build for a target without SSE.
+ *
+ * AVX2 implies SSE2, so code guarded by ALG_SIMD_SSE2 is always available
+ * when ALG_SIMD_AVX2 is defined.
+ */
+
+#if !defined(ALG_NO_SIMD)
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define ALG_SIMD_SSE2 1
+    #endif
+    #if defined(ALG_SIMD_SSE2) && defined(__AVX2__)
+        #define ALG_SIMD_AVX2 1
+    #endif
+#endif
+
+#if defined(ALG_SIMD_AVX2)
+    #include <immintrin.h>
+#elif defined(ALG_SIMD_SSE2)
+    #include <emmintrin.h>
+#endif
+
+namespace alg::simd {
+
+/**
+ * @brief Name of the backend selected at compile time
+ * @return "avx2", "sse2" or "scalar"
+ *
+ * Handy for logs and benchmark reports so results can be attributed
+ * to the code path that produced them.
+ */
+constexpr const char* backend_name() noexcept {
+#if defined(ALG_SIMD_AVX2)
+    return "avx2";
+#elif defined(ALG_SIMD_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+#if defined(ALG_SIMD_SSE2)
+
+/**
+ * @brief Broadcast one lane of a register to all four lanes
+ * @tparam Lane Source lane index [0,3]
+ */
+template <int Lane>
+inline __m128 splat(__m128 v) noexcept {
+    return _mm_shuffle_ps(v, v, _MM_SHUFFLE(Lane, Lane, Lane, Lane));
+}
+
+/**
+ * @brief Reorder lanes of a single register
+ * @tparam X,Y,Z,W Source lane for each destination lane (GLSL-style .xyzw order)
+ */
+template <int X, int Y, int Z, int W>
+inline __m128 swizzle(__m128 v) noexcept {
+    return _mm_shuffle_ps(v, v, _MM_SHUFFLE(W, Z, Y, X));
+}
+
+/**
+ * @brief 3D cross product of the xyz lanes
+ * @return a × b in xyz, 0 in w when both inputs have w = 0
+ *
+ * Uses the two-shuffle form: (a * b.yzx - a.yzx * b).yzx
+ */
+inline __m128 cross3(__m128 a, __m128 b) noexcept {
+    const __m128 r = _mm_sub_ps(_mm_mul_ps(a, swizzle<1, 2, 0, 3>(b)),
+                                _mm_mul_ps(swizzle<1, 2, 0, 3>(a), b));
+    return swizzle<1, 2, 0, 3>(r);
+}
+
+/**
+ * @brief Horizontal sum of the four lanes
+ * @return x + y + z + w broadcast to every lane
+ *
+ * SSE2-only formulation (no _mm_hadd_ps, which needs SSE3).
+ */
+inline __m128 hsum(__m128 v) noexcept {
+    __m128 t = _mm_add_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_add_ps(t, _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 0, 3, 2)));
+}
+
+#endif // ALG_SIMD_SSE2
+
+} // namespace alg::simd
+
+#endif // SIMD_HPP
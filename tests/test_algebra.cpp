@@ -0,0 +1,567 @@
+// Checks for src/algebra.hpp, src/algebra_batch.hpp, src/geometry.hpp and
+// src/bvh.hpp that need a running program. The constexpr ones are static
+// asserts in src/algebra_static_tests.hpp, compiled here only. Meant to
+// pass in every alg backend configuration: default, ALG_ENABLE_AVX2 and
+// ALG_FORCE_SCALAR, each with and without ALG_ENABLE_FAST_MATH.
+//
+// Usage: test_algebra (exit code 0 on success, failures on stderr)
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "algebra.hpp"
+#include "algebra_batch.hpp"
+#include "algebra_static_tests.hpp"
+#include "geometry.hpp"
+#include "bvh.hpp"
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(cond)                                                              \
+    do {                                                                         \
+        if (!(cond)) {                                                           \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            ++failures;                                                          \
+        }                                                                        \
+    } while (0)
+
+// --- SIMD products vs the alg::scalar reference ---
+//
+// The documented bound on operator*(Mat4, ...): each element differs from
+// the scalar kernel by at most SIMD_PRODUCT_BOUND * Σ|terms|.
+constexpr float SIMD_PRODUCT_BOUND = 4.0f * FLT_EPSILON;
+
+struct ProductError {
+    float worst = 0.0f; // Largest |simd - scalar| / (ε * Σ|terms|)
+    int violations = 0;
+
+    void add(float simd, float reference, float magnitude) {
+        const float diff = std::fabs(simd - reference);
+        if (diff > SIMD_PRODUCT_BOUND * magnitude) {
+            ++violations;
+        }
+        if (magnitude > 0.0f) {
+            worst = std::max(worst, diff / (FLT_EPSILON * magnitude));
+        }
+    }
+};
+
+void check_products(const alg::Mat4& a, const alg::Mat4& b, const alg::Vec4& v, ProductError& error) {
+    const alg::Mat4 simd = a * b;
+    const alg::Mat4 reference = alg::scalar::mul(a, b);
+    for (int col = 0; col < 4; ++col) {
+        for (int row = 0; row < 4; ++row) {
+            float magnitude = 0.0f;
+            for (int k = 0; k < 4; ++k) {
+                magnitude += std::fabs(a.m[k * 4 + row] * b.m[col * 4 + k]);
+            }
+            error.add(simd.m[col * 4 + row], reference.m[col * 4 + row], magnitude);
+        }
+    }
+
+    const alg::Vec4 simd4 = a * v;
+    const alg::Vec4 reference4 = alg::scalar::transform(a, v);
+    const alg::Vec3 simd3 = a * v.xyz();
+    const alg::Vec3 reference3 = alg::scalar::transform_point(a, v.xyz());
+    const float simd4s[4] = {simd4.x, simd4.y, simd4.z, simd4.w};
+    const float reference4s[4] = {reference4.x, reference4.y, reference4.z, reference4.w};
+    const float simd3s[3] = {simd3.x, simd3.y, simd3.z};
+    const float reference3s[3] = {reference3.x, reference3.y, reference3.z};
+    for (int row = 0; row < 4; ++row) {
+        const float terms3 = std::fabs(a.m[row] * v.x) + std::fabs(a.m[4 + row] * v.y) + std::fabs(a.m[8 + row] * v.z);
+        error.add(simd4s[row], reference4s[row], terms3 + std::fabs(a.m[12 + row] * v.w));
+        if (row < 3) {
+            error.add(simd3s[row], reference3s[row], terms3 + std::fabs(a.m[12 + row]));
+        }
+    }
+}
+
+void test_simd_products() {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> exponent(-3.0f, 3.0f);
+    const auto wide = [&] { return unit(rng) * std::pow(10.0f, exponent(rng)); };
+
+    ProductError random;
+    ProductError cancelling;
+    for (int n = 0; n < 20000; ++n) {
+        alg::Mat4 a, b;
+        alg::Vec4 v(wide(), wide(), wide(), wide());
+        for (int i = 0; i < 16; ++i) {
+            a.m[i] = wide();
+            b.m[i] = wide();
+        }
+        check_products(a, b, v, random);
+
+        // Columns of a that cancel in pairs against a b close to all ones:
+        // the exact result is tiny next to the terms that produce it
+        for (int row = 0; row < 4; ++row) {
+            const float p = wide();
+            const float q = wide();
+            a.m[0 + row] = p;
+            a.m[4 + row] = -p * (1.0f + unit(rng) * 1e-4f);
+            a.m[8 + row] = q;
+            a.m[12 + row] = -q;
+        }
+        for (int i = 0; i < 16; ++i) {
+            b.m[i] = 1.0f + unit(rng) * 1e-3f;
+        }
+        const float w = 1.0f + unit(rng) * 1e-3f;
+        v = alg::Vec4(w, w * (1.0f + unit(rng) * 1e-3f), w, w);
+        check_products(a, b, v, cancelling);
+    }
+
+    std::printf("simd products (%s): worst %.2f ε·Σ|terms| random, %.2f cancelling\n",
+                alg::simd::backend_name(), random.worst, cancelling.worst);
+    CHECK(random.violations == 0);
+    CHECK(cancelling.violations == 0);
+}
+
+// --- Inverses vs the identity and the alg::scalar reference ---
+//
+// Errors are in units of κ·ε, with κ = ‖M‖∞·‖M⁻¹‖∞: a backward-stable
+// inverse keeps both |M·M⁻¹ − I| and |M⁻¹ − reference| / |reference|
+// within a small multiple of that, however badly conditioned M is.
+constexpr float INVERSE_BOUND = 16.0f;
+
+float norm_inf(const alg::Mat4& m) {
+    float worst = 0.0f;
+    for (int row = 0; row < 4; ++row) {
+        worst = std::max(worst, std::fabs(m.m[row]) + std::fabs(m.m[4 + row]) + std::fabs(m.m[8 + row]) +
+                                std::fabs(m.m[12 + row]));
+    }
+    return worst;
+}
+
+float max_abs_diff(const alg::Mat4& a, const alg::Mat4& b) {
+    float worst = 0.0f;
+    for (int i = 0; i < 16; ++i) {
+        worst = std::max(worst, std::fabs(a.m[i] - b.m[i]));
+    }
+    return worst;
+}
+
+struct InverseError {
+    float worst = 0.0f; // Largest error / (κ·ε)
+    int violations = 0;
+
+    // inv against the identity (through m) and against reference
+    void add(const alg::Mat4& m, const alg::Mat4& inv, const alg::Mat4& reference) {
+        const float kappa_eps = norm_inf(m) * norm_inf(reference) * FLT_EPSILON;
+        float scale = 0.0f;
+        for (float x : reference.m) scale = std::max(scale, std::fabs(x));
+        const float error = std::max(max_abs_diff(m * inv, alg::Mat4()), max_abs_diff(inv, reference) / scale) / kappa_eps;
+        worst = std::max(worst, error);
+        violations += !(error <= INVERSE_BOUND);
+    }
+};
+
+// Upper 3x3 of m as a Mat4 (no translation, w = 1)
+alg::Mat4 linear_part(const alg::Mat4& m) {
+    alg::Mat4 result;
+    for (int col = 0; col < 3; ++col) {
+        for (int row = 0; row < 3; ++row) {
+            result.m[col * 4 + row] = m.m[col * 4 + row];
+        }
+    }
+    return result;
+}
+
+// Every general inverse on m: Mat4::inverse, and alg::simd when built
+void check_general(const alg::Mat4& m, InverseError& error) {
+    const alg::Mat4 reference = alg::scalar::inverse(m);
+    error.add(m, reference, reference);
+    error.add(m, m.inverse(), reference);
+#if defined(ALG_SIMD_SSE2)
+    error.add(m, alg::simd::inverse(m), reference);
+#endif
+}
+
+// Affine m: the general inverse plus affine_inverse and normal_matrix
+void check_affine(const alg::Mat4& m, InverseError& error) {
+    check_general(m, error);
+    const alg::Mat4 reference = alg::scalar::inverse(m);
+    error.add(m, alg::scalar::affine_inverse(m), reference);
+    error.add(m, m.affine_inverse(), reference);
+#if defined(ALG_SIMD_SSE2)
+    error.add(m, alg::simd::affine_inverse(m), reference);
+#endif
+
+    // Normal matrix N = (M₃ₓ₃⁻¹)ᵀ, so M₃ₓ₃ᵀ · N = I
+    const alg::Mat4 linear_t = linear_part(m).transposed();
+    const alg::Mat4 normal_reference = alg::scalar::inverse(linear_t);
+    error.add(linear_t, alg::scalar::normal_matrix(m), normal_reference);
+    error.add(linear_t, m.normal_matrix(), normal_reference);
+#if defined(ALG_SIMD_SSE2)
+    error.add(linear_t, alg::simd::normal_matrix(m), normal_reference);
+#endif
+}
+
+void test_inverses() {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> scale(0.25f, 4.0f);
+    const auto random_quat = [&] {
+        return alg::Quat::from_euler(alg::Vec3(unit(rng) * 3.0f, unit(rng) * 3.0f, unit(rng) * 3.0f));
+    };
+    const auto random_translation = [&] { return alg::Vec3(unit(rng), unit(rng), unit(rng)) * 20.0f; };
+
+    InverseError general, affine, rigid, near_singular;
+    for (int n = 0; n < 2000; ++n) {
+        // General: random entries, projections
+        alg::Mat4 m;
+        for (float& x : m.m) x = unit(rng);
+        check_general(m, general);
+        const alg::Mat4 view = alg::Mat4::lookAt(random_translation(), alg::Vec3(0.0f, 0.0f, 0.0f), alg::Vec3(0.0f, 1.0f, 0.0f));
+        check_general(alg::Mat4::create_perspective(0.5f + std::fabs(unit(rng)), scale(rng), 0.1f, 100.0f) * view, general);
+
+        // Affine: non-uniform scale and shear
+        alg::Mat4 shear;
+        shear.m[4] = unit(rng);
+        shear.m[9] = unit(rng);
+        const alg::Mat4 trs = alg::Mat4::from_trs(random_translation(), random_quat(),
+                                                  alg::Vec3(scale(rng), scale(rng), scale(rng)));
+        check_affine(trs * shear, affine);
+
+        // Rigid: all three inverses must agree
+        const alg::Mat4 r = alg::Mat4::from_trs(random_translation(), random_quat(), alg::Vec3(1.0f, 1.0f, 1.0f));
+        check_affine(r, rigid);
+        const alg::Mat4 reference = alg::scalar::inverse(r);
+        rigid.add(r, r.rigid_inverse(), reference);
+
+        // Near-singular: one axis squashed to 1e-2 .. 1e-5, and two rows
+        // of a general matrix almost equal
+        const float squash = std::pow(10.0f, -2.0f - 3.0f * std::fabs(unit(rng)));
+        check_affine(alg::Mat4::from_trs(random_translation(), random_quat(), alg::Vec3(1.0f, squash, 1.0f)), near_singular);
+        for (int col = 0; col < 4; ++col) {
+            m.m[col * 4 + 3] = m.m[col * 4 + 2] * (1.0f + squash * unit(rng));
+        }
+        check_general(m, near_singular);
+    }
+
+    std::printf("inverses (%s): worst %.2f κ·ε general, %.2f affine, %.2f rigid, %.2f near-singular\n",
+                alg::simd::backend_name(), general.worst, affine.worst, rigid.worst, near_singular.worst);
+    CHECK(general.violations == 0);
+    CHECK(affine.violations == 0);
+    CHECK(rigid.violations == 0);
+    CHECK(near_singular.violations == 0);
+
+    // Singular: every variant falls back to the identity
+    alg::Mat4 singular;
+    singular.m[5] = 0.0f;
+    const alg::Mat4 identity;
+    CHECK(alg::scalar::inverse(singular) == identity);
+    CHECK(singular.inverse() == identity);
+    CHECK(alg::scalar::affine_inverse(singular) == identity);
+    CHECK(singular.affine_inverse() == identity);
+    CHECK(alg::scalar::normal_matrix(singular) == identity);
+    CHECK(singular.normal_matrix() == identity);
+#if defined(ALG_SIMD_SSE2)
+    CHECK(alg::simd::inverse(singular) == identity);
+    CHECK(alg::simd::affine_inverse(singular) == identity);
+    CHECK(alg::simd::normal_matrix(singular) == identity);
+#endif
+}
+
+// --- alg::batch kernels ---
+
+bool near(const alg::Vec3& a, const alg::Vec3& b, float tolerance) {
+    return std::fabs(a.x - b.x) <= tolerance && std::fabs(a.y - b.y) <= tolerance && std::fabs(a.z - b.z) <= tolerance;
+}
+
+void test_batch_kernels() {
+    const alg::Mat4 m = alg::Mat4::from_trs(alg::Vec3(1.0f, -2.0f, 3.0f), alg::Quat::from_euler(alg::Vec3(0.3f, 0.2f, 0.1f)),
+                                            alg::Vec3(1.0f, 2.0f, 0.5f));
+
+    // Empty spans (data() may be null) are a no-op
+    std::vector<alg::Vec3> none;
+    alg::batch::transform_points(m, none, none);
+    alg::batch::transform_vectors(m, none, none);
+    alg::batch::transform_normals(m.normal_matrix(), none, none);
+    alg::batch::normalize(none);
+
+    // Sizes that leave a scalar tail after the 4-wide loop
+    for (std::size_t n : {1u, 3u, 4u, 7u, 13u}) {
+        std::vector<alg::Vec3> in(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            in[i] = alg::Vec3(float(i) + 0.5f, 1.0f - float(i), 0.25f * float(i * i) + 1.0f);
+        }
+        std::vector<alg::Vec3> points(n), vectors(n), normals(n), unit = in;
+        alg::batch::transform_points(m, in, points);
+        alg::batch::transform_vectors(m, in, vectors);
+        alg::batch::transform_normals(m.normal_matrix(), in, normals);
+        alg::batch::normalize(unit);
+        const alg::Mat4 nm = m.normal_matrix();
+        for (std::size_t i = 0; i < n; ++i) {
+            const alg::Vec3 translation(m.m[12], m.m[13], m.m[14]);
+            CHECK(near(points[i], alg::scalar::transform_point(m, in[i]), 1e-4f * (1.0f + in[i].magnitude())));
+            CHECK(near(vectors[i], alg::scalar::transform_point(m, in[i]) - translation, 1e-4f * (1.0f + in[i].magnitude())));
+            CHECK(near(normals[i], (alg::scalar::transform_point(nm, in[i]) - alg::Vec3(nm.m[12], nm.m[13], nm.m[14])).normalized(), 1e-5f));
+            // Same arithmetic as Vec3::normalized in the SIMD body and the tail;
+            // with FMA the compiler may fuse the two differently (a few ulp)
+#if defined(__FMA__)
+            CHECK(near(unit[i], in[i].normalized(), 8 * FLT_EPSILON));
+#else
+            CHECK(unit[i] == in[i].normalized());
+#endif
+        }
+    }
+}
+
+// --- Batched ray/box test vs the scalar intersect() ---
+
+bool same_bits(float a, float b) {
+    return std::memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+// Axis-parallel rays whose origin lies on a slab plane give 0 * inf = NaN
+// in the slab test; batch::raycast_aabbs must resolve them exactly like
+// intersect() (hit or miss, and the same t)
+void test_raycast_boundaries() {
+    const std::vector<alg::AABB> boxes = {
+        alg::AABB(alg::Vec3(-1.0f, -1.0f, -1.0f), alg::Vec3(1.0f, 1.0f, 1.0f)),
+        alg::AABB(alg::Vec3(-1.0f, 1.0f, -1.0f), alg::Vec3(1.0f, 1.0f, 1.0f)), // Flat in y
+        alg::AABB(alg::Vec3(1.0f, -1.0f, 2.0f), alg::Vec3(3.0f, 1.0f, 4.0f)),
+        alg::AABB(alg::Vec3(-3.0f, 1.0f, -1.0f), alg::Vec3(-1.0f, 3.0f, 1.0f)),
+        alg::AABB(alg::Vec3(-1.0f, -1.0f, -1.0f), alg::Vec3(1.0f, 1.0f, 1.0f)),
+        alg::AABB(alg::Vec3(0.0f, 0.0f, 0.0f), alg::Vec3(0.0f, 0.0f, 0.0f)),     // Point
+        alg::AABB(alg::Vec3(-1.0f, -1.0f, 5.0f), alg::Vec3(1.0f, 1.0f, 6.0f)),
+        alg::AABB(alg::Vec3(-1.0f, -1.0f, -6.0f), alg::Vec3(1.0f, 1.0f, -5.0f)),
+        alg::AABB(alg::Vec3(-1.0f, -1.0f, -1.0f), alg::Vec3(1.0f, 1.0f, 1.0f)),  // Scalar tail
+    };
+    const float coords[] = {-3.0f, -1.0f, 0.0f, 1.0f, 3.0f};
+    const alg::Vec3 directions[] = {
+        alg::Vec3(1.0f, 0.0f, 0.0f), alg::Vec3(-1.0f, 0.0f, 0.0f), alg::Vec3(0.0f, 1.0f, 0.0f),
+        alg::Vec3(0.0f, -1.0f, 0.0f), alg::Vec3(0.0f, 0.0f, 1.0f), alg::Vec3(0.0f, 0.0f, -1.0f),
+        alg::Vec3(1.0f, 1.0f, 0.0f), alg::Vec3(0.0f, -1.0f, 1.0f),
+    };
+
+    std::vector<float> t_hit(boxes.size());
+    int mismatches = 0;
+    const auto check_ray = [&](const alg::Ray& ray) {
+        const std::size_t count = alg::batch::raycast_aabbs(ray, boxes, t_hit);
+        std::size_t expected_count = 0;
+        for (std::size_t i = 0; i < boxes.size(); ++i) {
+            float t = std::numeric_limits<float>::infinity();
+            const bool hit = alg::intersect(ray, boxes[i], t);
+            expected_count += hit;
+            if (!same_bits(t_hit[i], hit ? t : std::numeric_limits<float>::infinity())) {
+                ++mismatches;
+            }
+        }
+        if (count != expected_count) {
+            ++mismatches;
+        }
+    };
+
+    // The reported case: origin on the y max plane of the unit box, along +z
+    check_ray(alg::Ray(alg::Vec3(-1.0f, 1.0f, -5.0f), alg::Vec3(0.0f, 0.0f, 1.0f)));
+    check_ray(alg::Ray(alg::Vec3(1.0f, 1.0f, -5.0f), alg::Vec3(0.0f, 0.0f, 1.0f)));
+    CHECK(mismatches == 0);
+
+    for (float x : coords) {
+        for (float y : coords) {
+            for (float z : coords) {
+                for (const alg::Vec3& direction : directions) {
+                    check_ray(alg::Ray(alg::Vec3(x, y, z), direction));
+                }
+            }
+        }
+    }
+    CHECK(mismatches == 0);
+}
+
+// --- Frustum culling of empty boxes ---
+
+// A default AABB has a NaN center, which passes every plane test unless
+// handled; cull_aabbs (SIMD lanes and scalar tail), intersects() and
+// Bvh::query_frustum must all cull it, and any other inverted box
+void test_cull_empty_boxes() {
+    const alg::Mat4 view = alg::Mat4::lookAt(alg::Vec3(0.0f, 0.0f, 10.0f), alg::Vec3(0.0f, 0.0f, 0.0f),
+                                             alg::Vec3(0.0f, 1.0f, 0.0f));
+    const alg::Frustum frustum = alg::Frustum::from_matrix(
+        alg::Mat4::create_perspective(alg::degrees_to_radians(60.0f), 1.0f, 0.1f, 100.0f) * view);
+
+    const alg::AABB inside(alg::Vec3(-1.0f, -1.0f, -1.0f), alg::Vec3(1.0f, 1.0f, 1.0f));
+    const alg::AABB outside(alg::Vec3(50.0f, 50.0f, -1.0f), alg::Vec3(51.0f, 51.0f, 1.0f));
+    const alg::AABB inverted(alg::Vec3(1.0f, -1.0f, -1.0f), alg::Vec3(-1.0f, 1.0f, 1.0f));
+    CHECK(alg::intersects(frustum, inside));
+    CHECK(!alg::intersects(frustum, outside));
+    CHECK(!alg::intersects(frustum, alg::AABB()));
+    CHECK(!alg::intersects(frustum, inverted));
+
+    // 13 boxes: one 8-wide group, one 4-wide group and a scalar tail, with
+    // empty boxes in each
+    std::vector<alg::AABB> boxes;
+    for (std::size_t i = 0; i < 13; ++i) {
+        switch (i % 4) {
+            case 0: boxes.push_back(alg::AABB()); break;
+            case 1: boxes.push_back(inside); break;
+            case 2: boxes.push_back(i % 3 ? inverted : outside); break;
+            default: boxes.push_back(alg::AABB::from_center_extents(alg::Vec3(float(i) * 0.1f, 0.0f, 0.0f),
+                                                                   alg::Vec3(0.5f, 0.5f, 0.5f)));
+        }
+    }
+    std::vector<std::uint8_t> visible(boxes.size());
+    const std::size_t count = alg::batch::cull_aabbs(frustum, boxes, visible);
+    std::size_t expected_count = 0;
+    for (std::size_t i = 0; i < boxes.size(); ++i) {
+        const bool expected = alg::intersects(frustum, boxes[i]);
+        expected_count += expected;
+        CHECK(visible[i] == (expected ? 1 : 0));
+        if (boxes[i].is_empty()) {
+            CHECK(visible[i] == 0);
+        }
+    }
+    CHECK(count == expected_count);
+
+    // Every non-empty box is fully inside, so whole subtrees are emitted
+    // without per-item plane tests; the empty ones must still be skipped
+    std::vector<alg::AABB> mixed;
+    for (std::size_t i = 0; i < 64; ++i) {
+        mixed.push_back(i % 2 ? alg::AABB() : inside);
+    }
+    alg::Bvh bvh;
+    bvh.build(mixed);
+    std::size_t reported = 0;
+    bvh.query_frustum(frustum, [&](std::uint32_t item) {
+        CHECK(!mixed[item].is_empty());
+        ++reported;
+    });
+    CHECK(reported == 32);
+
+    std::vector<alg::AABB> all_empty(8);
+    bvh.build(all_empty);
+    reported = 0;
+    bvh.query_frustum(frustum, [&](std::uint32_t) { ++reported; });
+    CHECK(reported == 0);
+}
+
+// --- Bvh queries vs brute force ---
+
+std::size_t tree_depth(const alg::Bvh& bvh) {
+    const std::vector<alg::Bvh::Node>& nodes = bvh.nodes();
+    std::size_t deepest = 0;
+    std::vector<std::pair<std::uint32_t, std::size_t>> open;
+    if (!nodes.empty()) open.push_back({0, 1});
+    while (!open.empty()) {
+        const auto [index, depth] = open.back();
+        open.pop_back();
+        deepest = std::max(deepest, depth);
+        if (!nodes[index].is_leaf()) {
+            open.push_back({nodes[index].first, depth + 1});
+            open.push_back({nodes[index].first + 1, depth + 1});
+        }
+    }
+    return deepest;
+}
+
+void check_bvh_queries(const std::vector<alg::AABB>& boxes, std::mt19937& rng) {
+    alg::Bvh bvh;
+    bvh.build(boxes);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    alg::AABB bounds;
+    for (const alg::AABB& box : boxes) {
+        bounds.expand(box);
+    }
+    const alg::Vec3 center = bounds.center();
+    const float spread = bounds.extents().magnitude();
+
+    std::vector<std::uint32_t> found;
+    const auto sorted = [&] {
+        std::sort(found.begin(), found.end());
+        return found;
+    };
+    for (int n = 0; n < 64; ++n) {
+        const alg::Vec3 point = center + alg::Vec3(unit(rng), unit(rng), unit(rng)) * spread;
+        const alg::Sphere sphere(point, (unit(rng) + 1.0f) * 0.25f * spread);
+        found.clear();
+        bvh.query_sphere(sphere, [&](std::uint32_t item) { found.push_back(item); });
+        std::vector<std::uint32_t> expected;
+        for (std::uint32_t i = 0; i < boxes.size(); ++i) {
+            if (alg::intersects(sphere, boxes[i])) expected.push_back(i);
+        }
+        CHECK(sorted() == expected);
+
+        const alg::Ray ray(point, alg::Vec3(unit(rng), unit(rng), unit(rng)));
+        found.clear();
+        bvh.query_ray(ray, std::numeric_limits<float>::infinity(), [&](std::uint32_t item, float) { found.push_back(item); });
+        expected.clear();
+        float closest = std::numeric_limits<float>::infinity();
+        for (std::uint32_t i = 0; i < boxes.size(); ++i) {
+            float t;
+            if (alg::intersect(ray, boxes[i], t)) {
+                expected.push_back(i);
+                closest = std::min(closest, t);
+            }
+        }
+        CHECK(sorted() == expected);
+        CHECK(bvh.raycast(ray).t == closest);
+
+        const alg::Mat4 view = alg::Mat4::lookAt(point, center, alg::Vec3(0.0f, 1.0f, 0.0f));
+        const alg::Frustum frustum = alg::Frustum::from_matrix(
+            alg::Mat4::create_perspective(alg::degrees_to_radians(60.0f), 1.5f, 0.1f, spread) * view);
+        found.clear();
+        bvh.query_frustum(frustum, [&](std::uint32_t item) { found.push_back(item); });
+        expected.clear();
+        for (std::uint32_t i = 0; i < boxes.size(); ++i) {
+            if (alg::intersects(frustum, boxes[i])) expected.push_back(i);
+        }
+        CHECK(sorted() == expected);
+    }
+}
+
+void test_bvh_queries() {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+    std::vector<alg::AABB> scattered(5000);
+    for (alg::AABB& box : scattered) {
+        const alg::Vec3 c(unit(rng) * 100.0f, unit(rng) * 100.0f, unit(rng) * 100.0f);
+        box = alg::AABB::from_center_extents(c, alg::Vec3(1.0f, 1.0f, 1.0f) * (unit(rng) + 1.5f));
+    }
+    check_bvh_queries(scattered, rng);
+
+    // Boxes spaced geometrically along six half-axes: SAH can only split off
+    // a few per level, so the tree is far from balanced (about 35 levels)
+    std::vector<alg::AABB> chain;
+    for (int arm = 0; arm < 6; ++arm) {
+        for (int i = 0; i < 40; ++i) {
+            alg::Vec3 c(0.0f, 0.0f, 0.0f);
+            const float x = std::pow(4.0f, static_cast<float>(i % 20)) * (arm & 1 ? -1.0f : 1.0f) * (i < 20 ? 1.0f : 1.5f);
+            (arm / 2 == 0 ? c.x : arm / 2 == 1 ? c.y : c.z) = x;
+            chain.push_back(alg::AABB::from_center_extents(c, alg::Vec3(0.5f, 0.5f, 0.5f)));
+        }
+    }
+    alg::Bvh scattered_bvh, chain_bvh;
+    scattered_bvh.build(scattered);
+    chain_bvh.build(chain);
+    std::printf("bvh: depth %zu (scattered), %zu (unbalanced)\n", tree_depth(scattered_bvh), tree_depth(chain_bvh));
+    check_bvh_queries(chain, rng);
+}
+
+} // namespace
+
+int main() {
+    test_simd_products();
+    test_inverses();
+    test_batch_kernels();
+    test_raycast_boundaries();
+    test_cull_empty_boxes();
+    test_bvh_queries();
+
+    if (failures) {
+        std::fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,244 @@
+// Stress checks for src/JobSystem.hpp: the Chase-Lev deque on its own,
+// then the pool (nested parallelFor, runAfter continuations, counters
+// destroyed right after wait() and more jobs than a deque holds) with
+// several worker counts. Headless; best run under ThreadSanitizer or
+// AddressSanitizer as well.
+//
+// Usage: test_job_system (exit code 0 on success, failures on stderr)
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "JobSystem.hpp"
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(cond)                                                                   \
+    do {                                                                              \
+        if (!(cond)) {                                                                \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            ++failures;                                                               \
+        }                                                                             \
+    } while (0)
+
+constexpr std::size_t QUEUE_CAPACITY = static_cast<std::size_t>(WorkStealingQueue::CAPACITY);
+
+// --- WorkStealingQueue ---
+
+// Owner-only: fills up, refuses the next push, pops back in LIFO order
+void test_queue_owner() {
+    auto queue = std::make_unique<WorkStealingQueue>();
+    std::vector<Job> jobs(QUEUE_CAPACITY + 1);
+    CHECK(queue->pop() == nullptr);
+    CHECK(queue->steal() == nullptr);
+    for (std::size_t i = 0; i < QUEUE_CAPACITY; ++i) {
+        CHECK(queue->push(&jobs[i]));
+    }
+    CHECK(!queue->push(&jobs[QUEUE_CAPACITY]));
+    CHECK(queue->steal() == &jobs[0]);
+    for (std::size_t i = QUEUE_CAPACITY; i-- > 1;) {
+        CHECK(queue->pop() == &jobs[i]);
+    }
+    CHECK(queue->pop() == nullptr);
+}
+
+// The owner pushes and pops while thieves steal: every job must come out
+// exactly once, including the last-element races between pop and steal
+void test_queue_races() {
+    constexpr std::size_t JOBS = 200000;
+    constexpr int THIEVES = 3;
+
+    auto queue = std::make_unique<WorkStealingQueue>();
+    std::vector<Job> jobs(JOBS);
+    std::vector<std::atomic<int>> taken(JOBS);
+    std::atomic<bool> stop{false};
+
+    const auto take = [&](Job* job) {
+        taken[static_cast<std::size_t>(job - jobs.data())].fetch_add(1, std::memory_order_relaxed);
+    };
+
+    std::vector<std::thread> thieves;
+    for (int i = 0; i < THIEVES; ++i) {
+        thieves.emplace_back([&] {
+            while (!stop.load(std::memory_order_acquire)) {
+                if (Job* job = queue->steal()) take(job);
+            }
+        });
+    }
+
+    // Small batches keep the deque near empty, where pop and steal collide
+    std::size_t next = 0;
+    std::size_t round = 0;
+    while (next < JOBS) {
+        const std::size_t batch = 1 + round++ % 7;
+        for (std::size_t i = 0; i < batch && next < JOBS; ++i) {
+            if (!queue->push(&jobs[next])) break;
+            ++next;
+        }
+        for (std::size_t i = 0; i < batch / 2 + 1; ++i) {
+            if (Job* job = queue->pop()) take(job);
+        }
+    }
+    while (Job* job = queue->pop()) take(job);
+    stop.store(true, std::memory_order_release);
+    for (std::thread& thief : thieves) thief.join();
+
+    std::size_t wrong = 0;
+    for (const std::atomic<int>& count : taken) {
+        wrong += count.load() != 1;
+    }
+    CHECK(wrong == 0);
+}
+
+// --- JobSystem ---
+
+void test_parallel_for(JobSystem& jobs) {
+    // Every index visited once, for ranges around the grain
+    for (std::size_t count : {0u, 1u, 63u, 64u, 65u, 1000u, 100000u}) {
+        std::vector<int> visits(count, 0);
+        jobs.parallelFor(0, count, 64, [&](std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; ++i) ++visits[i];
+        });
+        CHECK(std::count(visits.begin(), visits.end(), 1) == static_cast<std::ptrdiff_t>(count));
+    }
+
+    // parallelFor inside parallelFor inside jobs
+    for (int rep = 0; rep < 20; ++rep) {
+        constexpr std::size_t OUTER = 64;
+        constexpr std::size_t INNER = 512;
+        std::vector<std::atomic<int>> cells(OUTER * INNER);
+        jobs.parallelFor(0, OUTER, 1, [&](std::size_t first, std::size_t last) {
+            for (std::size_t row = first; row < last; ++row) {
+                jobs.parallelFor(0, INNER, 16, [&](std::size_t a, std::size_t b) {
+                    for (std::size_t col = a; col < b; ++col) {
+                        cells[row * INNER + col].fetch_add(1, std::memory_order_relaxed);
+                    }
+                });
+            }
+        });
+        std::size_t wrong = 0;
+        for (const std::atomic<int>& cell : cells) wrong += cell.load() != 1;
+        CHECK(wrong == 0);
+    }
+}
+
+void test_continuations(JobSystem& jobs) {
+    for (int rep = 0; rep < 200; ++rep) {
+        std::atomic<int> produced{0};
+        std::atomic<int> seen{0};
+        std::atomic<int> early{0};
+        JobCounter first, second, third;
+
+        for (int i = 0; i < 16; ++i) {
+            jobs.run([&] {
+                jobs.parallelFor(0, 64, 4, [&](std::size_t a, std::size_t b) {
+                    produced.fetch_add(static_cast<int>(b - a));
+                });
+            }, &first);
+        }
+        // Each continuation must see all of first's work
+        for (int i = 0; i < 4; ++i) {
+            jobs.runAfter(first, [&] {
+                if (produced.load() != 16 * 64) early.fetch_add(1);
+                seen.fetch_add(1);
+            }, &second);
+        }
+        // Chained: third waits on second, registered while second may still run
+        jobs.runAfter(second, [&] {
+            if (seen.load() != 4) early.fetch_add(1);
+        }, &third);
+        jobs.wait(third);
+        CHECK(early.load() == 0);
+        CHECK(seen.load() == 4);
+
+        // Dependency already done: the continuation runs anyway
+        std::atomic<bool> ran{false};
+        JobCounter after;
+        jobs.runAfter(first, [&] { ran.store(true); }, &after);
+        jobs.wait(after);
+        CHECK(ran.load());
+    }
+}
+
+// Counters die as soon as wait() returns; threads still inside finish()
+// must be done with them by then. They are heap-allocated here so ASan
+// reports a late access as a use after free.
+void test_finishing_handshake(JobSystem& jobs) {
+    std::atomic<int> total{0};
+    for (int rep = 0; rep < 5000; ++rep) {
+        auto counter = std::make_unique<JobCounter>();
+        const int n = 1 + rep % 8;
+        for (int i = 0; i < n; ++i) {
+            jobs.run([&total] { total.fetch_add(1, std::memory_order_relaxed); }, counter.get());
+        }
+        jobs.wait(*counter);
+        CHECK(counter->done());
+        counter.reset();
+    }
+    CHECK(total.load() == 5000 / 8 * 36);
+}
+
+// More jobs than a deque holds: the overflow runs inline in the submitter
+void test_overflow(JobSystem& jobs) {
+    constexpr int JOBS = static_cast<int>(3 * QUEUE_CAPACITY + 17);
+
+    std::atomic<int> count{0};
+    JobCounter counter;
+    for (int i = 0; i < JOBS; ++i) {
+        jobs.run([&count] { count.fetch_add(1, std::memory_order_relaxed); }, &counter);
+    }
+    jobs.wait(counter);
+    CHECK(count.load() == JOBS);
+
+    // Same from inside a job, filling a worker's deque
+    count.store(0);
+    JobCounter outer, inner;
+    jobs.run([&] {
+        for (int i = 0; i < JOBS; ++i) {
+            jobs.run([&count] { count.fetch_add(1, std::memory_order_relaxed); }, &inner);
+        }
+    }, &outer);
+    jobs.wait(outer);
+    jobs.wait(inner);
+    CHECK(count.load() == JOBS);
+}
+
+} // namespace
+
+int main() {
+    test_queue_owner();
+    test_queue_races();
+
+    for (unsigned int workers : {1u, 3u, 7u}) {
+        JobSystem jobs(workers);
+        CHECK(jobs.threadCount() == workers + 1);
+        test_parallel_for(jobs);
+        test_continuations(jobs);
+        test_finishing_handshake(jobs);
+        test_overflow(jobs);
+    }
+
+    // Continuations still pending when the system is destroyed run in the destructor
+    std::atomic<bool> ran{false};
+    {
+        JobSystem jobs(2);
+        JobCounter dependency;
+        jobs.run([] {}, &dependency);
+        jobs.runAfter(dependency, [&ran] { ran.store(true); });
+        jobs.wait(dependency);
+    }
+    CHECK(ran.load());
+
+    if (failures) {
+        std::fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("all checks passed\n");
+    return 0;
+}
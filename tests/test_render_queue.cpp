@@ -0,0 +1,193 @@
+// Checks for src/RenderQueue.hpp: radixSortPackets against std::stable_sort
+// (with and without a JobSystem) and the draw order the opaque and
+// transparent keys produce. Headless.
+//
+// Usage: test_render_queue (exit code 0 on success, failures on stderr)
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "FrameData.hpp"
+#include "JobSystem.hpp"
+#include "RenderQueue.hpp"
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(cond)                                                                   \
+    do {                                                                              \
+        if (!(cond)) {                                                                \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            ++failures;                                                               \
+        }                                                                             \
+    } while (0)
+
+bool same_order(const std::vector<RenderPacket>& a, const std::vector<RenderPacket>& b) {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const RenderPacket& x, const RenderPacket& y) {
+        return x.key == y.key && x.draw == y.draw;
+    });
+}
+
+// --- radixSortPackets vs std::stable_sort ---
+
+// Random packets, draw = original position so stability shows up as order
+std::vector<RenderPacket> random_packets(std::size_t n, std::mt19937& rng, bool transparent_mix) {
+    std::uniform_int_distribution<std::uint32_t> state(0, 5);   // Few states: many equal keys
+    std::uniform_real_distribution<float> depth(-1.0f, 200.0f); // Negative depths clamp to 0
+    std::vector<RenderPacket> packets(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const bool transparent = transparent_mix && (rng() & 3) == 0;
+        // Quantized depths, so equal keys are common
+        const float d = float(int(depth(rng)));
+        packets[i].key = transparent ? RenderQueue::transparentKey(state(rng), state(rng), state(rng), d)
+                                     : RenderQueue::opaqueKey(state(rng), state(rng), state(rng), d);
+        packets[i].draw = static_cast<std::uint32_t>(i);
+        packets[i].padding = 0;
+    }
+    return packets;
+}
+
+void check_sort(std::vector<RenderPacket> packets, JobSystem* jobs) {
+    std::vector<RenderPacket> expected = packets;
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const RenderPacket& a, const RenderPacket& b) { return a.key < b.key; });
+    std::vector<RenderPacket> scratch;
+    std::vector<std::uint32_t> histograms;
+    radixSortPackets(packets, scratch, histograms, jobs);
+    CHECK(same_order(packets, expected));
+
+    // Scratch memory reused from the previous call
+    std::reverse(packets.begin(), packets.end());
+    expected = packets;
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const RenderPacket& a, const RenderPacket& b) { return a.key < b.key; });
+    radixSortPackets(packets, scratch, histograms, jobs);
+    CHECK(same_order(packets, expected));
+}
+
+void test_radix_sort(JobSystem* jobs) {
+    std::mt19937 rng(1234);
+    // Below and above the parallel grain (4096 per chunk)
+    for (std::size_t n : {0u, 1u, 2u, 3u, 100u, 4095u, 5000u, 20000u, 100000u}) {
+        check_sort(random_packets(n, rng, false), jobs);
+        check_sort(random_packets(n, rng, true), jobs);
+    }
+
+    // All keys equal: every pass is skipped and the order must not move
+    std::vector<RenderPacket> equal(10000);
+    for (std::size_t i = 0; i < equal.size(); ++i) {
+        equal[i] = {RenderQueue::opaqueKey(1, 2, 3, 4.0f), static_cast<std::uint32_t>(i), 0};
+    }
+    check_sort(equal, jobs);
+
+    // Keys differing in one byte only: an odd number of passes, so the
+    // result ends up in scratch and has to be swapped back
+    std::vector<RenderPacket> one_byte(10000);
+    for (std::size_t i = 0; i < one_byte.size(); ++i) {
+        one_byte[i] = {std::uint64_t(rng() & 0xFF) << 40, static_cast<std::uint32_t>(i), 0};
+    }
+    check_sort(one_byte, jobs);
+
+    // Full 64-bit keys: every pass runs
+    std::vector<RenderPacket> wide(30000);
+    for (std::size_t i = 0; i < wide.size(); ++i) {
+        wide[i] = {(std::uint64_t(rng()) << 32) | rng(), static_cast<std::uint32_t>(i), 0};
+    }
+    check_sort(wide, jobs);
+}
+
+// --- Key layout ---
+
+void test_keys() {
+    // Opaque: grouped by state first, then front to back
+    CHECK(RenderQueue::opaqueKey(1, 1, 1, 2.0f) < RenderQueue::opaqueKey(1, 1, 1, 3.0f));
+    CHECK(RenderQueue::opaqueKey(1, 1, 1, 100.0f) < RenderQueue::opaqueKey(1, 1, 2, 1.0f));
+    CHECK(RenderQueue::opaqueKey(1, 9, 9, 100.0f) < RenderQueue::opaqueKey(2, 0, 0, 1.0f));
+    CHECK(RenderQueue::opaqueKey(1, 1, 1, -5.0f) == RenderQueue::opaqueKey(1, 1, 1, 0.0f));
+
+    // Transparent: back to front regardless of state, after every opaque
+    CHECK(RenderQueue::transparentKey(9, 9, 9, 50.0f) < RenderQueue::transparentKey(0, 0, 0, 10.0f));
+    CHECK(RenderQueue::transparentKey(1, 1, 1, 10.0f) < RenderQueue::transparentKey(1, 1, 2, 10.0f));
+    CHECK(RenderQueue::opaqueKey(4095, 4095, 16383, 1e30f) < RenderQueue::transparentKey(0, 0, 0, 1e30f));
+
+    CHECK(RenderQueue::passOf(RenderQueue::opaqueKey(7, 8, 9, 1.0f)) == RenderQueue::PASS_OPAQUE);
+    CHECK(RenderQueue::passOf(RenderQueue::transparentKey(7, 8, 9, 1.0f)) == RenderQueue::PASS_TRANSPARENT);
+}
+
+// build() + sort() on DrawItems: opaque front to back within a state,
+// transparent back to front after all opaque draws
+void test_draw_order(JobSystem* jobs) {
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<float> depth(1.0f, 500.0f);
+    std::vector<DrawItem> draws(20000);
+    for (DrawItem& draw : draws) {
+        draw.shaderId = 1 + rng() % 2;
+        draw.textureId = 1 + rng() % 3;
+        draw.meshId = 1 + rng() % 4;
+        draw.transparent = rng() % 5 == 0;
+        // Identity view: the camera looks down -z. Whole depths, so the 24
+        // depth bits of the key tell every pair apart
+        draw.model = alg::Mat4::create_translation(alg::Vec3(0.0f, 0.0f, -float(int(depth(rng)))));
+    }
+
+    RenderQueue queue;
+    queue.build(draws, alg::Mat4(), jobs);
+    queue.sort(jobs);
+    const std::vector<RenderPacket>& packets = queue.getPackets();
+    CHECK(packets.size() == draws.size());
+
+    const auto depthOf = [&](const RenderPacket& packet) { return -draws[packet.draw].model.m[14]; };
+    const auto sameState = [&](const RenderPacket& a, const RenderPacket& b) {
+        const DrawItem& x = draws[a.draw];
+        const DrawItem& y = draws[b.draw];
+        return x.shaderId == y.shaderId && x.textureId == y.textureId && x.meshId == y.meshId;
+    };
+
+    std::size_t backwards = 0;
+    std::size_t passBreaks = 0;
+    std::size_t opaqueRuns = packets.empty() || draws[packets[0].draw].transparent ? 0 : 1;
+    for (std::size_t i = 1; i < packets.size(); ++i) {
+        const RenderPacket& previous = packets[i - 1];
+        const RenderPacket& current = packets[i];
+        const bool previousTransparent = draws[previous.draw].transparent;
+        const bool currentTransparent = draws[current.draw].transparent;
+        passBreaks += previousTransparent && !currentTransparent;
+        if (!currentTransparent && (previousTransparent || !sameState(previous, current))) {
+            ++opaqueRuns;
+        }
+        if (!previousTransparent && !currentTransparent && sameState(previous, current)) {
+            backwards += depthOf(previous) > depthOf(current);
+        }
+        if (previousTransparent && currentTransparent) {
+            backwards += depthOf(previous) < depthOf(current);
+        }
+    }
+    CHECK(passBreaks == 0);
+    CHECK(backwards == 0);
+    // Each opaque state is one contiguous run (2 shaders * 3 textures * 4 meshes)
+    CHECK(opaqueRuns == 24);
+}
+
+} // namespace
+
+int main() {
+    test_keys();
+    test_radix_sort(nullptr);
+    test_draw_order(nullptr);
+
+    for (unsigned int workers : {1u, 3u, 7u}) {
+        JobSystem jobs(workers);
+        test_radix_sort(&jobs);
+        test_draw_order(&jobs);
+    }
+
+    if (failures) {
+        std::fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("all checks passed\n");
+    return 0;
+}